@@ -27,14 +27,21 @@ int main(void)
         return 1;
     }
 
+    /*
+     * Rien n'est animé: on dort dans SDL_WaitEvent jusqu'au prochain
+     * événement au lieu de se réveiller toutes les 16 ms pour rien.
+     */
     bool running = true;
     while (running) {
         SDL_Event e;
-        while (SDL_PollEvent(&e)) {
+        if (!SDL_WaitEvent(&e)) {
+            SDL_Log("SDL_WaitEvent a échoué: %s", SDL_GetError());
+            break;
+        }
+        do {
             if (e.type == SDL_EVENT_QUIT)
                 running = false;
-        }
-        SDL_Delay(16);
+        } while (SDL_PollEvent(&e));
     }
 
     SDL_DestroyWindow(window);
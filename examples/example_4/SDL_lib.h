@@ -2,7 +2,6 @@
 # define SDL_LIB_H
 
 #include <SDL3/SDL.h>
-#include <SDL3/SDL_main.h>
 #include <SDL3_image/SDL_image.h>
 
 
@@ -0,0 +1,40 @@
+#include "game_bench.h"
+
+#define BENCH_ANIMATION_STATES 100000
+
+typedef struct Bench_Animation {
+    Game_Animation_Library  library;
+    Game_Animation_State    *states;
+    SDL_FRect   *sources;
+}   Bench_Animation;
+
+static void Bench_Animation_Advance(void *context, size_t iterations) {
+    Bench_Animation *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Animation_Advance(&bench->library, bench->states, bench->sources, BENCH_ANIMATION_STATES, GAME_ANIMATION_FRAME_US);
+    game_bench_sink = (size_t)bench->sources[BENCH_ANIMATION_STATES - 1].x;
+}
+
+void    Game_Bench_Suite_Animation(Game_Bench *this) {
+    Bench_Animation bench;
+    int     clips[3];
+
+    if (Game_Bench_IsSelected(this, "animation/") == false)
+        return ;
+    Game_Animation_Library_Init(&bench.library);
+    clips[0] = Game_Animation_Library_AddGrid(&bench.library, 32, 46, 2, 4, 120000, GAME_ANIMATION_LOOP);
+    clips[1] = Game_Animation_Library_AddGrid(&bench.library, 32, 32, 4, 16, 50000, GAME_ANIMATION_PING_PONG);
+    clips[2] = Game_Animation_Library_AddGrid(&bench.library, 64, 64, 8, 8, 90000, GAME_ANIMATION_ONCE);
+    bench.states = malloc(sizeof(Game_Animation_State) * BENCH_ANIMATION_STATES);
+    bench.sources = malloc(sizeof(SDL_FRect) * BENCH_ANIMATION_STATES);
+    if (bench.states != NULL && bench.sources != NULL && clips[0] >= 0 && clips[1] >= 0 && clips[2] >= 0) {
+        for (size_t index = 0; index < BENCH_ANIMATION_STATES; index++)
+            bench.states[index] = Game_Animation_State_Create(clips[index % 3], (Uint32)(index * 7919) % 1000000);
+        Game_Bench_Run(this, (Game_Bench_Case){"animation/advance_100k", Bench_Animation_Advance, &bench, BENCH_ANIMATION_STATES});
+    }
+    free(bench.states);
+    free(bench.sources);
+    Game_Animation_Library_Destroy(&bench.library);
+}
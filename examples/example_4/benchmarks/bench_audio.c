@@ -0,0 +1,71 @@
+#include "game_bench.h"
+
+#define BENCH_AUDIO_FRAMES 1024
+
+typedef struct Bench_Audio {
+    Game_Audio  audio;
+    float   output[BENCH_AUDIO_FRAMES * GAME_AUDIO_CHANNELS];
+    float   reference[BENCH_AUDIO_FRAMES * GAME_AUDIO_CHANNELS];
+    size_t  tone;
+}   Bench_Audio;
+
+static void Bench_Audio_Mix(void *context, size_t iterations) {
+    Bench_Audio *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Audio_Mix(&bench->audio, bench->output, BENCH_AUDIO_FRAMES);
+    game_bench_sink = (size_t)(bench->output[0] * 1000.f);
+}
+
+/* `voices` looping copies of the tone spread across the stereo field; voice cost is what is measured. */
+static void Bench_Audio_Start(Bench_Audio *bench, size_t voices, float pitch) {
+    Game_Audio_StopAll(&bench->audio);
+    for (size_t voice = 0; voice < voices; voice++)
+        Game_Audio_Play(&bench->audio, bench->tone, 1.f / (float)voices, (float)voice / (float)voices * 2.f - 1.f, pitch, true);
+    Game_Audio_Mix(&bench->audio, bench->output, 1);
+}
+
+/* Mixes the same block again with each kernel from the same voice positions and compares it with scalar. */
+static void Bench_Audio_Run(Game_Bench *this, Bench_Audio *bench, size_t voices, float pitch, const char *label) {
+    Game_Audio_Voice    voices_saved[GAME_AUDIO_VOICES];
+    Game_Kernel best;
+    char    name[64];
+    float   error;
+
+    best = Game_Kernel_GetBest(game_audio_kernels);
+    for (bench->audio.kernel = GAME_KERNEL_SCALAR; bench->audio.kernel <= best; bench->audio.kernel++) {
+        Bench_Audio_Start(bench, voices, pitch);
+        SDL_memcpy(voices_saved, bench->audio.voices, sizeof(voices_saved));
+        Game_Audio_Mix(&bench->audio, bench->output, BENCH_AUDIO_FRAMES);
+        if (bench->audio.kernel == GAME_KERNEL_SCALAR)
+            SDL_memcpy(bench->reference, bench->output, sizeof(bench->output));
+        error = 0.f;
+        for (size_t index = 0; index < SDL_arraysize(bench->output); index++)
+            error = SDL_max(error, SDL_fabsf(bench->output[index] - bench->reference[index]));
+        if (Game_Bench_Check(this, error <= 1e-5f) == false)
+            SDL_Log("bench: audio/%s: the %s kernel is off by %g", label,
+                Game_Kernel_GetName(game_audio_kernels, bench->audio.kernel), (double)error);
+        SDL_memcpy(bench->audio.voices, voices_saved, sizeof(voices_saved));
+        SDL_snprintf(name, sizeof(name), "audio/%s/%s", label, Game_Kernel_GetName(game_audio_kernels, bench->audio.kernel));
+        Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Audio_Mix, bench, voices * BENCH_AUDIO_FRAMES});
+    }
+    bench->audio.kernel = best;
+}
+
+void    Game_Bench_Suite_Audio(Game_Bench *this) {
+    Bench_Audio *bench;
+
+    if (Game_Bench_IsSelected(this, "audio/") == false)
+        return ;
+    if ((bench = calloc(1, sizeof(Bench_Audio))) == NULL)
+        return ;
+    if (Game_Audio_Init(&bench->audio) && (bench->tone = Game_Audio_CreateTone(&bench->audio, 440.f, 2.f)) != GAME_AUDIO_NO_SOUND) {
+        Bench_Audio_Run(this, bench, 1, 1.f, "mix_1_voice");
+        Bench_Audio_Run(this, bench, 16, 1.f, "mix_16_voices");
+        Bench_Audio_Run(this, bench, GAME_AUDIO_VOICES, 1.f, "mix_64_voices");
+        Bench_Audio_Run(this, bench, GAME_AUDIO_VOICES, 1.1f, "mix_64_voices_resampled");
+    }
+    Game_Audio_Destroy(&bench->audio);
+    free(bench);
+}
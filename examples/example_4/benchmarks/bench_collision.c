@@ -0,0 +1,129 @@
+#include "game_bench.h"
+
+#define BENCH_COLLISION_PAIRS 4096
+
+typedef struct Bench_Collision {
+    Game_Collision_Mask player;
+    Game_Collision_Mask boo;
+    SDL_Surface *surface;
+    Game_Kernel kernel;
+    Game_Collision_Shape    *shapes;
+    bool    *expected;
+    size_t  pairs;
+}   Bench_Collision;
+
+/* Opaque inside the ellipse inscribed in the surface, transparent outside: sprite-like silhouettes with curved edges. */
+static SDL_Surface  *Bench_Collision_CreateBlob(int width, int height) {
+    SDL_Surface *surface;
+    Uint32  *row;
+    float   dx;
+    float   dy;
+
+    if ((surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888)) == NULL)
+        return (NULL);
+    for (int y = 0; y < height; y++) {
+        row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * (size_t)surface->pitch);
+        for (int x = 0; x < width; x++) {
+            dx = (x + 0.5f - width / 2.f) / (width / 2.f);
+            dy = (y + 0.5f - height / 2.f) / (height / 2.f);
+            row[x] = dx * dx + dy * dy <= 1.f ? 0xFFC0C0C0u : 0;
+        }
+    }
+    return (surface);
+}
+
+static void Bench_Collision_Test(void *context, size_t iterations) {
+    Bench_Collision *bench;
+    size_t  hits;
+
+    bench = context;
+    hits = 0;
+    for (size_t index = 0; index < iterations; index++)
+        for (size_t pair = 0; pair < bench->pairs; pair++)
+            hits += Game_Collision_TestWith(&bench->shapes[pair * 2], &bench->shapes[pair * 2 + 1], bench->kernel);
+    game_bench_sink = hits;
+}
+
+static void Bench_Collision_Build(void *context, size_t iterations) {
+    Bench_Collision *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Collision_Mask_Build(&bench->player, bench->surface);
+    game_bench_sink = (size_t)bench->player.words[0];
+}
+
+/*
+** `spread` 1 keeps every pair's boxes overlapping, so each one reaches the
+** mask test; larger spreads leave most pairs to the box test. With
+** `misses_only`, pairs the scalar kernel finds touching are dropped: the
+** rest have to scan their whole overlap before answering.
+*/
+static void Bench_Collision_Place(Bench_Collision *bench, int spread, bool misses_only) {
+    Uint32  state;
+    int     x;
+    int     y;
+
+    state = 0x9E3779B9u;
+    bench->pairs = 0;
+    while (bench->pairs < BENCH_COLLISION_PAIRS) {
+        state = state * 1664525u + 1013904223u;
+        x = (int)((state >> 8) % (Uint32)(127 * spread)) - 63 * spread;
+        state = state * 1664525u + 1013904223u;
+        y = (int)((state >> 8) % (Uint32)(155 * spread)) - 63 * spread;
+        bench->shapes[bench->pairs * 2] = Game_Collision_Shape_Make(&bench->player, NULL, 0.f, 0.f);
+        bench->shapes[bench->pairs * 2 + 1] = Game_Collision_Shape_Make(&bench->boo, NULL, (float)x, (float)y);
+        bench->expected[bench->pairs] = Game_Collision_TestWith(&bench->shapes[bench->pairs * 2],
+            &bench->shapes[bench->pairs * 2 + 1], GAME_KERNEL_SCALAR);
+        if (misses_only == false || bench->expected[bench->pairs] == false)
+            bench->pairs++;
+    }
+}
+
+/* Every kernel must agree with the scalar one on every pair. */
+static void Bench_Collision_Run(Game_Bench *this, Bench_Collision *bench, const char *label) {
+    Game_Kernel best;
+    char    name[64];
+
+    best = Game_Kernel_GetBest(game_collision_kernels);
+    for (bench->kernel = GAME_KERNEL_SCALAR; bench->kernel <= best; bench->kernel++) {
+        for (size_t pair = 0; pair < bench->pairs; pair++)
+            if (Game_Bench_Check(this, Game_Collision_TestWith(&bench->shapes[pair * 2], &bench->shapes[pair * 2 + 1],
+                bench->kernel) == bench->expected[pair]) == false) {
+                SDL_Log("bench: collision/%s: the %s kernel disagrees with the scalar one", label,
+                    Game_Kernel_GetName(game_collision_kernels, bench->kernel));
+                break ;
+            }
+        SDL_snprintf(name, sizeof(name), "collision/%s/%s", label, Game_Kernel_GetName(game_collision_kernels, bench->kernel));
+        Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Collision_Test, bench, bench->pairs});
+    }
+}
+
+void    Game_Bench_Suite_Collision(Game_Bench *this) {
+    Bench_Collision bench;
+    SDL_Surface *boo;
+
+    if (Game_Bench_IsSelected(this, "collision/") == false)
+        return ;
+    SDL_zero(bench);
+    bench.surface = Bench_Collision_CreateBlob(64, 92);
+    boo = Bench_Collision_CreateBlob(64, 64);
+    bench.shapes = calloc(BENCH_COLLISION_PAIRS * 2, sizeof(Game_Collision_Shape));
+    bench.expected = calloc(BENCH_COLLISION_PAIRS, sizeof(bool));
+    if (bench.surface != NULL && boo != NULL && bench.shapes != NULL && bench.expected != NULL
+        && Game_Collision_Mask_Build(&bench.player, bench.surface) && Game_Collision_Mask_Build(&bench.boo, boo)) {
+        Bench_Collision_Place(&bench, 1, false);
+        Bench_Collision_Run(this, &bench, "overlapping_4k");
+        Bench_Collision_Place(&bench, 1, true);
+        Bench_Collision_Run(this, &bench, "near_misses_4k");
+        Bench_Collision_Place(&bench, 8, false);
+        Bench_Collision_Run(this, &bench, "scattered_4k");
+        Game_Bench_Run(this, (Game_Bench_Case){"collision/build_64x92", Bench_Collision_Build, &bench, 64 * 92});
+    }
+    Game_Collision_Mask_Destroy(&bench.boo);
+    Game_Collision_Mask_Destroy(&bench.player);
+    free(bench.expected);
+    free(bench.shapes);
+    SDL_DestroySurface(boo);
+    SDL_DestroySurface(bench.surface);
+}
@@ -0,0 +1,245 @@
+#include "game_bench.h"
+
+#define BENCH_CORE_PLAYERS 10000
+#define BENCH_CORE_DRAWS 1000
+#define BENCH_CORE_COMMANDS 100000
+
+/*
+** Baseline: commands as they were before GAME_COMMAND_LIST, one object per
+** command holding its target and an execute pointer reached through a cast.
+*/
+typedef struct Bench_Core_Command_Object {
+    void    (*execute)(struct Bench_Core_Command_Object *this);
+    Game_Player *player;
+}   Bench_Core_Command_Object;
+
+typedef struct Bench_Core_Commands {
+    Game_Player player;
+    Bench_Core_Command_Object   objects[4];
+    Game_Player *entities;
+    Bench_Core_Command_Object   *queue_objects;
+    Game_Command    *queue;
+}   Bench_Core_Commands;
+
+typedef struct Bench_Core_Players {
+    Game_Player *content;
+    size_t  length;
+}   Bench_Core_Players;
+
+typedef struct Bench_Core_Load {
+    Game_Window *window;
+    const char  *path;
+}   Bench_Core_Load;
+
+typedef struct Bench_Core_Render {
+    Game_Window *window;
+    Game_Texture    texture;
+}   Bench_Core_Render;
+
+static void Bench_Core_TimerTicks(void *context, size_t iterations) {
+    Game_Timer  *timer;
+    size_t  total;
+
+    timer = context;
+    total = 0;
+    for (size_t index = 0; index < iterations; index++)
+        total += Game_Timer_GetTicksNS(timer);
+    game_bench_sink = total;
+}
+
+static void Bench_Core_ObjectMoveUp(Bench_Core_Command_Object *this) {
+    Game_Player_SlideUp(this->player);
+    Game_Player_MoveLeft(this->player);
+}
+
+static void Bench_Core_ObjectMoveDown(Bench_Core_Command_Object *this) {
+    Game_Player_SlideDown(this->player);
+    Game_Player_MoveRight(this->player);
+}
+
+static void Bench_Core_ObjectMoveLeft(Bench_Core_Command_Object *this) {
+    Game_Player_MoveLeft(this->player);
+    Game_Player_SlideDown(this->player);
+}
+
+static void Bench_Core_ObjectMoveRight(Bench_Core_Command_Object *this) {
+    Game_Player_MoveRight(this->player);
+    Game_Player_SlideUp(this->player);
+}
+
+static void (*const bench_core_object_moves[GAME_COMMAND_TYPE_COUNT])(Bench_Core_Command_Object *) = {
+    Bench_Core_ObjectMoveUp, Bench_Core_ObjectMoveDown, Bench_Core_ObjectMoveLeft, Bench_Core_ObjectMoveRight,
+};
+
+static void Bench_Core_CommandDispatch(void *context, size_t iterations) {
+    Bench_Core_Commands *bench;
+    Bench_Core_Command_Object   *command;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        command = &bench->objects[index & 3];
+        command->execute(command);
+    }
+    game_bench_sink = (size_t)bench->player.coordinates.x;
+}
+
+static void Bench_Core_CommandSwitch(void *context, size_t iterations) {
+    Bench_Core_Commands *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Command_Execute((Game_Command_Type)(index & 3), &bench->player);
+    game_bench_sink = (size_t)bench->player.coordinates.x;
+}
+
+static void Bench_Core_CommandQueueIndirect(void *context, size_t iterations) {
+    Bench_Core_Commands *bench;
+    Bench_Core_Command_Object   *command;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        for (size_t queued = 0; queued < BENCH_CORE_COMMANDS; queued++) {
+            command = &bench->queue_objects[queued];
+            command->execute(command);
+        }
+    }
+    game_bench_sink = (size_t)bench->entities[0].coordinates.x;
+}
+
+static void Bench_Core_CommandQueueSwitch(void *context, size_t iterations) {
+    Bench_Core_Commands *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Command_ExecuteBatch(bench->queue, BENCH_CORE_COMMANDS, bench->entities);
+    game_bench_sink = (size_t)bench->entities[0].coordinates.x;
+}
+
+static void Bench_Core_CommandBulk(void *context, size_t iterations) {
+    Bench_Core_Commands *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Command_ExecuteBulk((Game_Command_Type)(index & 3), bench->entities, BENCH_CORE_PLAYERS);
+    game_bench_sink = (size_t)bench->entities[0].coordinates.x;
+}
+
+/* The same random queue twice: as tagged records and as command objects. */
+static bool Bench_Core_CommandSetup(Bench_Core_Commands *bench) {
+    Uint32  state;
+
+    Game_Player_Init(&bench->player);
+    for (size_t type = 0; type < GAME_COMMAND_TYPE_COUNT; type++)
+        bench->objects[type] = (Bench_Core_Command_Object){bench_core_object_moves[type], &bench->player};
+    bench->entities = malloc(sizeof(Game_Player) * BENCH_CORE_PLAYERS);
+    bench->queue_objects = malloc(sizeof(Bench_Core_Command_Object) * BENCH_CORE_COMMANDS);
+    bench->queue = malloc(sizeof(Game_Command) * BENCH_CORE_COMMANDS);
+    if (bench->entities == NULL || bench->queue_objects == NULL || bench->queue == NULL)
+        return (false);
+    for (size_t index = 0; index < BENCH_CORE_PLAYERS; index++)
+        Game_Player_Init(&bench->entities[index]);
+    state = 0x6A09E667u;
+    for (size_t index = 0; index < BENCH_CORE_COMMANDS; index++) {
+        state = state * 1664525u + 1013904223u;
+        bench->queue[index] = (Game_Command){(state >> 8) % BENCH_CORE_PLAYERS, state >> 30};
+        bench->queue_objects[index] = (Bench_Core_Command_Object){bench_core_object_moves[state >> 30],
+            &bench->entities[bench->queue[index].entity]};
+    }
+    return (true);
+}
+
+static void Bench_Core_PlayerMove(void *context, size_t iterations) {
+    Bench_Core_Players  *players;
+
+    players = context;
+    for (size_t index = 0; index < iterations; index++) {
+        for (size_t player = 0; player < players->length; player++) {
+            Game_Player_MoveRight(&players->content[player]);
+            Game_Player_SlideUp(&players->content[player]);
+        }
+    }
+    game_bench_sink = (size_t)players->content[0].coordinates.x;
+}
+
+static void Bench_Core_TextureLoad(void *context, size_t iterations) {
+    Bench_Core_Load *load;
+    Game_Texture    texture;
+
+    load = context;
+    for (size_t index = 0; index < iterations; index++) {
+        Game_Texture_Init(&texture);
+        if (Game_Texture_LoadFromFile(&texture, load->window, load->path) == true)
+            game_bench_sink += texture.size.width;
+        Game_Texture_Destroy(&texture);
+    }
+}
+
+static void Bench_Core_TextureRender(void *context, size_t iterations) {
+    Bench_Core_Render   *render;
+    Coordinates coordinates;
+
+    render = context;
+    for (size_t index = 0; index < iterations; index++) {
+        for (size_t draw = 0; draw < BENCH_CORE_DRAWS; draw++) {
+            coordinates.x = (float)((draw * 37) % (WINDOW_WIDTH - render->texture.size.width));
+            coordinates.y = (float)((draw * 53) % (WINDOW_HEIGHT - render->texture.size.height));
+            Game_Texture_Render(&render->texture, coordinates, render->window);
+        }
+        SDL_FlushRenderer(render->window->renderer);
+    }
+}
+
+static void Bench_Core_Texture(Game_Bench *this, const char *name, const char *path) {
+    Bench_Core_Load load;
+    Bench_Core_Render   render;
+    char    case_name[64];
+
+    load = (Bench_Core_Load){&this->window, path};
+    SDL_snprintf(case_name, sizeof(case_name), "texture/load_from_file/%s", name);
+    Game_Bench_Run(this, (Game_Bench_Case){case_name, Bench_Core_TextureLoad, &load, 1});
+    render.window = &this->window;
+    Game_Texture_Init(&render.texture);
+    SDL_snprintf(case_name, sizeof(case_name), "texture/render/%s", name);
+    if (Game_Bench_IsSelected(this, case_name) == false)
+        return ;
+    if (Game_Texture_LoadFromFile(&render.texture, &this->window, path) == false) {
+        SDL_Log("bench: cannot load %s: %s", path, SDL_GetError());
+        return ;
+    }
+    Game_Bench_Run(this, (Game_Bench_Case){case_name, Bench_Core_TextureRender, &render, BENCH_CORE_DRAWS});
+    Game_Texture_Destroy(&render.texture);
+}
+
+void    Game_Bench_Suite_Core(Game_Bench *this) {
+    Game_Timer  timer;
+    Bench_Core_Commands commands;
+    Bench_Core_Players  players;
+
+    Game_Timer_Init(&timer);
+    Game_Timer_Start(&timer);
+    Game_Bench_Run(this, (Game_Bench_Case){"timer/get_ticks_ns", Bench_Core_TimerTicks, &timer, 1});
+
+    if (Bench_Core_CommandSetup(&commands)) {
+        Game_Bench_Run(this, (Game_Bench_Case){"command/dispatch_indirect", Bench_Core_CommandDispatch, &commands, 1});
+        Game_Bench_Run(this, (Game_Bench_Case){"command/dispatch_switch", Bench_Core_CommandSwitch, &commands, 1});
+        Game_Bench_Run(this, (Game_Bench_Case){"command/queue_100k/indirect", Bench_Core_CommandQueueIndirect,
+            &commands, BENCH_CORE_COMMANDS});
+        Game_Bench_Run(this, (Game_Bench_Case){"command/queue_100k/switch", Bench_Core_CommandQueueSwitch,
+            &commands, BENCH_CORE_COMMANDS});
+        Game_Bench_Run(this, (Game_Bench_Case){"command/bulk_10k", Bench_Core_CommandBulk, &commands, BENCH_CORE_PLAYERS});
+    }
+    free(commands.entities);
+    free(commands.queue_objects);
+    free(commands.queue);
+
+    players.length = BENCH_CORE_PLAYERS;
+    if ((players.content = malloc(sizeof(Game_Player) * players.length)) != NULL) {
+        for (size_t index = 0; index < players.length; index++)
+            Game_Player_Init(&players.content[index]);
+        Game_Bench_Run(this, (Game_Bench_Case){"player/move_bulk_10k", Bench_Core_PlayerMove, &players, players.length});
+        free(players.content);
+    }
+
+    Bench_Core_Texture(this, "player", PATH_SPRITE_PLAYER);
+    Bench_Core_Texture(this, "boo", PATH_SPRITE_BOO);
+}
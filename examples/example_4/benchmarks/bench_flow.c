@@ -0,0 +1,114 @@
+#include "game_bench.h"
+
+#define BENCH_FLOW_AGENTS 10000
+#define BENCH_FLOW_MAZE 512
+#define BENCH_FLOW_MAZE_TILE 4.f
+
+typedef struct Bench_Flow {
+    Game_Flow_Field window;
+    Game_Flow_Field maze;
+    Game_Flow_Field *field;
+    Game_Jobs   *jobs;
+    size_t  goals[2];
+    Coordinates positions[BENCH_FLOW_AGENTS];
+    Coordinates velocities[BENCH_FLOW_AGENTS];
+}   Bench_Flow;
+
+/* Alternates between two far-apart goals so every iteration is a full rebuild. */
+static void Bench_Flow_Rebuild(void *context, size_t iterations) {
+    Bench_Flow  *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Flow_Field_Build(bench->field, bench->goals[index % 2], bench->jobs);
+    game_bench_sink = bench->field->rebuilds;
+}
+
+/* What Game_ChasePlayer does per boo: one lookup and a velocity write. */
+static void Bench_Flow_Steer(void *context, size_t iterations) {
+    Bench_Flow  *bench;
+    Game_Flow_Direction direction;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        for (size_t agent = 0; agent < BENCH_FLOW_AGENTS; agent++) {
+            direction = Game_Flow_Field_Sample(bench->field, bench->positions[agent].x, bench->positions[agent].y);
+            bench->velocities[agent] = (Coordinates){game_flow_vectors[direction][0] * GAME_CHASE_SPEED,
+                game_flow_vectors[direction][1] * GAME_CHASE_SPEED};
+        }
+    game_bench_sink = (size_t)(bench->velocities[0].x + bench->velocities[BENCH_FLOW_AGENTS - 1].y);
+}
+
+/*
+** Serpentine maze: a wall every 8 columns with a 2-cell gap at alternating
+** ends, so the shortest paths wind through every corridor.
+*/
+static void Bench_Flow_BuildMaze(Game_Flow_Field *maze) {
+    for (size_t x = 8; x < maze->width; x += 8)
+        for (size_t y = 0; y < maze->height; y++)
+            if ((x / 8) % 2 ? y < maze->height - 2 : y >= 2)
+                Game_Flow_Field_SetBlocked(maze, x, y, true);
+}
+
+static void Bench_Flow_Scatter(Bench_Flow *bench, float world_width, float world_height) {
+    Uint32  state;
+
+    state = 0x2545F491u;
+    for (size_t agent = 0; agent < BENCH_FLOW_AGENTS; agent++) {
+        state = state * 1664525u + 1013904223u;
+        bench->positions[agent].x = (float)((state >> 8) % (Uint32)world_width);
+        state = state * 1664525u + 1013904223u;
+        bench->positions[agent].y = (float)((state >> 8) % (Uint32)world_height);
+    }
+}
+
+static void Bench_Flow_Run(Game_Bench *this, Bench_Flow *bench, Game_Jobs *serial, Game_Jobs *parallel, const char *label) {
+    char    name[64];
+    size_t  cells;
+    float   world_width;
+    float   world_height;
+
+    cells = bench->field->width * bench->field->height;
+    world_width = (float)bench->field->width * bench->field->tile;
+    world_height = (float)bench->field->height * bench->field->tile;
+    bench->goals[0] = Game_Flow_Field_GetCell(bench->field, 0.f, 0.f);
+    bench->goals[1] = Game_Flow_Field_GetCell(bench->field, world_width, world_height);
+    bench->jobs = serial;
+    SDL_snprintf(name, sizeof(name), "flow/rebuild_%s/serial", label);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Flow_Rebuild, bench, cells});
+    bench->jobs = parallel;
+    SDL_snprintf(name, sizeof(name), "flow/rebuild_%s/parallel", label);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Flow_Rebuild, bench, cells});
+    Bench_Flow_Scatter(bench, world_width, world_height);
+    Game_Flow_Field_Build(bench->field, Game_Flow_Field_GetCell(bench->field, world_width / 2.f, world_height / 2.f), parallel);
+    SDL_snprintf(name, sizeof(name), "flow/steer_10k_%s", label);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Flow_Steer, bench, BENCH_FLOW_AGENTS});
+}
+
+void    Game_Bench_Suite_Flow(Game_Bench *this) {
+    Bench_Flow  *bench;
+    Game_Jobs   serial;
+    Game_Jobs   parallel;
+
+    if (Game_Bench_IsSelected(this, "flow/") == false)
+        return ;
+    if ((bench = calloc(1, sizeof(Bench_Flow))) == NULL)
+        return ;
+    Game_Jobs_Init(&serial, 0);
+    Game_Jobs_Init(&parallel, (size_t)SDL_max(SDL_GetNumLogicalCPUCores() - 1, 0));
+    if (Game_Flow_Field_Init(&bench->window, (size_t)SDL_ceilf(WINDOW_WIDTH / GAME_FLOW_TILE),
+        (size_t)SDL_ceilf(WINDOW_HEIGHT / GAME_FLOW_TILE), GAME_FLOW_TILE)) {
+        bench->field = &bench->window;
+        Bench_Flow_Run(this, bench, &serial, &parallel, "window");
+    }
+    if (Game_Flow_Field_Init(&bench->maze, BENCH_FLOW_MAZE, BENCH_FLOW_MAZE, BENCH_FLOW_MAZE_TILE)) {
+        Bench_Flow_BuildMaze(&bench->maze);
+        bench->field = &bench->maze;
+        Bench_Flow_Run(this, bench, &serial, &parallel, "maze_512");
+    }
+    Game_Flow_Field_Destroy(&bench->maze);
+    Game_Flow_Field_Destroy(&bench->window);
+    Game_Jobs_Destroy(&parallel);
+    Game_Jobs_Destroy(&serial);
+    free(bench);
+}
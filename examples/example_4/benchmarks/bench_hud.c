@@ -0,0 +1,44 @@
+#include "game_bench.h"
+
+typedef struct Bench_Hud {
+    Game_Hud    hud;
+    SDL_Renderer    *renderer;
+    Game_Hud_Counters   counters;
+    bool    refresh;
+}   Bench_Hud;
+
+/* One overlay frame with a full graph; `refresh` also rebuilds the text every time instead of every 250 ms. */
+static void Bench_Hud_Render(void *context, size_t iterations) {
+    Bench_Hud   *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        if (bench->refresh)
+            bench->hud.refresh_ns = 0;
+        Game_Hud_Render(&bench->hud, bench->renderer, &bench->counters);
+    }
+    SDL_FlushRenderer(bench->renderer);
+    game_bench_sink = bench->hud.quads;
+}
+
+void    Game_Bench_Suite_Hud(Game_Bench *this) {
+    Bench_Hud   bench;
+
+    if (Game_Bench_IsSelected(this, "hud/") == false)
+        return ;
+    bench.renderer = this->window.renderer;
+    bench.counters = (Game_Hud_Counters){3, 100000, 20000, 512 * 1024 * 1024, 640 * 1024 * 1024};
+    Game_Hud_Init(&bench.hud);
+    for (size_t index = 0; index < GAME_HUD_HISTORY; index++)
+        bench.hud.history[index] = 12000000 + index * 200000;
+    bench.hud.history_length = GAME_HUD_HISTORY;
+    bench.refresh = false;
+    if (Game_Hud_Render(&bench.hud, bench.renderer, &bench.counters) == false) {
+        Game_Hud_Destroy(&bench.hud);
+        return ;
+    }
+    Game_Bench_Run(this, (Game_Bench_Case){"hud/render", Bench_Hud_Render, &bench, bench.hud.quads});
+    bench.refresh = true;
+    Game_Bench_Run(this, (Game_Bench_Case){"hud/render_refresh", Bench_Hud_Render, &bench, bench.hud.quads});
+    Game_Hud_Destroy(&bench.hud);
+}
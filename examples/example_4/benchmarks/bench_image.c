@@ -0,0 +1,167 @@
+#include "game_bench.h"
+
+#define BENCH_IMAGE_SIDE 2048
+#define BENCH_IMAGE_V5_HEADER 124
+
+typedef struct Bench_Image {
+    const char  *label;
+    Uint8   *data;
+    size_t  size;
+    Game_Kernel kernel;
+}   Bench_Image;
+
+static void Bench_Image_Write32(Uint8 *bytes, Uint32 value) {
+    value = SDL_Swap32LE(value);
+    SDL_memcpy(bytes, &value, sizeof(value));
+}
+
+/*
+** A bottom-up BMP in memory: 32-bit BGRA with a V5 header and bitfields, as
+** image editors export sprites with alpha, or 24-bit BGR with a plain header
+** and some color-key pixels.
+*/
+static Uint8    *Bench_Image_Build(size_t side, Uint16 bits, size_t *size) {
+    Uint8   *bytes;
+    Uint8   *pixel;
+    size_t  header;
+    size_t  stride;
+    Uint32  random;
+
+    header = bits == 32 ? BENCH_IMAGE_V5_HEADER : 40;
+    stride = ((side * bits + 31) / 32) * 4;
+    *size = 14 + header + stride * side;
+    if ((bytes = SDL_calloc(1, *size)) == NULL)
+        return (NULL);
+    bytes[0] = 'B';
+    bytes[1] = 'M';
+    Bench_Image_Write32(bytes + 2, (Uint32)*size);
+    Bench_Image_Write32(bytes + 10, (Uint32)(14 + header));
+    Bench_Image_Write32(bytes + 14, (Uint32)header);
+    Bench_Image_Write32(bytes + 18, (Uint32)side);
+    Bench_Image_Write32(bytes + 22, (Uint32)side);
+    Bench_Image_Write32(bytes + 26, 1u | (Uint32)bits << 16);
+    Bench_Image_Write32(bytes + 30, bits == 32 ? 3 : 0);
+    if (bits == 32) {
+        Bench_Image_Write32(bytes + 54, 0x00FF0000u);
+        Bench_Image_Write32(bytes + 58, 0x0000FF00u);
+        Bench_Image_Write32(bytes + 62, 0x000000FFu);
+        Bench_Image_Write32(bytes + 66, 0xFF000000u);
+    }
+    random = 0x2545F491u;
+    for (size_t y = 0; y < side; y++)
+        for (size_t x = 0; x < side; x++) {
+            random = random * 1664525u + 1013904223u;
+            pixel = bytes + 14 + header + y * stride + x * (bits / 8);
+            pixel[0] = (Uint8)(random >> 8);
+            pixel[1] = (Uint8)(random >> 16);
+            pixel[2] = (Uint8)(random >> 24);
+            if (bits == 32)
+                pixel[3] = (Uint8)(x * 255 / side);
+            else if ((random & 0xF) == 0)
+                SDL_memcpy(pixel, "\xFF\x00\xFF", 3);
+        }
+    return (bytes);
+}
+
+static void Bench_Image_ImgLoad(void *context, size_t iterations) {
+    Bench_Image *bench;
+    SDL_Surface *surface;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        surface = IMG_Load_IO(SDL_IOFromConstMem(bench->data, bench->size), true);
+        game_bench_sink = surface != NULL ? (size_t)surface->w : 0;
+        SDL_DestroySurface(surface);
+    }
+}
+
+/* What the renderer did with IMG_Load's surface before: one more pass into ARGB8888. */
+static void Bench_Image_ImgLoadConvert(void *context, size_t iterations) {
+    Bench_Image *bench;
+    SDL_Surface *surface;
+    SDL_Surface *converted;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        surface = IMG_Load_IO(SDL_IOFromConstMem(bench->data, bench->size), true);
+        converted = surface != NULL ? SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888) : NULL;
+        game_bench_sink = converted != NULL ? (size_t)converted->w : 0;
+        SDL_DestroySurface(converted);
+        SDL_DestroySurface(surface);
+    }
+}
+
+static void Bench_Image_Decode(void *context, size_t iterations) {
+    Bench_Image *bench;
+    SDL_Surface *surface;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        surface = Game_Bmp_DecodeWith(bench->data, bench->size, GAME_BMP_COLOR_KEY, bench->kernel);
+        game_bench_sink = surface != NULL ? (size_t)surface->w : 0;
+        SDL_DestroySurface(surface);
+    }
+}
+
+/* Every kernel must produce the scalar kernel's pixels. */
+static bool Bench_Image_Check(Bench_Image *bench, SDL_Surface *reference) {
+    SDL_Surface *surface;
+    bool    same;
+
+    if ((surface = Game_Bmp_DecodeWith(bench->data, bench->size, GAME_BMP_COLOR_KEY, bench->kernel)) == NULL)
+        return (false);
+    same = true;
+    for (int y = 0; y < surface->h && same; y++)
+        same = SDL_memcmp((Uint8 *)surface->pixels + y * surface->pitch,
+            (Uint8 *)reference->pixels + y * reference->pitch, (size_t)surface->w * 4) == 0;
+    SDL_DestroySurface(surface);
+    return (same);
+}
+
+static void Bench_Image_Run(Game_Bench *this, Bench_Image *bench) {
+    SDL_Surface *reference;
+    Game_Kernel best;
+    char    name[64];
+    size_t  pixels;
+
+    if (bench->data == NULL)
+        return ;
+    reference = Game_Bmp_DecodeWith(bench->data, bench->size, GAME_BMP_COLOR_KEY, GAME_KERNEL_SCALAR);
+    if (Game_Bench_Check(this, reference != NULL) == false) {
+        SDL_Log("bench: image/%s: %s", bench->label, SDL_GetError());
+        return ;
+    }
+    pixels = (size_t)reference->w * (size_t)reference->h;
+    SDL_snprintf(name, sizeof(name), "image/%s/img_load", bench->label);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Image_ImgLoad, bench, pixels});
+    SDL_snprintf(name, sizeof(name), "image/%s/img_load_convert", bench->label);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Image_ImgLoadConvert, bench, pixels});
+    best = Game_Kernel_GetBest(game_bmp_kernels);
+    for (bench->kernel = GAME_KERNEL_SCALAR; bench->kernel <= best; bench->kernel++) {
+        if (Game_Bench_Check(this, Bench_Image_Check(bench, reference)) == false)
+            SDL_Log("bench: image/%s: the %s kernel differs from the scalar one", bench->label,
+                Game_Kernel_GetName(game_bmp_kernels, bench->kernel));
+        SDL_snprintf(name, sizeof(name), "image/%s/bmp_%s", bench->label, Game_Kernel_GetName(game_bmp_kernels, bench->kernel));
+        Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Image_Decode, bench, pixels});
+    }
+    SDL_DestroySurface(reference);
+}
+
+void    Game_Bench_Suite_Image(Game_Bench *this) {
+    Bench_Image images[4];
+
+    if (Game_Bench_IsSelected(this, "image/") == false)
+        return ;
+    images[0] = (Bench_Image){"player", NULL, 0, GAME_KERNEL_SCALAR};
+    images[1] = (Bench_Image){"boo", NULL, 0, GAME_KERNEL_SCALAR};
+    images[2] = (Bench_Image){"bgra_2048", NULL, 0, GAME_KERNEL_SCALAR};
+    images[3] = (Bench_Image){"bgr_2048", NULL, 0, GAME_KERNEL_SCALAR};
+    images[0].data = SDL_LoadFile(PATH_SPRITE_PLAYER, &images[0].size);
+    images[1].data = SDL_LoadFile(PATH_SPRITE_BOO, &images[1].size);
+    images[2].data = Bench_Image_Build(BENCH_IMAGE_SIDE, 32, &images[2].size);
+    images[3].data = Bench_Image_Build(BENCH_IMAGE_SIDE, 24, &images[3].size);
+    for (size_t index = 0; index < SDL_arraysize(images); index++) {
+        Bench_Image_Run(this, &images[index]);
+        SDL_free(images[index].data);
+    }
+}
@@ -0,0 +1,128 @@
+#include "game_bench.h"
+#include "game_lockstep.h"
+
+#define BENCH_LOCKSTEP_TICKS 600
+#define BENCH_LOCKSTEP_SEED 0x1F2E3D4Cu
+
+typedef struct Bench_Lockstep {
+    Game_Lockstep_Peer  peers[GAME_LOCKSTEP_PLAYERS];
+    Game_Loopback   links[GAME_LOCKSTEP_PLAYERS];
+    Game_Lockstep_State state;
+    Uint32  latency;
+    Uint32  jitter;
+    size_t  sessions;
+    size_t  stalls;
+}   Bench_Lockstep;
+
+/* Held inputs that change every few ticks, so some predictions miss. */
+static Uint32   Bench_Lockstep_Input(size_t player, Uint32 tick) {
+    Uint32  hash;
+
+    hash = (tick / 7 + (Uint32)player * 0x9E3779B9u) * 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    return ((hash >> 7) & (GAME_INPUT_UP | GAME_INPUT_DOWN | GAME_INPUT_LEFT | GAME_INPUT_RIGHT));
+}
+
+static void Bench_Lockstep_Tick(void *context, size_t iterations) {
+    Bench_Lockstep  *bench;
+    Uint32  inputs[GAME_LOCKSTEP_PLAYERS];
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++)
+            inputs[player] = Bench_Lockstep_Input(player, bench->state.tick);
+        Game_Lockstep_Step(&bench->state, inputs);
+    }
+    game_bench_sink = (size_t)bench->state.bodies[0].x;
+}
+
+/*
+** Both peers run BENCH_LOCKSTEP_TICKS ticks over their loopback links, one
+** frame per clock step, until every tick is confirmed on both sides. One
+** more tick applies any pending rollback. That both end on the same state
+** is checked by tests/test_lockstep.c; this only measures the cost.
+*/
+static void Bench_Lockstep_Session(Bench_Lockstep *bench) {
+    Game_Lockstep_Message   message;
+    Game_Lockstep_Peer  *peer;
+    Uint32  now;
+
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+        Game_Lockstep_Peer_Init(&bench->peers[player], player, BENCH_LOCKSTEP_SEED);
+        Game_Loopback_Init(&bench->links[player], bench->latency, bench->jitter, BENCH_LOCKSTEP_SEED + (Uint32)player);
+    }
+    for (now = 0; Game_Lockstep_Peer_GetConfirmedTick(&bench->peers[0]) < BENCH_LOCKSTEP_TICKS
+        || Game_Lockstep_Peer_GetConfirmedTick(&bench->peers[1]) < BENCH_LOCKSTEP_TICKS; now++) {
+        for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+            peer = &bench->peers[player];
+            while (Game_Loopback_Receive(&bench->links[player], now, &message))
+                Game_Lockstep_Peer_Receive(peer, 1 - player, &message);
+            if (peer->state.tick >= BENCH_LOCKSTEP_TICKS)
+                continue ;
+            if (Game_Lockstep_Peer_Advance(peer, Bench_Lockstep_Input(player, peer->state.tick), &message))
+                Game_Loopback_Send(&bench->links[1 - player], &message, now);
+            else
+                bench->stalls++;
+        }
+    }
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++)
+        Game_Lockstep_Peer_Advance(&bench->peers[player], 0, &message);
+    bench->sessions++;
+}
+
+static void Bench_Lockstep_Run(void *context, size_t iterations) {
+    Bench_Lockstep  *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Bench_Lockstep_Session(bench);
+    game_bench_sink = bench->peers[0].rollbacks;
+}
+
+static void Bench_Lockstep_Loopback(Game_Bench *this, Bench_Lockstep *bench, Uint32 latency, Uint32 jitter) {
+    char    name[64];
+    size_t  rollbacks;
+    size_t  resimulated;
+    size_t  depth_peak;
+    Uint64  rollback_ns;
+
+    bench->latency = latency;
+    bench->jitter = jitter;
+    bench->sessions = 0;
+    bench->stalls = 0;
+    SDL_snprintf(name, sizeof(name), "lockstep/loopback_%u+%u/session", latency, jitter);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Lockstep_Run, bench, BENCH_LOCKSTEP_TICKS});
+    if (bench->sessions == 0)
+        return ;
+    bench->stalls = 0;
+    Bench_Lockstep_Session(bench);
+    rollbacks = 0;
+    resimulated = 0;
+    depth_peak = 0;
+    rollback_ns = 0;
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+        rollbacks += bench->peers[player].rollbacks;
+        resimulated += bench->peers[player].resimulated_ticks;
+        depth_peak = SDL_max(depth_peak, bench->peers[player].rollback_depth_peak);
+        rollback_ns += bench->peers[player].rollback_ns;
+    }
+    SDL_snprintf(name, sizeof(name), "lockstep/loopback_%u+%u/rollback", latency, jitter);
+    Game_Bench_Record(this, name, rollbacks, rollbacks ? resimulated / rollbacks : 0, rollback_ns);
+    SDL_Log("bench: %s: %zu rollbacks per session, %.1f ticks deep on average, %zu at most, %zu stalls, %zu hash checks",
+        name, rollbacks, rollbacks ? (double)resimulated / (double)rollbacks : 0., depth_peak, bench->stalls,
+        bench->peers[0].hash_checks + bench->peers[1].hash_checks);
+}
+
+void    Game_Bench_Suite_Lockstep(Game_Bench *this) {
+    Bench_Lockstep  *bench;
+
+    if (Game_Bench_IsSelected(this, "lockstep/") == false)
+        return ;
+    if ((bench = calloc(1, sizeof(Bench_Lockstep))) == NULL)
+        return ;
+    Game_Lockstep_State_Init(&bench->state, BENCH_LOCKSTEP_SEED);
+    Game_Bench_Run(this, (Game_Bench_Case){"lockstep/tick_512", Bench_Lockstep_Tick, bench, GAME_LOCKSTEP_BODIES});
+    Bench_Lockstep_Loopback(this, bench, 2, 1);
+    Bench_Lockstep_Loopback(this, bench, 6, 3);
+    free(bench);
+}
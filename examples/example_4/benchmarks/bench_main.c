@@ -0,0 +1,71 @@
+#include <SDL3/SDL_main.h>
+#include "game_bench.h"
+
+static void Bench_Usage(const char *name) {
+    fprintf(stderr, "usage: %s [--filter <substring>] [--min-time <ms>] [--json <path|->] [--revision <id>]\n", name);
+}
+
+int     main(int argc, char **argv) {
+    static Game_Bench   bench;
+    const char  *json_path;
+    const char  *revision;
+    FILE    *json;
+
+    Game_Bench_Init(&bench);
+    json_path = NULL;
+    revision = SDL_getenv("GAME_BENCH_REVISION");
+    for (int index = 1; index < argc; index++) {
+        if (SDL_strcmp(argv[index], "--filter") == 0 && index + 1 < argc)
+            bench.filter = argv[++index];
+        else if (SDL_strcmp(argv[index], "--min-time") == 0 && index + 1 < argc)
+            bench.min_time_ns = SDL_MS_TO_NS(SDL_atoi(argv[++index]));
+        else if (SDL_strcmp(argv[index], "--json") == 0 && index + 1 < argc)
+            json_path = argv[++index];
+        else if (SDL_strcmp(argv[index], "--revision") == 0 && index + 1 < argc)
+            revision = argv[++index];
+        else {
+            Bench_Usage(argv[0]);
+            return (2);
+        }
+    }
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    if (SDL_Init(SDL_INIT_VIDEO) == false || Game_Window_InitOffscreen(&bench.window, WINDOW_WIDTH, WINDOW_HEIGHT) == false) {
+        SDL_Log("bench: %s", SDL_GetError());
+        return (1);
+    }
+
+    Game_Bench_Suite_Core(&bench);
+    Game_Bench_Suite_Animation(&bench);
+    Game_Bench_Suite_Particle(&bench);
+    Game_Bench_Suite_Render(&bench);
+    Game_Bench_Suite_Snapshot(&bench);
+    Game_Bench_Suite_Lockstep(&bench);
+    Game_Bench_Suite_Image(&bench);
+    Game_Bench_Suite_Audio(&bench);
+    Game_Bench_Suite_Flow(&bench);
+    Game_Bench_Suite_Hud(&bench);
+    Game_Bench_Suite_Collision(&bench);
+    Game_Bench_Suite_Timers(&bench);
+    Game_Bench_Suite_Script(&bench);
+    Game_Bench_Suite_Mip(&bench);
+
+    /* With --json -, stdout carries the JSON alone. */
+    Game_Bench_PrintTable(&bench, json_path != NULL && SDL_strcmp(json_path, "-") == 0 ? stderr : stdout);
+    if (json_path != NULL) {
+        json = SDL_strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (json == NULL) {
+            perror(json_path);
+            return (1);
+        }
+        Game_Bench_PrintJson(&bench, json, revision);
+        if (json != stdout)
+            fclose(json);
+    }
+    Game_Window_Destroy(&bench.window);
+    SDL_Quit();
+    if (bench.failures != 0) {
+        fprintf(stderr, "bench: %zu checks failed\n", bench.failures);
+        return (1);
+    }
+    return (0);
+}
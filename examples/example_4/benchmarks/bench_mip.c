@@ -0,0 +1,81 @@
+#include "game_bench.h"
+
+#define BENCH_MIP_SIDE 1024
+
+typedef struct Bench_Mip {
+    SDL_Surface *surface;
+    Game_Kernel kernel;
+}   Bench_Mip;
+
+/* Premultiplied noise: every channel at most its alpha, as the loaders leave them. */
+static SDL_Surface  *Bench_Mip_CreateNoise(int width, int height) {
+    SDL_Surface *surface;
+    Uint32  *row;
+    Uint32  state;
+    Uint32  alpha;
+
+    if ((surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888)) == NULL)
+        return (NULL);
+    state = 0x9E3779B9u;
+    for (int y = 0; y < height; y++) {
+        row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * (size_t)surface->pitch);
+        for (int x = 0; x < width; x++) {
+            state = state * 1664525u + 1013904223u;
+            alpha = state >> 24;
+            row[x] = alpha << 24 | (state >> 16 & 0xFF) * alpha / 255 << 16 | (state >> 8 & 0xFF) * alpha / 255 << 8
+                | (state & 0xFF) * alpha / 255;
+        }
+    }
+    return (surface);
+}
+
+static void Bench_Mip_Halve(void *context, size_t iterations) {
+    Bench_Mip   *bench;
+    SDL_Surface *half;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        half = Game_Mip_HalveWith(bench->surface, bench->kernel);
+        game_bench_sink = half != NULL ? ((Uint32 *)half->pixels)[0] : 0;
+        SDL_DestroySurface(half);
+    }
+}
+
+/* Same pixels as the scalar kernel, to the bit: the rounding is exact in every kernel. */
+static bool Bench_Mip_Verify(SDL_Surface *surface, Game_Kernel kernel) {
+    SDL_Surface *expected;
+    SDL_Surface *half;
+    bool    same;
+
+    expected = Game_Mip_HalveWith(surface, GAME_KERNEL_SCALAR);
+    half = Game_Mip_HalveWith(surface, kernel);
+    same = expected != NULL && half != NULL;
+    for (int y = 0; same && y < half->h; y++)
+        same = SDL_memcmp((Uint8 *)expected->pixels + (size_t)y * (size_t)expected->pitch,
+            (Uint8 *)half->pixels + (size_t)y * (size_t)half->pitch, sizeof(Uint32) * (size_t)half->w) == 0;
+    SDL_DestroySurface(half);
+    SDL_DestroySurface(expected);
+    return (same);
+}
+
+void    Game_Bench_Suite_Mip(Game_Bench *this) {
+    Bench_Mip   bench;
+    SDL_Surface *odd;
+    Game_Kernel best;
+    char    name[64];
+
+    if (Game_Bench_IsSelected(this, "mip/") == false)
+        return ;
+    best = Game_Kernel_GetBest(game_mip_kernels);
+    bench.surface = Bench_Mip_CreateNoise(BENCH_MIP_SIDE, BENCH_MIP_SIDE);
+    odd = Bench_Mip_CreateNoise(77, 93);
+    if (bench.surface != NULL && odd != NULL)
+        for (bench.kernel = GAME_KERNEL_SCALAR; bench.kernel <= best; bench.kernel++) {
+            if (Game_Bench_Check(this, Bench_Mip_Verify(bench.surface, bench.kernel) && Bench_Mip_Verify(odd, bench.kernel)) == false)
+                SDL_Log("bench: mip: the %s kernel disagrees with the scalar one", Game_Kernel_GetName(game_mip_kernels, bench.kernel));
+            SDL_snprintf(name, sizeof(name), "mip/halve_1024/%s", Game_Kernel_GetName(game_mip_kernels, bench.kernel));
+            Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Mip_Halve, &bench, BENCH_MIP_SIDE * BENCH_MIP_SIDE});
+        }
+    SDL_DestroySurface(odd);
+    SDL_DestroySurface(bench.surface);
+}
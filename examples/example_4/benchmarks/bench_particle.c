@@ -0,0 +1,50 @@
+#include "game_bench.h"
+
+#define BENCH_PARTICLES 200000
+
+typedef struct Bench_Particle {
+    Game_Particle_Pool  pool;
+    SDL_Renderer    *renderer;
+}   Bench_Particle;
+
+/* Steady state: refill what died last step, like the stress fountain does. */
+static void Bench_Particle_Update(void *context, size_t iterations) {
+    Bench_Particle  *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        Game_Particle_Pool_Emit(&bench->pool, WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f,
+            BENCH_PARTICLES - bench->pool.length, &game_particle_sparks);
+        Game_Particle_Pool_Update(&bench->pool, 1.f / DEFAULT_FPS);
+    }
+    game_bench_sink = bench->pool.length;
+}
+
+static void Bench_Particle_Render(void *context, size_t iterations) {
+    Bench_Particle  *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Particle_Pool_Render(&bench->pool, bench->renderer, NULL);
+    SDL_FlushRenderer(bench->renderer);
+    game_bench_sink = (size_t)bench->pool.vertices[0].position.x;
+}
+
+void    Game_Bench_Suite_Particle(Game_Bench *this) {
+    Bench_Particle  bench;
+    Game_Particle_Emitter   cloud;
+
+    if (Game_Bench_IsSelected(this, "particle/") == false)
+        return ;
+    bench.renderer = this->window.renderer;
+    if (Game_Particle_Pool_Init(&bench.pool, BENCH_PARTICLES, GAME_PARTICLE_SIZE, NULL) == false)
+        return ;
+    Game_Bench_Run(this, (Game_Bench_Case){"particle/update_200k", Bench_Particle_Update, &bench, BENCH_PARTICLES});
+    cloud = game_particle_sparks;
+    cloud.speed_max = WINDOW_HEIGHT / 2.f;
+    bench.pool.length = 0;
+    Game_Particle_Pool_Emit(&bench.pool, WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f, BENCH_PARTICLES, &cloud);
+    Game_Particle_Pool_Update(&bench.pool, 0.1f);
+    Game_Bench_Run(this, (Game_Bench_Case){"particle/render_200k", Bench_Particle_Render, &bench, BENCH_PARTICLES});
+    Game_Particle_Pool_Destroy(&bench.pool);
+}
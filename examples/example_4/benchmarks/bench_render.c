@@ -0,0 +1,114 @@
+#include "game_bench.h"
+
+#define BENCH_RENDER_DRAWS 100000
+#define BENCH_RENDER_TEXTURES 4
+
+typedef struct Bench_Render {
+    Game_Window *window;
+    Game_Texture    textures[BENCH_RENDER_TEXTURES];
+    Game_Sprite_Array   sprites;
+    Game_Camera_View    view;
+    Game_Jobs   *jobs;
+    Game_Render_List    list;
+}   Bench_Render;
+
+static void Bench_Render_BuildSort(Bench_Render *bench) {
+    Game_Render_List_Begin(&bench->list, Game_Jobs_GetWorkerCount(bench->jobs));
+    Game_Sprite_Array_Build(&bench->sprites, &bench->list, bench->jobs, &bench->view);
+    Game_Render_List_Sort(&bench->list, bench->jobs);
+}
+
+static void Bench_Render_Sort(void *context, size_t iterations) {
+    Bench_Render    *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Bench_Render_BuildSort(bench);
+    game_bench_sink = bench->list.length;
+}
+
+static void Bench_Render_Frame(void *context, size_t iterations) {
+    Bench_Render    *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        Bench_Render_BuildSort(bench);
+        Game_Render_List_Submit(&bench->list, bench->window->renderer, GAME_LAYER_OVERLAY);
+        SDL_FlushRenderer(bench->window->renderer);
+    }
+    game_bench_sink = bench->list.draw_calls;
+}
+
+/* Baseline: the same sprites drawn one SDL_RenderTexture at a time, unsorted. */
+static void Bench_Render_Unsorted(void *context, size_t iterations) {
+    Bench_Render    *bench;
+    Game_Sprite *sprite;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        for (size_t draw = 0; draw < bench->sprites.length; draw++) {
+            sprite = &bench->sprites.content[draw];
+            Game_Texture_RenderSource(sprite->texture, &bench->sprites.sources[draw], sprite->coordinates, bench->window);
+        }
+        SDL_FlushRenderer(bench->window->renderer);
+    }
+    game_bench_sink = bench->window->draw_calls;
+}
+
+static bool Bench_Render_Setup(Bench_Render *bench) {
+    Game_Sprite sprite;
+    Uint32  state;
+
+    for (size_t index = 0; index < BENCH_RENDER_TEXTURES; index++) {
+        bench->textures[index].content = SDL_CreateTexture(bench->window->renderer, SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_STATIC, 32, 32);
+        if (bench->textures[index].content == NULL)
+            return (false);
+        bench->textures[index].id = (Uint16)(index + 1);
+        Size_Set(&bench->textures[index].size, 32, 32);
+    }
+    if (Game_Sprite_Array_Reserve(&bench->sprites, BENCH_RENDER_DRAWS) == false)
+        return (false);
+    state = 0x2545F491u;
+    for (size_t index = 0; index < BENCH_RENDER_DRAWS; index++) {
+        state = state * 1664525u + 1013904223u;
+        sprite.texture = &bench->textures[(state >> 28) % BENCH_RENDER_TEXTURES];
+        sprite.coordinates = (Coordinates){(float)((state >> 8) % (WINDOW_WIDTH - 32)), (float)((state >> 4) % (WINDOW_HEIGHT - 32))};
+        sprite.velocity = (Coordinates){0, 0};
+        Game_Sprite_Array_Push(&bench->sprites, sprite);
+    }
+    return (true);
+}
+
+void    Game_Bench_Suite_Render(Game_Bench *this) {
+    Bench_Render    bench;
+    Game_Camera camera;
+    Game_Jobs   serial;
+    Game_Jobs   parallel;
+
+    if (Game_Bench_IsSelected(this, "render_list/") == false)
+        return ;
+    bench.window = &this->window;
+    for (size_t index = 0; index < BENCH_RENDER_TEXTURES; index++)
+        Game_Texture_Init(&bench.textures[index]);
+    Game_Sprite_Array_Init(&bench.sprites);
+    Game_Render_List_Init(&bench.list);
+    Game_Camera_Init(&camera, WINDOW_WIDTH, WINDOW_HEIGHT);
+    bench.view = Game_Camera_GetView(&camera, 1.f, 0.f);
+    Game_Jobs_Init(&serial, 0);
+    Game_Jobs_Init(&parallel, (size_t)SDL_max(SDL_GetNumLogicalCPUCores() - 1, 0));
+    if (Bench_Render_Setup(&bench)) {
+        bench.jobs = &serial;
+        Game_Bench_Run(this, (Game_Bench_Case){"render_list/build_sort_100k/serial", Bench_Render_Sort, &bench, BENCH_RENDER_DRAWS});
+        bench.jobs = &parallel;
+        Game_Bench_Run(this, (Game_Bench_Case){"render_list/build_sort_100k/parallel", Bench_Render_Sort, &bench, BENCH_RENDER_DRAWS});
+        Game_Bench_Run(this, (Game_Bench_Case){"render_list/frame_100k", Bench_Render_Frame, &bench, BENCH_RENDER_DRAWS});
+        Game_Bench_Run(this, (Game_Bench_Case){"render_list/unsorted_100k", Bench_Render_Unsorted, &bench, BENCH_RENDER_DRAWS});
+    }
+    Game_Jobs_Destroy(&parallel);
+    Game_Jobs_Destroy(&serial);
+    for (size_t index = 0; index < BENCH_RENDER_TEXTURES; index++)
+        Game_Texture_Destroy(&bench.textures[index]);
+    Game_Render_List_Destroy(&bench.list);
+    Game_Sprite_Array_Destroy(&bench.sprites);
+}
@@ -0,0 +1,124 @@
+#include "game_bench.h"
+
+#define BENCH_SCRIPT_PLAYERS 4096
+
+/* scripts/movement.gs, without its comments. */
+static const char   bench_script_movement[] =
+    "    ld r0, x\n"
+    "    ld r1, y\n"
+    "    ld r2, speed\n"
+    "    ldk r4, 0.5\n"
+    "    mul r3, r2, r4\n"
+    "    jnin up, try_down\n"
+    "    sub r0, r0, r2\n"
+    "    sub r1, r1, r3\n"
+    "try_down:\n"
+    "    jnin down, try_left\n"
+    "    add r0, r0, r2\n"
+    "    add r1, r1, r3\n"
+    "try_left:\n"
+    "    jnin left, try_right\n"
+    "    sub r0, r0, r2\n"
+    "    add r1, r1, r3\n"
+    "try_right:\n"
+    "    jnin right, store\n"
+    "    add r0, r0, r2\n"
+    "    sub r1, r1, r3\n"
+    "store:\n"
+    "    st x, r0\n"
+    "    st y, r1\n";
+
+typedef struct Bench_Script {
+    Game_Script script;
+    Game_Script_Binding binding;
+    Game_Player *players;
+    Uint32  buttons;
+}   Bench_Script;
+
+static void Bench_Script_Reset(Bench_Script *bench) {
+    for (size_t index = 0; index < BENCH_SCRIPT_PLAYERS; index++) {
+        Game_Player_Init(&bench->players[index]);
+        bench->players[index].coordinates.x = (float)(index % 640);
+        bench->players[index].speed = 1.f + (float)(index % 7) * 0.25f;
+    }
+}
+
+static void Bench_Script_Native(void *context, size_t iterations) {
+    Bench_Script    *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        for (size_t player = 0; player < BENCH_SCRIPT_PLAYERS; player++)
+            Game_Command_ExecuteInput(bench->buttons, &bench->players[player]);
+    game_bench_sink = (size_t)bench->players[0].coordinates.x;
+}
+
+static void Bench_Script_Vm(void *context, size_t iterations) {
+    Bench_Script    *bench;
+    size_t  executed;
+
+    bench = context;
+    executed = 0;
+    for (size_t index = 0; index < iterations; index++)
+        executed += Game_Script_Run(&bench->script, &bench->binding, bench->players, BENCH_SCRIPT_PLAYERS, bench->buttons);
+    game_bench_sink = executed;
+}
+
+/* The script has to land every player exactly where the native moves do, for every combination of buttons. */
+static bool Bench_Script_Verify(Bench_Script *bench, Game_Player *expected) {
+    for (Uint32 buttons = 0; buttons < 16; buttons++) {
+        Bench_Script_Reset(bench);
+        for (size_t player = 0; player < BENCH_SCRIPT_PLAYERS; player++) {
+            expected[player] = bench->players[player];
+            Game_Command_ExecuteInput(buttons, &expected[player]);
+        }
+        Game_Script_Run(&bench->script, &bench->binding, bench->players, BENCH_SCRIPT_PLAYERS, buttons);
+        for (size_t player = 0; player < BENCH_SCRIPT_PLAYERS; player++)
+            if (SDL_memcmp(&expected[player].coordinates, &bench->players[player].coordinates, sizeof(Coordinates)) != 0)
+                return (false);
+    }
+    return (true);
+}
+
+/*
+** `items` is the number of script instructions one batch executes, so the
+** items/s column reads as VM instructions per second, and for the native
+** case as the rate the VM would need to keep up with it.
+*/
+static void Bench_Script_Run(Game_Bench *this, Bench_Script *bench, const char *label, Uint32 buttons) {
+    char    name[64];
+    size_t  instructions;
+
+    bench->buttons = buttons;
+    Bench_Script_Reset(bench);
+    instructions = Game_Script_Run(&bench->script, &bench->binding, bench->players, BENCH_SCRIPT_PLAYERS, buttons);
+    SDL_snprintf(name, sizeof(name), "script/movement_4k/%s/native", label);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Script_Native, bench, instructions});
+    SDL_snprintf(name, sizeof(name), "script/movement_4k/%s/vm", label);
+    Game_Bench_Run(this, (Game_Bench_Case){name, Bench_Script_Vm, bench, instructions});
+}
+
+void    Game_Bench_Suite_Script(Game_Bench *this) {
+    static const Game_Script_Binding    binding = GAME_PLAYER_SCRIPT_BINDING;
+    Bench_Script    *bench;
+    Game_Player *expected;
+
+    if (Game_Bench_IsSelected(this, "script/") == false)
+        return ;
+    if ((bench = calloc(1, sizeof(Bench_Script))) == NULL)
+        return ;
+    bench->binding = binding;
+    bench->players = malloc(sizeof(Game_Player) * BENCH_SCRIPT_PLAYERS);
+    expected = malloc(sizeof(Game_Player) * BENCH_SCRIPT_PLAYERS);
+    if (Game_Bench_Check(this, Game_Script_Assemble(&bench->script, bench_script_movement)) == false)
+        SDL_Log("bench: script: %s", SDL_GetError());
+    else if (bench->players != NULL && expected != NULL) {
+        if (Game_Bench_Check(this, Bench_Script_Verify(bench, expected)) == false)
+            SDL_Log("bench: script/movement: the script and the native moves disagree");
+        Bench_Script_Run(this, bench, "diagonal", GAME_INPUT_UP | GAME_INPUT_RIGHT);
+        Bench_Script_Run(this, bench, "all", GAME_INPUT_UP | GAME_INPUT_DOWN | GAME_INPUT_LEFT | GAME_INPUT_RIGHT);
+    }
+    free(expected);
+    free(bench->players);
+    free(bench);
+}
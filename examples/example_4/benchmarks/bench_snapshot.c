@@ -0,0 +1,75 @@
+#include "game_bench.h"
+#include "game_stress.h"
+
+#define BENCH_SNAPSHOT_SPRITES 10000
+#define BENCH_SNAPSHOT_PARTICLES 20000
+
+typedef struct Bench_Snapshot {
+    Game    *game;
+    Game_Snapshot   snapshot;
+}   Bench_Snapshot;
+
+static void Bench_Snapshot_Capture(void *context, size_t iterations) {
+    Bench_Snapshot  *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Snapshot_Capture(&bench->snapshot, bench->game);
+    game_bench_sink = bench->snapshot.length;
+}
+
+/* Includes the hash check, as every real restore pays it. */
+static void Bench_Snapshot_Restore(void *context, size_t iterations) {
+    Bench_Snapshot  *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Snapshot_Restore(&bench->snapshot, bench->game);
+    game_bench_sink = bench->game->sprites.length;
+}
+
+/*
+** Only the simulation state is set up: the textures get ids and sizes but no
+** SDL texture, which snapshots never look at.
+*/
+static bool Bench_Snapshot_Setup(Game *game) {
+    Game_Error_Init(&game->error);
+    Game_Texture_Array_Init(&game->textures);
+    Game_Player_Init(&game->player);
+    Game_Sprite_Array_Init(&game->sprites);
+    Game_Camera_Init(&game->camera, WINDOW_WIDTH, WINDOW_HEIGHT);
+    Game_Animation_Library_Init(&game->animations);
+    game->frame = 0;
+    game->player.texture.id = 1;
+    for (size_t index = 0; index < game->textures.capacity; index++) {
+        game->textures.content[index].id = (Uint16)(index + 2);
+        Size_Set(&game->textures.content[index].size, 32, 32);
+    }
+    if (Game_Particle_Pool_Init(&game->particles, BENCH_SNAPSHOT_PARTICLES, GAME_PARTICLE_SIZE, NULL) == false
+        || Game_Stress_Spawn(game, BENCH_SNAPSHOT_SPRITES, false) == false)
+        return (false);
+    Game_Particle_Pool_Emit(&game->particles, WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f,
+        BENCH_SNAPSHOT_PARTICLES, &game_particle_sparks);
+    game->player_previous = game->player.coordinates;
+    return (true);
+}
+
+void    Game_Bench_Suite_Snapshot(Game_Bench *this) {
+    Bench_Snapshot  bench;
+    size_t  items;
+
+    if (Game_Bench_IsSelected(this, "snapshot/") == false)
+        return ;
+    if ((bench.game = calloc(1, sizeof(Game))) == NULL)
+        return ;
+    Game_Snapshot_Init(&bench.snapshot);
+    items = BENCH_SNAPSHOT_SPRITES + BENCH_SNAPSHOT_PARTICLES;
+    if (Bench_Snapshot_Setup(bench.game) && Game_Snapshot_Capture(&bench.snapshot, bench.game)) {
+        Game_Bench_Run(this, (Game_Bench_Case){"snapshot/capture_10k_20k", Bench_Snapshot_Capture, &bench, items});
+        Game_Bench_Run(this, (Game_Bench_Case){"snapshot/restore_10k_20k", Bench_Snapshot_Restore, &bench, items});
+    }
+    Game_Snapshot_Destroy(&bench.snapshot);
+    Game_Particle_Pool_Destroy(&bench.game->particles);
+    Game_Sprite_Array_Destroy(&bench.game->sprites);
+    free(bench.game);
+}
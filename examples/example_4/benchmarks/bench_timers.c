@@ -0,0 +1,144 @@
+#include "game_bench.h"
+
+#define BENCH_TIMERS_COUNT 1000000
+/* Delays spread over about 2^20 ticks: close to one expiry per tick once 1M timers are pending. */
+#define BENCH_TIMERS_SPREAD (1u << 20)
+
+typedef struct Bench_Timers {
+    Game_Timer_Wheel    wheel;
+    Game_Timer_Handle   *handles;
+    Uint64  *deadlines;
+    Uint64  now;
+    Uint32  state;
+    size_t  fired;
+    size_t  wrong;
+}   Bench_Timers;
+
+static Uint64   Bench_Timers_Delay(Bench_Timers *bench, Uint32 spread) {
+    bench->state = bench->state * 1664525u + 1013904223u;
+    return (1 + (bench->state >> 8) % spread);
+}
+
+static void Bench_Timers_Count(void *context, Uint64 data) {
+    (void)data;
+    ((Bench_Timers *)context)->fired++;
+}
+
+/* `data` is the tick the timer was due at. */
+static void Bench_Timers_Check(void *context, Uint64 data) {
+    Bench_Timers    *bench;
+
+    bench = context;
+    bench->wrong += bench->wheel.now != data;
+}
+
+/*
+** Every timer has to fire on its own tick, across cascades at every
+** level; half of the random ones are cancelled on the way.
+*/
+static bool Bench_Timers_Verify(Bench_Timers *bench) {
+    static const Uint64 delays[] = {1, 255, 256, 257, 65535, 65536, 65537, 16777215, 16777216, 16777217};
+    Uint64  delay;
+    Uint64  last;
+
+    last = 0;
+    for (size_t timer = 0; timer < BENCH_TIMERS_COUNT / 10; timer++) {
+        delay = timer < SDL_arraysize(delays) ? delays[timer] : Bench_Timers_Delay(bench, BENCH_TIMERS_SPREAD * 4);
+        last = SDL_max(last, delay);
+        bench->handles[timer] = Game_Timer_Wheel_Schedule(&bench->wheel, delay, Bench_Timers_Check, bench,
+            bench->wheel.now + delay);
+    }
+    for (size_t timer = SDL_arraysize(delays); timer < BENCH_TIMERS_COUNT / 10; timer += 2)
+        Game_Timer_Wheel_Cancel(&bench->wheel, bench->handles[timer]);
+    Game_Timer_Wheel_Advance(&bench->wheel, last);
+    return (bench->wrong == 0 && bench->wheel.pending == 0);
+}
+
+/* A timer that comes back, so the number pending never drops. */
+static void Bench_Timers_Repeat(void *context, Uint64 data) {
+    Bench_Timers    *bench;
+
+    bench = context;
+    bench->fired++;
+    Game_Timer_Wheel_Schedule(&bench->wheel, Bench_Timers_Delay(bench, BENCH_TIMERS_SPREAD), Bench_Timers_Repeat, bench, data);
+}
+
+static void Bench_Timers_ScheduleCancel(void *context, size_t iterations) {
+    Bench_Timers    *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        for (size_t timer = 0; timer < BENCH_TIMERS_COUNT; timer++)
+            bench->handles[timer] = Game_Timer_Wheel_Schedule(&bench->wheel, Bench_Timers_Delay(bench, BENCH_TIMERS_SPREAD),
+                Bench_Timers_Count, bench, timer);
+        for (size_t timer = 0; timer < BENCH_TIMERS_COUNT; timer++)
+            Game_Timer_Wheel_Cancel(&bench->wheel, bench->handles[timer]);
+    }
+    game_bench_sink = bench->wheel.pending + bench->wheel.rejected;
+}
+
+/* 1M timers due within 256 ticks: scheduling, then firing them in per-tick batches. */
+static void Bench_Timers_FireBatch(void *context, size_t iterations) {
+    Bench_Timers    *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        for (size_t timer = 0; timer < BENCH_TIMERS_COUNT; timer++)
+            Game_Timer_Wheel_Schedule(&bench->wheel, Bench_Timers_Delay(bench, GAME_TIMER_WHEEL_SLOTS), Bench_Timers_Count, bench, timer);
+        Game_Timer_Wheel_Advance(&bench->wheel, GAME_TIMER_WHEEL_SLOTS);
+    }
+    game_bench_sink = bench->fired;
+}
+
+static void Bench_Timers_Tick(void *context, size_t iterations) {
+    Bench_Timers    *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++)
+        Game_Timer_Wheel_Advance(&bench->wheel, 1);
+    game_bench_sink = bench->fired;
+}
+
+/* The alternative: every pending deadline checked on every tick. */
+static void Bench_Timers_Scan(void *context, size_t iterations) {
+    Bench_Timers    *bench;
+
+    bench = context;
+    for (size_t index = 0; index < iterations; index++) {
+        bench->now++;
+        for (size_t timer = 0; timer < BENCH_TIMERS_COUNT; timer++)
+            if (bench->deadlines[timer] == bench->now) {
+                bench->fired++;
+                bench->deadlines[timer] = bench->now + Bench_Timers_Delay(bench, BENCH_TIMERS_SPREAD);
+            }
+    }
+    game_bench_sink = bench->fired;
+}
+
+void    Game_Bench_Suite_Timers(Game_Bench *this) {
+    Bench_Timers    *bench;
+
+    if (Game_Bench_IsSelected(this, "timers/") == false)
+        return ;
+    if ((bench = calloc(1, sizeof(Bench_Timers))) == NULL)
+        return ;
+    bench->state = 0x2545F491u;
+    bench->handles = malloc(sizeof(Game_Timer_Handle) * BENCH_TIMERS_COUNT);
+    bench->deadlines = malloc(sizeof(Uint64) * BENCH_TIMERS_COUNT);
+    if (bench->handles != NULL && bench->deadlines != NULL && Game_Timer_Wheel_Init(&bench->wheel, BENCH_TIMERS_COUNT)) {
+        if (Game_Bench_Check(this, Bench_Timers_Verify(bench)) == false)
+            SDL_Log("bench: timers: %zu timers fired on the wrong tick, %zu left pending", bench->wrong, bench->wheel.pending);
+        Game_Bench_Run(this, (Game_Bench_Case){"timers/schedule_cancel_1m", Bench_Timers_ScheduleCancel, bench, BENCH_TIMERS_COUNT});
+        Game_Bench_Run(this, (Game_Bench_Case){"timers/fire_batch_1m", Bench_Timers_FireBatch, bench, BENCH_TIMERS_COUNT});
+        for (size_t timer = 0; timer < BENCH_TIMERS_COUNT; timer++)
+            Game_Timer_Wheel_Schedule(&bench->wheel, Bench_Timers_Delay(bench, BENCH_TIMERS_SPREAD), Bench_Timers_Repeat, bench, timer);
+        Game_Bench_Run(this, (Game_Bench_Case){"timers/tick_1m_pending", Bench_Timers_Tick, bench, 1});
+        for (size_t timer = 0; timer < BENCH_TIMERS_COUNT; timer++)
+            bench->deadlines[timer] = Bench_Timers_Delay(bench, BENCH_TIMERS_SPREAD);
+        Game_Bench_Run(this, (Game_Bench_Case){"timers/scan_1m_pending", Bench_Timers_Scan, bench, 1});
+    }
+    Game_Timer_Wheel_Destroy(&bench->wheel);
+    free(bench->deadlines);
+    free(bench->handles);
+    free(bench);
+}
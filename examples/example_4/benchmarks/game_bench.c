@@ -0,0 +1,127 @@
+#include "game_bench.h"
+
+volatile size_t game_bench_sink;
+
+void    Game_Bench_Init(Game_Bench *this) {
+    this->length = 0;
+    this->filter = NULL;
+    this->min_time_ns = GAME_BENCH_DEFAULT_MIN_TIME_NS;
+    this->failures = 0;
+    this->window.content = NULL;
+    this->window.renderer = NULL;
+    this->window.surface = NULL;
+}
+
+bool    Game_Bench_IsSelected(Game_Bench *this, const char *name) {
+    return (this->filter == NULL || SDL_strstr(name, this->filter) != NULL);
+}
+
+/* A suite's correctness check: a failed one makes the run exit with an error. */
+bool    Game_Bench_Check(Game_Bench *this, bool passed) {
+    if (passed == false)
+        this->failures++;
+    return (passed);
+}
+
+static int  Game_Bench_CompareDouble(const void *left, const void *right) {
+    double  a;
+    double  b;
+
+    a = *(const double *)left;
+    b = *(const double *)right;
+    return ((a > b) - (a < b));
+}
+
+static Uint64   Game_Bench_Time(Game_Bench_Case *bench_case, size_t iterations) {
+    Uint64  start;
+
+    start = SDL_GetTicksNS();
+    bench_case->run(bench_case->context, iterations);
+    return (SDL_GetTicksNS() - start);
+}
+
+void    Game_Bench_Run(Game_Bench *this, Game_Bench_Case bench_case) {
+    Game_Bench_Result   *result;
+    double  samples[GAME_BENCH_REPETITIONS];
+    Uint64  batch_ns;
+    size_t  iterations;
+
+    if (Game_Bench_IsSelected(this, bench_case.name) == false || this->length >= GAME_BENCH_MAX_RESULTS)
+        return ;
+    batch_ns = this->min_time_ns / GAME_BENCH_REPETITIONS;
+    iterations = 1;
+    while (Game_Bench_Time(&bench_case, iterations) < batch_ns && iterations < ((size_t)1 << 40))
+        iterations *= 2;
+    for (size_t index = 0; index < GAME_BENCH_REPETITIONS; index++)
+        samples[index] = (double)Game_Bench_Time(&bench_case, iterations) / (double)iterations;
+    SDL_qsort(samples, GAME_BENCH_REPETITIONS, sizeof(double), Game_Bench_CompareDouble);
+    result = &this->results[this->length++];
+    SDL_snprintf(result->name, sizeof(result->name), "%s", bench_case.name);
+    result->iterations = iterations;
+    result->items = bench_case.items ? bench_case.items : 1;
+    result->ns_per_iteration = samples[GAME_BENCH_REPETITIONS / 2];
+    result->ns_per_iteration_min = samples[0];
+    result->ns_per_iteration_max = samples[GAME_BENCH_REPETITIONS - 1];
+}
+
+void    Game_Bench_Record(Game_Bench *this, const char *name, size_t iterations, size_t items, Uint64 elapsed_ns) {
+    Game_Bench_Result   *result;
+
+    if (this->length >= GAME_BENCH_MAX_RESULTS || iterations == 0)
+        return ;
+    result = &this->results[this->length++];
+    SDL_snprintf(result->name, sizeof(result->name), "%s", name);
+    result->iterations = iterations;
+    result->items = items ? items : 1;
+    result->ns_per_iteration = (double)elapsed_ns / (double)iterations;
+    result->ns_per_iteration_min = result->ns_per_iteration;
+    result->ns_per_iteration_max = result->ns_per_iteration;
+}
+
+void    Game_Bench_PrintTable(Game_Bench *this, FILE *output) {
+    Game_Bench_Result   *result;
+
+    fprintf(output, "%-40s %14s %14s %14s\n", "benchmark", "ns/iter", "ns/item", "items/s");
+    for (size_t index = 0; index < this->length; index++) {
+        result = &this->results[index];
+        fprintf(output, "%-40s %14.1f %14.3f %14.4g\n", result->name, result->ns_per_iteration,
+            result->ns_per_iteration / (double)result->items,
+            1e9 * (double)result->items / result->ns_per_iteration);
+    }
+}
+
+/* A JSON string literal: quotes, backslashes and control characters escaped. */
+static void Game_Bench_PrintJsonString(FILE *output, const char *text) {
+    fputc('"', output);
+    for (; *text != '\0'; text++) {
+        if (*text == '"' || *text == '\\')
+            fprintf(output, "\\%c", *text);
+        else if ((unsigned char)*text < 0x20)
+            fprintf(output, "\\u%04x", (unsigned char)*text);
+        else
+            fputc(*text, output);
+    }
+    fputc('"', output);
+}
+
+void    Game_Bench_PrintJson(Game_Bench *this, FILE *output, const char *revision) {
+    Game_Bench_Result   *result;
+
+    fprintf(output, "{\n  \"revision\": ");
+    Game_Bench_PrintJsonString(output, revision ? revision : "unknown");
+    fprintf(output, ",\n");
+#ifdef GAME_BUILD_CONFIG
+    fprintf(output, "  \"build\": \"%s\",\n", GAME_BUILD_CONFIG);
+#endif
+    fprintf(output, "  \"benchmarks\": [\n");
+    for (size_t index = 0; index < this->length; index++) {
+        result = &this->results[index];
+        fprintf(output, "    {\"name\": \"%s\", \"iterations\": %zu, \"items_per_iteration\": %zu, "
+            "\"ns_per_iteration\": %.3f, \"ns_per_iteration_min\": %.3f, \"ns_per_iteration_max\": %.3f, "
+            "\"ns_per_item\": %.4f}%s\n",
+            result->name, result->iterations, result->items, result->ns_per_iteration,
+            result->ns_per_iteration_min, result->ns_per_iteration_max,
+            result->ns_per_iteration / (double)result->items, index + 1 < this->length ? "," : "");
+    }
+    fprintf(output, "  ]\n}\n");
+}
@@ -0,0 +1,67 @@
+#ifndef GAME_BENCH_H
+# define GAME_BENCH_H
+
+# include "game.h"
+
+# define GAME_BENCH_MAX_RESULTS 256
+# define GAME_BENCH_REPETITIONS 5
+# define GAME_BENCH_DEFAULT_MIN_TIME_NS 100000000
+
+/*
+** A benchmark body runs its workload `iterations` times. `items` is the
+** number of elements one iteration processes (sprites, commands, bytes...)
+** and is only used to report a per-item cost and a throughput.
+*/
+typedef void    (*Game_Bench_Function)(void *context, size_t iterations);
+
+typedef struct Game_Bench_Case {
+    const char  *name;
+    Game_Bench_Function run;
+    void    *context;
+    size_t  items;
+}   Game_Bench_Case;
+
+typedef struct Game_Bench_Result {
+    char    name[64];
+    size_t  iterations;
+    size_t  items;
+    double  ns_per_iteration;
+    double  ns_per_iteration_min;
+    double  ns_per_iteration_max;
+}   Game_Bench_Result;
+
+typedef struct Game_Bench {
+    Game_Bench_Result   results[GAME_BENCH_MAX_RESULTS];
+    size_t  length;
+    const char  *filter;
+    Uint64  min_time_ns;
+    size_t  failures;
+    Game_Window window;
+}   Game_Bench;
+
+extern volatile size_t  game_bench_sink;
+
+void    Game_Bench_Init(Game_Bench *this);
+bool    Game_Bench_IsSelected(Game_Bench *this, const char *name);
+bool    Game_Bench_Check(Game_Bench *this, bool passed);
+void    Game_Bench_Run(Game_Bench *this, Game_Bench_Case bench_case);
+void    Game_Bench_Record(Game_Bench *this, const char *name, size_t iterations, size_t items, Uint64 elapsed_ns);
+void    Game_Bench_PrintTable(Game_Bench *this, FILE *output);
+void    Game_Bench_PrintJson(Game_Bench *this, FILE *output, const char *revision);
+
+void    Game_Bench_Suite_Core(Game_Bench *this);
+void    Game_Bench_Suite_Animation(Game_Bench *this);
+void    Game_Bench_Suite_Particle(Game_Bench *this);
+void    Game_Bench_Suite_Render(Game_Bench *this);
+void    Game_Bench_Suite_Snapshot(Game_Bench *this);
+void    Game_Bench_Suite_Lockstep(Game_Bench *this);
+void    Game_Bench_Suite_Image(Game_Bench *this);
+void    Game_Bench_Suite_Audio(Game_Bench *this);
+void    Game_Bench_Suite_Flow(Game_Bench *this);
+void    Game_Bench_Suite_Hud(Game_Bench *this);
+void    Game_Bench_Suite_Collision(Game_Bench *this);
+void    Game_Bench_Suite_Timers(Game_Bench *this);
+void    Game_Bench_Suite_Script(Game_Bench *this);
+void    Game_Bench_Suite_Mip(Game_Bench *this);
+
+#endif
@@ -0,0 +1,1213 @@
+#include "game.h"
+#include "game_pipeline.h"
+
+static const char  *texture_path[SPRITE_NUMBER] = {
+    PATH_SPRITE_FLOOR,
+    PATH_SPRITE_PLAYER,
+    PATH_SPRITE_BOO
+};
+
+/* Render-list sort keys group draws by this id; 0 is never handed out. */
+static Uint16   texture_serial = 0;
+
+void    Size_Set(Size *this, size_t width, size_t height) {
+    this->width = width;
+    this->height = height;
+}
+
+void    Size_Init(Size *this) {
+    this->width = 0;
+    this->height = 0;
+}
+
+size_t  Size_GetWidth(Size *this) {
+    return (this->width);
+}
+
+size_t  Size_GetHeight(Size *this) {
+    return (this->height);
+}
+
+void    Coordinates_Init(Coordinates *this) {
+    this->x = 0;
+    this->y = 0;
+}
+
+float    Coordinates_Getx(Coordinates *this) {
+    return (this->x);
+}
+
+float   Coordinates_Gety(Coordinates *this) {
+    return (this->y);
+}
+
+void   Coordinates_Setx(Coordinates *this, float x) {
+    this->x = x;
+}
+
+void    Coordinates_Sety(Coordinates *this, float y) {
+    this->y = y;
+}
+
+void    Game_Timer_Init(Game_Timer *this) {
+    this->screen_fps = DEFAULT_FPS;
+    this->ns_per_frame = 1000000000 / this->screen_fps;
+    this->rendering_ns = 0;
+    this->start_ticks = 0;
+    this->paused_ticks = 0;
+    this->is_paused = false;
+    this->is_started = false;
+}
+
+void    Game_Timer_SetFPS(Game_Timer *this, size_t fps) {
+    this->screen_fps = fps;
+    this->ns_per_frame = fps != 0 ? 1000000000 / fps : 0;
+}
+
+void    Game_Texture_Init(Game_Texture *this) {
+    Game_Error_Init(&this->error);
+    this->rectangle = (SDL_FRect){0, 0, 0, 0};
+    this->content = NULL;
+    this->path = NULL;
+    this->id = 0;
+    this->code = SPRITE_NUMBER;
+    Size_Init(&this->size);
+    Game_Collision_Mask_Init(&this->mask);
+    Game_Mip_Chain_Init(&this->mips);
+}
+
+void    Game_Player_Init(Game_Player *this) {
+    Coordinates_Init(&this->coordinates);
+    Game_Texture_Init(&this->texture);
+    this->texture.path = PATH_SPRITE_PLAYER;
+    this->texture.code = PLAYER;
+    this->speed = 8.f;
+}
+
+void    Game_Floor_Init(Game_Floor  *this) {
+    Coordinates_Init(&this->coordinates);
+    Game_Texture_Init(&this->texture);
+    this->texture.path = PATH_SPRITE_FLOOR;
+    this->texture.code = FLOOR;
+}
+
+void    Game_Surface_Init(Game_Surface  *this) {
+    Game_Error_Init(&this->error);
+    this->content = NULL;
+}
+
+static void Game_Window_InitTarget(Game_Window *this) {
+    this->target = NULL;
+    this->render_scale = 1.f;
+    this->zoom = 1.f;
+    this->scale_mode = SDL_SCALEMODE_LINEAR;
+    this->draw_calls = 0;
+    this->fill_pixels = 0;
+    this->fill_texels = 0;
+    this->mipmaps = true;
+}
+
+void    Game_Window_Init(Game_Window *this) {
+    this->surface = NULL;
+    Game_Window_InitTarget(this);
+    if (SDL_CreateWindowAndRenderer("test", WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_FULLSCREEN, &this->content, &this->renderer) == false)
+        exit(-1);
+    /*if (SDL_SetRenderVSync(this->renderer, 1) == false)
+        exit(-1);*/
+}
+
+bool    Game_Window_InitOffscreen(Game_Window *this, int width, int height) {
+    this->vsync_enabled = false;
+    this->content = NULL;
+    this->renderer = NULL;
+    Game_Window_InitTarget(this);
+    if ((this->surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888)) == NULL)
+        return (false);
+    if ((this->renderer = SDL_CreateSoftwareRenderer(this->surface)) == NULL) {
+        SDL_DestroySurface(this->surface);
+        this->surface = NULL;
+        return (false);
+    }
+    Game_Memory_Add(GAME_MEMORY_SURFACES, Game_Memory_SurfaceBytes(this->surface));
+    return (true);
+}
+
+/* Adaptive vsync is not available everywhere; fall back to plain vsync. */
+bool    Game_Window_SetVSync(Game_Window *this, int vsync) {
+    if (SDL_SetRenderVSync(this->renderer, vsync) == false
+        && (vsync != SDL_RENDERER_VSYNC_ADAPTIVE || SDL_SetRenderVSync(this->renderer, 1) == false))
+        return (false);
+    this->vsync_enabled = (vsync != SDL_RENDERER_VSYNC_DISABLED);
+    return (true);
+}
+
+/*
+** Below 1, the scene is drawn into a WINDOW_WIDTH * scale by
+** WINDOW_HEIGHT * scale target texture (SDL_SetRenderScale keeps the game in
+** window coordinates) and upscaled to the window in one pass by EndFrame.
+*/
+bool    Game_Window_SetRenderScale(Game_Window *this, float scale) {
+    SDL_Texture *target;
+    int     width;
+    int     height;
+
+    scale = SDL_clamp(scale, RENDER_SCALE_MIN, 1.f);
+    if (scale == this->render_scale && (scale == 1.f || this->target != NULL))
+        return (true);
+    target = NULL;
+    if (scale < 1.f) {
+        width = (int)SDL_ceilf(WINDOW_WIDTH * scale);
+        height = (int)SDL_ceilf(WINDOW_HEIGHT * scale);
+        target = SDL_CreateTexture(this->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (target == NULL)
+            return (false);
+        SDL_SetTextureScaleMode(target, this->scale_mode);
+    }
+    Game_Memory_Add(GAME_MEMORY_TEXTURES, (Sint64)Game_Memory_TextureBytes(target) - (Sint64)Game_Memory_TextureBytes(this->target));
+    SDL_DestroyTexture(this->target);
+    this->target = target;
+    this->render_scale = scale;
+    return (true);
+}
+
+void    Game_Window_SetScaleMode(Game_Window *this, SDL_ScaleMode scale_mode) {
+    this->scale_mode = scale_mode;
+    if (this->target != NULL)
+        SDL_SetTextureScaleMode(this->target, scale_mode);
+}
+
+/* The camera zoom rides on the renderer scale for the whole frame. */
+void    Game_Window_BeginFrame(Game_Window *this, float zoom) {
+    this->draw_calls = 0;
+    this->fill_pixels = 0;
+    this->fill_texels = 0;
+    this->zoom = zoom;
+    if (this->target != NULL)
+        SDL_SetRenderTarget(this->renderer, this->target);
+    SDL_SetRenderScale(this->renderer, this->render_scale * zoom, this->render_scale * zoom);
+}
+
+void    Game_Window_EndFrame(Game_Window *this) {
+    int     width;
+    int     height;
+
+    if (this->target != NULL)
+        SDL_SetRenderTarget(this->renderer, NULL);
+    SDL_SetRenderScale(this->renderer, 1.f, 1.f);
+    if (this->target == NULL)
+        return ;
+    SDL_RenderTexture(this->renderer, this->target, NULL, NULL);
+    SDL_GetRenderOutputSize(this->renderer, &width, &height);
+    this->draw_calls++;
+    this->fill_pixels += (Uint64)width * (Uint64)height;
+    this->fill_texels += (Uint64)this->target->w * (Uint64)this->target->h;
+}
+
+/* Something on screen before any asset exists. */
+void    Game_Window_PresentBlank(Game_Window *this) {
+    SDL_SetRenderDrawColor(this->renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(this->renderer);
+    SDL_RenderPresent(this->renderer);
+}
+
+void    Game_Texture_Array_Init(Game_Texture_Array *this) {
+    this->capacity = TEXTURES_NUMBER;
+    for (size_t index = 0; index < this->capacity; index++) {
+        Game_Texture_Init(&this->content[index]);
+        this->content[index].code = (Sprite_Code)index;
+    }
+}
+
+/* The images the scene will need, decoded while the window comes up. */
+static void Game_QueueAssets(Game *this, Game_Config *config) {
+    if (Game_Config_IsStress(config)) {
+        Game_Startup_Queue(&this->startup, &this->textures.content[PLAYER], texture_path[PLAYER]);
+        Game_Startup_Queue(&this->startup, &this->textures.content[BOO], texture_path[BOO]);
+    }
+    else
+        Game_Startup_Queue(&this->startup, &this->floor.texture, this->floor.texture.path);
+    Game_Startup_Queue(&this->startup, &this->player.texture, this->player.texture.path);
+}
+
+/*
+** Brings up what the first frame needs, decoding the scene's images in the
+** background meanwhile, and presents that frame. The textures themselves are
+** made by Game_Texure_LoadFromFile; the job workers start on first use.
+*/
+void    Game_Init(Game *this, Game_Config *config) {
+    Game_Memory_Add(GAME_MEMORY_STRUCTS, sizeof(Game));
+    Game_Startup_Init(&this->startup);
+    Game_Error_Init(&this->error);
+    Game_Texture_Array_Init(&this->textures);
+    Game_Player_Init(&this->player);
+    Game_Floor_Init(&this->floor);
+    Game_QueueAssets(this, config);
+    Game_Startup_Decode(&this->startup);
+    if (config->offscreen) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
+    if (SDL_Init(SDL_INIT_VIDEO) == false)
+        exit(-1);
+    Game_Startup_Mark(&this->startup, GAME_STARTUP_VIDEO);
+    if (config->offscreen == false)
+        Game_Window_Init(&this->window);
+    else if (Game_Window_InitOffscreen(&this->window, WINDOW_WIDTH, WINDOW_HEIGHT) == false)
+        exit(-1);
+    Game_Startup_Mark(&this->startup, GAME_STARTUP_WINDOW);
+    Game_Window_PresentBlank(&this->window);
+    Game_Startup_Mark(&this->startup, GAME_STARTUP_FIRST_FRAME);
+    Game_Hud_Init(&this->hud);
+    this->hud.visible = config->hud;
+    Game_Capture_Init(&this->capture);
+    if (config->capture_path != NULL && Game_Capture_Open(&this->capture, this->window.renderer, config->capture_path,
+        (int)config->capture_scale, config->capture_every, DEFAULT_FPS) == false)
+        SDL_Log("capture %s: %s", config->capture_path, SDL_GetError());
+    SDL_zero(this->audio);
+    this->blip = GAME_AUDIO_NO_SOUND;
+    this->audio_started = false;
+    this->pending_volume = 0.f;
+    this->pending_pitch = 0.f;
+    Game_Sprite_Array_Init(&this->sprites);
+    Game_Camera_Init(&this->camera, WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (config->zoom > 0.f)
+        Game_Camera_SetZoom(&this->camera, config->zoom);
+    this->window.mipmaps = config->mipmaps;
+    if (Game_Jobs_Init(&this->jobs, (size_t)SDL_max(SDL_GetNumLogicalCPUCores() - 1, 0)) == false)
+        SDL_Log("jobs: running on the calling thread only: %s", SDL_GetError());
+    Game_Render_List_Init(&this->render_list);
+    Game_Animation_Library_Init(&this->animations);
+    if (Game_Particle_Pool_Init(&this->particles, SDL_max(GAME_PARTICLE_CAPACITY, config->stress_particles),
+        GAME_PARTICLE_SIZE, NULL) == false)
+        Game_Error_Append(&this->error, GAME_ALLOCATION_ERROR);
+    this->particle_fountain = 0;
+    this->chase = config->chase;
+    this->contacts = 0;
+    if (Game_Timer_Wheel_Init(&this->timers, GAME_TIMER_CAPACITY) == false)
+        Game_Error_Append(&this->error, GAME_ALLOCATION_ERROR);
+    this->contact_cooldown = GAME_TIMER_NONE;
+    if (Game_Flow_Field_Init(&this->flow, (size_t)SDL_ceilf(WINDOW_WIDTH / GAME_FLOW_TILE),
+        (size_t)SDL_ceilf(WINDOW_HEIGHT / GAME_FLOW_TILE), GAME_FLOW_TILE) == false)
+        Game_Error_Append(&this->error, GAME_ALLOCATION_ERROR);
+    this->player_previous = this->player.coordinates;
+    Game_Timer_Init(&this->timer);
+    Game_Idle_Init(&this->idle, (Uint64)config->idle_wake_ms * 1000000);
+    if (config->paused)
+        Game_Idle_Set(&this->idle, GAME_IDLE_PAUSED, true);
+    Game_Script_Init(&this->player_script);
+    if (config->player_script_path != NULL && Game_Script_Load(&this->player_script, config->player_script_path) == false)
+        SDL_Log("player script %s: %s", config->player_script_path, SDL_GetError());
+    Game_Script_Init(&this->sprite_script);
+    if (config->sprite_script_path != NULL && Game_Script_Load(&this->sprite_script, config->sprite_script_path) == false)
+        SDL_Log("sprite script %s: %s", config->sprite_script_path, SDL_GetError());
+    this->stats = NULL;
+    this->frame = 0;
+    this->frame_limit = config->frame_limit;
+    this->pipelined = config->pipelined;
+    Game_Snapshot_Init(&this->quicksave);
+    this->frame_start_ns = 0;
+    this->frame_cost_ns = 0;
+    Game_Adaptive_Init(&this->adaptive, config->adaptive > 0);
+    this->quality = Game_Adaptive_GetLevel(&this->adaptive)->quality;
+    if (this->adaptive.enabled)
+        Game_ApplyAdaptiveLevel(this);
+    Game_Window_SetScaleMode(&this->window, config->render_linear ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST);
+    if (config->render_scale > 0.f && Game_Window_SetRenderScale(&this->window, config->render_scale) == false)
+        SDL_Log("render scale %.2f: %s", config->render_scale, SDL_GetError());
+}
+
+void    Game_ApplyAdaptiveLevel(Game *this) {
+    const Game_Adaptive_Level   *level;
+
+    level = Game_Adaptive_GetLevel(&this->adaptive);
+    Game_Timer_SetFPS(&this->timer, level->fps);
+    Game_Window_SetVSync(&this->window, level->vsync);
+    this->quality = level->quality;
+    Game_Particle_Pool_SetLimit(&this->particles, level->quality.particle_limit);
+    Game_Window_SetRenderScale(&this->window, level->quality.render_scale);
+    SDL_LogVerbose(SDL_LOG_CATEGORY_APPLICATION, "adaptive: level %zu, %zu fps, vsync %d, render scale %.2f",
+        this->adaptive.level, level->fps, level->vsync, level->quality.render_scale);
+}
+ /*--------------------------------------------------*/
+
+void    Game_Timer_Start(Game_Timer *this) {
+    this->is_started = true;
+    this->is_paused = false;
+    this->start_ticks = SDL_GetTicksNS();
+    this->paused_ticks = 0;
+}
+
+void    Game_Timer_Stop(Game_Timer *this) {
+    this->is_started = false;
+    this->is_paused = true;
+    this->start_ticks = 0;
+    this->paused_ticks = 0;
+}
+
+void    Game_Timer_Pause(Game_Timer *this) {
+    if (this->is_started && !this->is_paused) {
+        this->is_paused = true;
+        this->paused_ticks = SDL_GetTicksNS() - this->start_ticks;
+        this->start_ticks = 0;
+    }
+}
+
+void    Game_Timer_Unpause(Game_Timer *this) {
+    if (this->is_started && this->is_paused) {
+        this->is_paused = false;
+        this->start_ticks = SDL_GetTicksNS() - this->paused_ticks;
+        this->paused_ticks = 0;
+    }
+}
+
+size_t  Game_Timer_GetTicksNS(Game_Timer *this) {
+    size_t  time;
+
+    time = 0;
+    if (this->is_started) {
+        if (this->is_paused)
+            time = this->paused_ticks;
+        else
+            time = SDL_GetTicksNS() - this->start_ticks;
+    }
+    return (time);
+}
+
+bool    Game_Timer_IsPaused(Game_Timer *this) {
+    return (this->is_started && this->is_paused);
+}
+
+bool    Game_Timer_IsStarted(Game_Timer *this) {
+    return (this->is_started);
+}
+
+size_t  Game_Timer_Elapsed(Game_Timer *this) {
+    return (SDL_GetTicksNS() - this->start_ticks);
+}
+
+void    Game_Timer_Sync(Game_Timer *this) {
+    size_t  elapsed;
+
+    elapsed = Game_Timer_Elapsed(this);
+    if (elapsed < this->ns_per_frame)
+        SDL_DelayNS(this->ns_per_frame - elapsed);
+    this->start_ticks = SDL_GetTicksNS();
+}
+
+void    Game_Timer_Sleep(Game_Timer *this) {
+    size_t  sleep_time;
+
+    this->rendering_ns = Game_Timer_GetTicksNS(this);
+    if (this->rendering_ns < this->ns_per_frame) {
+        sleep_time = this->ns_per_frame - this->rendering_ns;
+        SDL_DelayNS(sleep_time);
+        this->rendering_ns = Game_Timer_GetTicksNS(this);
+    }
+}
+
+ /*---------------------------------------------------*/
+bool    Game_Surface_LoadMedia(Game_Surface *this) {
+    if ((this->content = SDL_LoadBMP("../../sprites/room.bmp")) == NULL)
+        return (Game_Error_Failure(&this->error, GAME_SDL_ERROR));
+    Game_Memory_Add(GAME_MEMORY_SURFACES, Game_Memory_SurfaceBytes(this->content));
+    return (true);
+}
+
+void    Game_Surface_Destroy(Game_Surface *this) {
+    Game_Memory_Add(GAME_MEMORY_SURFACES, -(Sint64)Game_Memory_SurfaceBytes(this->content));
+    SDL_DestroySurface(this->content);
+    this->content = NULL;
+}
+
+void    Game_Window_Destroy(Game_Window *this) {
+    Game_Memory_Add(GAME_MEMORY_TEXTURES, -(Sint64)Game_Memory_TextureBytes(this->target));
+    Game_Memory_Add(GAME_MEMORY_SURFACES, -(Sint64)Game_Memory_SurfaceBytes(this->surface));
+    SDL_DestroyTexture(this->target);
+    this->target = NULL;
+    SDL_DestroyRenderer(this->renderer);
+    SDL_DestroyWindow(this->content);
+    SDL_DestroySurface(this->surface);
+    this->content = NULL;
+    this->renderer = NULL;
+    this->surface = NULL;
+}
+
+void    Game_Texture_Destroy(Game_Texture *this) {
+    Game_Memory_Add(GAME_MEMORY_TEXTURES, -(Sint64)Game_Memory_TextureBytes(this->content));
+    SDL_DestroyTexture(this->content);
+    this->content = NULL;
+    Game_Collision_Mask_Destroy(&this->mask);
+    Game_Mip_Chain_Destroy(&this->mips);
+}
+
+void    Game_Texture_Array_Destroy(Game_Texture_Array *this, size_t index) {
+    for (size_t local_index = 0; local_index < index; local_index++)
+        Game_Texture_Destroy(&this->content[local_index]);
+}
+
+/* Everything is released before the accounting is dumped, so what it still holds leaked. */
+void    Game_Quit(Game *this) {
+    Game_Texture_Array_Destroy(&this->textures, this->textures.capacity);
+    Game_Texture_Destroy(&this->player.texture);
+    Game_Texture_Destroy(&this->floor.texture);
+    Game_Sprite_Array_Destroy(&this->sprites);
+    Game_Animation_Library_Destroy(&this->animations);
+    Game_Particle_Pool_Destroy(&this->particles);
+    Game_Render_List_Destroy(&this->render_list);
+    Game_Flow_Field_Destroy(&this->flow);
+    Game_Timer_Wheel_Destroy(&this->timers);
+    Game_Snapshot_Destroy(&this->quicksave);
+    Game_Startup_Destroy(&this->startup);
+    Game_Jobs_Destroy(&this->jobs);
+    Game_Audio_Destroy(&this->audio);
+    Game_Hud_Destroy(&this->hud);
+    Game_Capture_Close(&this->capture);
+    if (this->capture.frames != 0)
+        Game_Capture_Print(&this->capture, stderr);
+    if (this->idle.periods != 0)
+        Game_Idle_Print(&this->idle, stderr);
+    Game_Window_Destroy(&this->window);
+    SDL_Quit();
+    Game_Memory_Add(GAME_MEMORY_STRUCTS, -(Sint64)sizeof(Game));
+    Game_Memory_Print(stderr);
+    Game_Memory_PrintLeaks(stderr);
+}
+
+/*void    Game_Texture_UpdateRectangle(Game_Texture *this, float x, float y) {
+    this->rectangle = (SDL_FRect){x, y, (float)this->size.width, (float)this->size.height};
+}
+
+void    Game_Render_Texture(Game_Texture *this, Game_Window *window, float x, float y) {
+    Game_Texture_UpdateRectangle(this, x, y);
+    SDL_RenderTexture(window->renderer, this->content, NULL, &this->rectangle);
+}
+
+void    Game_Texture_Array_Render(Game_Texture_Array *this, Game_Window *window) {
+    for (size_t index = 0; index < this->capacity; index++)
+        Game_Render_Texture(&this->content[index], window, 200.f, 200.f);
+}
+*/
+
+void    Game_Texture_UpdateRectangle(Game_Texture *this, Coordinates coordinates) {
+    this->rectangle = (SDL_FRect){coordinates.x, coordinates.y, (float)this->size.width, (float)this->size.height};
+}
+
+/*
+** The mip level to draw at `scale` screen pixels per texel, with `source`
+** (full-size texels) moved onto it.
+*/
+static SDL_Texture  *Game_Texture_SelectLevel(const Game_Texture *this, float scale, SDL_FRect *source) {
+    size_t  level;
+    float   factor;
+
+    if ((level = Game_Mip_Chain_Select(&this->mips, scale)) == 0)
+        return (this->content);
+    factor = 1.f / (float)(1u << level);
+    *source = (SDL_FRect){source->x * factor, source->y * factor, source->w * factor, source->h * factor};
+    return (this->mips.levels[level - 1]);
+}
+
+void    Game_Texture_Render(Game_Texture *this, Coordinates coordinates, Game_Window *window) {
+    SDL_FRect   source;
+
+    source = (SDL_FRect){0, 0, (float)this->size.width, (float)this->size.height};
+    Game_Texture_RenderSource(this, &source, coordinates, window);
+}
+
+/* Draws one frame of a sprite sheet, at the frame's own size. */
+void    Game_Texture_RenderSource(Game_Texture *this, const SDL_FRect *source, Coordinates coordinates, Game_Window *window) {
+    SDL_Texture *texture;
+    SDL_FRect   level;
+
+    this->rectangle = (SDL_FRect){coordinates.x, coordinates.y, source->w, source->h};
+    level = *source;
+    texture = Game_Texture_SelectLevel(this, window->render_scale * window->zoom, &level);
+    SDL_RenderTexture(window->renderer, texture, &level, &this->rectangle);
+    window->draw_calls++;
+    window->fill_pixels += (Uint64)(source->w * source->h * window->render_scale * window->render_scale * window->zoom * window->zoom);
+    window->fill_texels += (Uint64)(level.w * level.h);
+}
+
+void    Game_Sprite_Array_Init(Game_Sprite_Array *this) {
+    this->content = NULL;
+    this->sources = NULL;
+    this->animations = NULL;
+    this->length = 0;
+    this->capacity = 0;
+}
+
+bool    Game_Sprite_Array_Reserve(Game_Sprite_Array *this, size_t capacity) {
+    Game_Sprite *content;
+    SDL_FRect   *sources;
+    Game_Animation_State    *animations;
+
+    if (capacity <= this->capacity)
+        return (true);
+    if ((content = realloc(this->content, sizeof(Game_Sprite) * capacity)) == NULL)
+        return (false);
+    this->content = content;
+    if ((sources = realloc(this->sources, sizeof(SDL_FRect) * capacity)) == NULL)
+        return (false);
+    this->sources = sources;
+    if ((animations = realloc(this->animations, sizeof(Game_Animation_State) * capacity)) == NULL)
+        return (false);
+    this->animations = animations;
+    Game_Memory_Add(GAME_MEMORY_ENTITIES, (Sint64)((capacity - this->capacity) * GAME_SPRITE_BYTES));
+    this->capacity = capacity;
+    return (true);
+}
+
+bool    Game_Sprite_Array_PushAnimated(Game_Sprite_Array *this, Game_Sprite sprite, Game_Animation_State animation) {
+    if (this->length == this->capacity
+        && Game_Sprite_Array_Reserve(this, this->capacity ? this->capacity * 2 : 16) == false)
+        return (false);
+    this->sources[this->length] = (SDL_FRect){0, 0, (float)sprite.texture->size.width, (float)sprite.texture->size.height};
+    this->animations[this->length] = animation;
+    this->content[this->length++] = sprite;
+    return (true);
+}
+
+bool    Game_Sprite_Array_Push(Game_Sprite_Array *this, Game_Sprite sprite) {
+    return (Game_Sprite_Array_PushAnimated(this, sprite, Game_Animation_State_Create(-1, 0)));
+}
+
+/* Fixed step per frame, bouncing on the window edges. */
+void    Game_Sprite_Array_Update(Game_Sprite_Array *this) {
+    Game_Sprite *sprite;
+    float   max_x;
+    float   max_y;
+
+    for (size_t index = 0; index < this->length; index++) {
+        sprite = &this->content[index];
+        max_x = (float)(WINDOW_WIDTH - sprite->texture->size.width);
+        max_y = (float)(WINDOW_HEIGHT - sprite->texture->size.height);
+        sprite->coordinates.x += sprite->velocity.x;
+        sprite->coordinates.y += sprite->velocity.y;
+        if (sprite->coordinates.x < 0 || sprite->coordinates.x > max_x) {
+            sprite->velocity.x = -sprite->velocity.x;
+            sprite->coordinates.x = SDL_clamp(sprite->coordinates.x, 0, max_x);
+        }
+        if (sprite->coordinates.y < 0 || sprite->coordinates.y > max_y) {
+            sprite->velocity.y = -sprite->velocity.y;
+            sprite->coordinates.y = SDL_clamp(sprite->coordinates.y, 0, max_y);
+        }
+    }
+}
+
+void    Game_Sprite_Array_Animate(Game_Sprite_Array *this, const Game_Animation_Library *library, Uint32 delta_us) {
+    if (library->clip_count != 0)
+        Game_Animation_Advance(library, this->animations, this->sources, this->length, delta_us);
+}
+
+typedef struct Game_Sprite_Build {
+    Game_Sprite_Array   *sprites;
+    Game_Render_List    *list;
+    const Game_Camera_View  *view;
+}   Game_Sprite_Build;
+
+static void Game_Sprite_Array_BuildTask(void *context, size_t task, size_t worker) {
+    Game_Sprite_Build   *build;
+    Game_Sprite *sprite;
+    SDL_FRect   *source;
+    SDL_FRect   level;
+    SDL_FRect   destination;
+    SDL_Texture *texture;
+    size_t  end;
+
+    build = context;
+    end = SDL_min((task + 1) * GAME_SPRITE_BUILD_CHUNK, build->sprites->length);
+    for (size_t index = task * GAME_SPRITE_BUILD_CHUNK; index < end; index++) {
+        sprite = &build->sprites->content[index];
+        source = &build->sprites->sources[index];
+        if (Game_Camera_View_IsVisible(build->view, sprite->coordinates.x, sprite->coordinates.y, source->w, source->h) == false)
+            continue ;
+        destination = (SDL_FRect){sprite->coordinates.x + build->view->offset_x, sprite->coordinates.y + build->view->offset_y,
+            source->w, source->h};
+        level = *source;
+        texture = Game_Texture_SelectLevel(sprite->texture, build->view->scale, &level);
+        Game_Render_List_Push(build->list, worker, Game_Render_Key(GAME_LAYER_SPRITES, sprite->texture->id,
+            sprite->coordinates.y + source->h, index), texture, &level, &destination);
+    }
+}
+
+/*
+** Culls and encodes the sprites in GAME_SPRITE_BUILD_CHUNK ranges spread
+** over the job workers; each worker writes its own render-list bucket.
+*/
+void    Game_Sprite_Array_Build(Game_Sprite_Array *this, Game_Render_List *list, Game_Jobs *jobs, const Game_Camera_View *view) {
+    Game_Sprite_Build   build;
+
+    build = (Game_Sprite_Build){this, list, view};
+    Game_Jobs_Run(jobs, Game_Sprite_Array_BuildTask, &build, (this->length + GAME_SPRITE_BUILD_CHUNK - 1) / GAME_SPRITE_BUILD_CHUNK);
+}
+
+void    Game_Sprite_Array_Destroy(Game_Sprite_Array *this) {
+    Game_Memory_Add(GAME_MEMORY_ENTITIES, -(Sint64)(this->capacity * GAME_SPRITE_BYTES));
+    free(this->content);
+    free(this->sources);
+    free(this->animations);
+    Game_Sprite_Array_Init(this);
+}
+
+/* Single whole-texture draws (floor, player) go through the list on worker 0. */
+static void Game_PushTexture(Game_Render_List *list, Game_Render_Layer layer, Game_Texture *texture, Coordinates coordinates, const Game_Camera_View *view) {
+    SDL_FRect   source;
+    SDL_FRect   destination;
+    Uint64  key;
+
+    source = (SDL_FRect){0, 0, (float)texture->size.width, (float)texture->size.height};
+    if (Game_Texture_IsLoaded(texture) == false
+        || Game_Camera_View_IsVisible(view, coordinates.x, coordinates.y, source.w, source.h) == false)
+        return ;
+    destination = (SDL_FRect){coordinates.x + view->offset_x, coordinates.y + view->offset_y, source.w, source.h};
+    key = Game_Render_Key(layer, texture->id, coordinates.y + source.h, 0);
+    Game_Render_List_Push(list, 0, key, Game_Texture_SelectLevel(texture, view->scale, &source), &source, &destination);
+}
+
+/*
+** Build (parallel), sort and merge the frame's render list, then submit it
+** with the particle batch slotted in between the sprite and player layers.
+*/
+void    Game_Render(Game *this, Game_Frame_State *state) {
+    Game_Camera_View    view;
+    float   pixels;
+
+    view = Game_Camera_GetView(&state->camera, this->window.render_scale, (float)this->quality.culling_margin);
+    Game_Render_List_Begin(&this->render_list, Game_Jobs_GetWorkerCount(&this->jobs));
+    Game_PushTexture(&this->render_list, GAME_LAYER_FLOOR, &this->floor.texture, this->floor.coordinates, &view);
+    Game_PushTexture(&this->render_list, GAME_LAYER_PLAYER, &this->player.texture, state->player, &view);
+    Game_Sprite_Array_Build(&state->sprites, &this->render_list, &this->jobs, &view);
+    Game_Render_List_Sort(&this->render_list, &this->jobs);
+    Game_Window_BeginFrame(&this->window, view.zoom);
+    SDL_SetRenderDrawColor(this->window.renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    SDL_RenderClear(this->window.renderer);
+    Game_Render_List_Submit(&this->render_list, this->window.renderer, GAME_LAYER_SPRITES);
+    if (Game_Particle_Pool_Render(&state->particles, this->window.renderer, &view) && state->particles.rendered != 0) {
+        pixels = state->particles.size * this->window.render_scale * view.zoom;
+        this->window.draw_calls++;
+        this->window.fill_pixels += (Uint64)((float)state->particles.rendered * pixels * pixels);
+    }
+    Game_Render_List_Submit(&this->render_list, this->window.renderer, GAME_LAYER_OVERLAY);
+    pixels = this->window.render_scale * view.zoom;
+    this->window.draw_calls += this->render_list.draw_calls;
+    this->window.fill_pixels += (Uint64)(this->render_list.area * pixels * pixels);
+    this->window.fill_texels += (Uint64)this->render_list.texels;
+    Game_Window_EndFrame(&this->window);
+    if (this->hud.visible && Game_Hud_Render(&this->hud, this->window.renderer, &(Game_Hud_Counters){this->window.draw_calls,
+        state->sprites.length, state->particles.length, Game_Memory_GetTotal(), Game_Memory_GetTotalPeak()}))
+        this->window.draw_calls++;
+    Game_Capture_Frame(&this->capture, this->window.renderer);
+    if (this->adaptive.enabled)
+        SDL_FlushRenderer(this->window.renderer);
+    this->frame_cost_ns = SDL_GetTicksNS() - this->frame_start_ns;
+    SDL_RenderPresent(this->window.renderer);
+}
+
+void    Game_Update(Game *this) {
+    Game_Frame_State    state;
+
+    state.sprites = this->sprites;
+    state.particles = this->particles;
+    state.camera = this->camera;
+    state.player = this->player.coordinates;
+    state.input_ns = this->frame_start_ns;
+    Game_Render(this, &state);
+}
+/*-----------------------------------------------------------*/
+
+void    Game_Player_MoveRight(Game_Player *this) {
+    this->coordinates.x += this->speed;
+}
+
+void    Game_Player_MoveLeft(Game_Player *this) {
+    this->coordinates.x -= this->speed;
+}
+
+void    Game_Player_MoveUp(Game_Player *this) {
+    this->coordinates.y -= this->speed;
+}
+
+void    Game_Player_MoveDown(Game_Player *this) {
+    this->coordinates.y += this->speed;
+}
+
+void    Game_Player_SlideRight(Game_Player *this) {
+    this->coordinates.x += this->speed / 2;
+}
+
+void    Game_Player_SlideLeft(Game_Player *this) {
+    this->coordinates.x -= this->speed / 2;
+}
+
+void    Game_Player_SlideUp(Game_Player *this) {
+    this->coordinates.y -= this->speed / 2;
+}
+
+void    Game_Player_SlideDown(Game_Player *this) {
+    this->coordinates.y += this->speed / 2;
+}
+
+ /*----------------------------------------------------------*/
+
+#define GAME_COMMAND_MOVE(entity, dx, dy) \
+    do { \
+        (entity)->coordinates.x += (dx) * (entity)->speed; \
+        (entity)->coordinates.y += (dy) * (entity)->speed; \
+    } while (0)
+
+#define GAME_COMMAND_CASE(tag, input, dx, dy) \
+    case GAME_COMMAND_##tag: \
+        GAME_COMMAND_MOVE(entity, dx, dy); \
+        break ;
+
+#define GAME_COMMAND_INPUT(tag, input, dx, dy) \
+    if (buttons & (input)) \
+        GAME_COMMAND_MOVE(entity, dx, dy);
+
+#define GAME_COMMAND_BULK(tag, input, dx, dy) \
+    case GAME_COMMAND_##tag: \
+        for (size_t index = 0; index < count; index++) \
+            GAME_COMMAND_MOVE(&entities[index], dx, dy); \
+        break ;
+
+/* A switch over a dense tag compiles to one jump table, with each move inlined. */
+void    Game_Command_Execute(Game_Command_Type type, Game_Player *entity) {
+    switch (type) {
+        GAME_COMMAND_LIST(GAME_COMMAND_CASE)
+        default:
+            break ;
+    }
+}
+
+/* Every command whose input bit is set, in GAME_COMMAND_LIST order. */
+void    Game_Command_ExecuteInput(Uint32 buttons, Game_Player *entity) {
+    GAME_COMMAND_LIST(GAME_COMMAND_INPUT)
+}
+
+void    Game_Command_ExecuteBatch(const Game_Command *commands, size_t count, Game_Player *entities) {
+    for (size_t index = 0; index < count; index++)
+        Game_Command_Execute((Game_Command_Type)commands[index].type, &entities[commands[index].entity]);
+}
+
+/* One command for a whole entity array: dispatched once, then a plain loop per case. */
+void    Game_Command_ExecuteBulk(Game_Command_Type type, Game_Player *entities, size_t count) {
+    switch (type) {
+        GAME_COMMAND_LIST(GAME_COMMAND_BULK)
+        default:
+            break ;
+    }
+}
+
+void    Game_Command_Handler_Init(Game_Command_Handler *this, Game_Player *target) {
+    this->target = target;
+    this->window = NULL;
+    this->camera = NULL;
+    this->hud = NULL;
+    this->game = NULL;
+}
+
+void    Game_Command_Handler_HandleWindowKey(Game_Command_Handler *this, SDL_Keycode key) {
+    if (this->window == NULL)
+        return ;
+    if (key == SDLK_PAGEUP)
+        Game_Window_SetRenderScale(this->window, this->window->render_scale + RENDER_SCALE_STEP);
+    else if (key == SDLK_PAGEDOWN)
+        Game_Window_SetRenderScale(this->window, this->window->render_scale - RENDER_SCALE_STEP);
+    else if (key == SDLK_F2)
+        Game_Window_SetScaleMode(this->window,
+            this->window->scale_mode == SDL_SCALEMODE_LINEAR ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+}
+
+static void Game_Command_Handler_HandleGameKey(Game_Command_Handler *this, SDL_Keycode key) {
+    if (this->game == NULL)
+        return ;
+    if (key == SDLK_F5)
+        Game_QuickSave(this->game);
+    else if (key == SDLK_F9)
+        Game_QuickLoad(this->game);
+}
+
+/*
+** The overlay is drawn on the thread that polls events, so it is toggled
+** there in every loop; the memory counters take their own lock and print
+** from any.
+*/
+void    Game_Command_Handler_HandleOverlayKey(Game_Command_Handler *this, SDL_Keycode key) {
+    if (key == SDLK_F3)
+        Game_Memory_Print(stderr);
+    else if (key == SDLK_F1 && this->hud != NULL)
+        Game_Hud_Toggle(this->hud);
+}
+
+static void Game_Command_Handler_HandleCameraKey(Game_Command_Handler *this, SDL_Keycode key) {
+    if (this->camera == NULL)
+        return ;
+    if (key == SDLK_EQUALS)
+        Game_Camera_SetZoom(this->camera, this->camera->zoom * GAME_CAMERA_ZOOM_STEP);
+    else if (key == SDLK_MINUS)
+        Game_Camera_SetZoom(this->camera, this->camera->zoom / GAME_CAMERA_ZOOM_STEP);
+}
+
+void    Game_Command_Handler_HandleInput(Game_Command_Handler *this, SDL_Event event, bool *running) {
+    const bool  *key_state;
+    Uint32  buttons;
+    
+    if (event.type == SDL_EVENT_QUIT) {
+        *running = false;
+        return ;
+    }
+    if (this->game != NULL && Game_Idle_HandleEvent(&this->game->idle, &event))
+        return ;
+    if (event.type == SDL_EVENT_KEY_DOWN) {
+        if (event.key.key == SDLK_ESCAPE) {
+            *running = false;
+            return ;
+        }
+        Game_Command_Handler_HandleWindowKey(this, event.key.key);
+        Game_Command_Handler_HandleCameraKey(this, event.key.key);
+        Game_Command_Handler_HandleOverlayKey(this, event.key.key);
+        Game_Command_Handler_HandleGameKey(this, event.key.key);
+    }
+    key_state = SDL_GetKeyboardState(NULL);
+    buttons = (key_state[SDL_SCANCODE_UP] ? GAME_INPUT_UP : 0) | (key_state[SDL_SCANCODE_DOWN] ? GAME_INPUT_DOWN : 0)
+        | (key_state[SDL_SCANCODE_LEFT] ? GAME_INPUT_LEFT : 0) | (key_state[SDL_SCANCODE_RIGHT] ? GAME_INPUT_RIGHT : 0);
+    if (this->game != NULL && this->target == &this->game->player)
+        Game_MovePlayer(this->game, buttons);
+    else
+        Game_Command_ExecuteInput(buttons, this->target);
+}
+
+void    Game_HandleEvents(Game_Command_Handler *handler, SDL_Event event, bool *running) {
+    while (SDL_PollEvent(&event) == true)
+            Game_Command_Handler_HandleInput(handler, event, running);
+}
+
+/*
+** While idle nothing reaches the simulation: quitting, the idle events
+** themselves, window keys and the overlay still act, and the last two redraw
+** the paused frame to show it.
+*/
+static void Game_HandleIdleEvent(Game *this, Game_Command_Handler *handler, const SDL_Event *event, bool *running) {
+    if (event->type == SDL_EVENT_QUIT || (event->type == SDL_EVENT_KEY_DOWN && event->key.key == SDLK_ESCAPE))
+        *running = false;
+    else if (Game_Idle_HandleEvent(&this->idle, event) == false && event->type == SDL_EVENT_KEY_DOWN) {
+        Game_Command_Handler_HandleWindowKey(handler, event->key.key);
+        Game_Command_Handler_HandleOverlayKey(handler, event->key.key);
+        Game_Idle_RequestRedraw(&this->idle);
+    }
+}
+
+/*
+** Paused, minimised or unfocused: the frame timer and the audio device stop
+** and the thread sleeps in SDL_WaitEventTimeout until an event or the next
+** scheduled wake. No step is simulated; `state` (NULL for the live game
+** state) is drawn again only when a redraw is due, never while minimised,
+** and such a redraw counts towards the frame limit. Returns once the game is
+** active again or quitting.
+*/
+void    Game_WaitWhileIdle(Game *this, Game_Command_Handler *handler, Game_Frame_State *state, bool *running) {
+    SDL_Event   event;
+
+    Game_Timer_Pause(&this->timer);
+    Game_Audio_SetPaused(&this->audio, true);
+    while (*running && Game_Idle_IsIdle(&this->idle)) {
+        if (Game_Idle_Wait(&this->idle, &event)) {
+            Game_HandleIdleEvent(this, handler, &event, running);
+            while (SDL_PollEvent(&event) == true)
+                Game_HandleIdleEvent(this, handler, &event, running);
+        }
+        if (*running && Game_Idle_TakeRedraw(&this->idle)) {
+            this->frame_start_ns = SDL_GetTicksNS();
+            if (state != NULL)
+                Game_Render(this, state);
+            else
+                Game_Update(this);
+            if (this->frame_limit != 0 && ++this->frame >= this->frame_limit)
+                *running = false;
+        }
+    }
+    Game_Audio_SetPaused(&this->audio, false);
+    Game_Timer_Unpause(&this->timer);
+}
+
+/*--------------------------------------------------------------------------*/
+
+/*
+** Dust puffs from the player's feet on every frame the player moved; the
+** stress scene also tops the pool up to `particle_fountain` live particles.
+*/
+void    Game_UpdateParticles(Game *this) {
+    if (this->player.coordinates.x != this->player_previous.x || this->player.coordinates.y != this->player_previous.y)
+        Game_Particle_Pool_Emit(&this->particles, this->player.coordinates.x + this->player.texture.size.width / 2.f,
+            this->player.coordinates.y + (float)this->player.texture.size.height, GAME_PARTICLE_DUST_BURST, &game_particle_dust);
+    this->player_previous = this->player.coordinates;
+    if (this->particle_fountain > this->particles.length)
+        Game_Particle_Pool_Emit(&this->particles, WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 2.f,
+            this->particle_fountain - this->particles.length, &game_particle_sparks);
+    Game_Particle_Pool_Update(&this->particles, 1.f / DEFAULT_FPS);
+}
+
+void    Game_UpdateCamera(Game *this) {
+    Game_Camera_Follow(&this->camera, this->player.coordinates.x + this->player.texture.size.width / 2.f,
+        this->player.coordinates.y + this->player.texture.size.height / 2.f, 1.f / DEFAULT_FPS);
+}
+
+/*
+** Boo sprites head down the flow field towards the player at
+** GAME_CHASE_SPEED and, once in the player's cell, straight at the player.
+** The field is only rebuilt when the player changes cell. The pipelined
+** loop simulates while the render thread owns the job workers, so it
+** rebuilds on this thread alone.
+*/
+void    Game_ChasePlayer(Game *this) {
+    const Game_Texture  *boo;
+    Game_Sprite *sprite;
+    Game_Flow_Direction direction;
+    float   target_x;
+    float   target_y;
+    float   dx;
+    float   dy;
+    float   length;
+
+    target_x = this->player.coordinates.x + this->player.texture.size.width / 2.f;
+    target_y = this->player.coordinates.y + this->player.texture.size.height / 2.f;
+    Game_Flow_Field_SetGoal(&this->flow, target_x, target_y, this->pipelined ? NULL : &this->jobs);
+    boo = &this->textures.content[BOO];
+    for (size_t index = 0; index < this->sprites.length; index++) {
+        sprite = &this->sprites.content[index];
+        if (sprite->texture != boo)
+            continue ;
+        dx = sprite->coordinates.x + boo->size.width / 2.f;
+        dy = sprite->coordinates.y + boo->size.height / 2.f;
+        if ((direction = Game_Flow_Field_Sample(&this->flow, dx, dy)) != GAME_FLOW_NONE) {
+            sprite->velocity = (Coordinates){game_flow_vectors[direction][0] * GAME_CHASE_SPEED,
+                game_flow_vectors[direction][1] * GAME_CHASE_SPEED};
+            continue ;
+        }
+        dx = target_x - dx;
+        dy = target_y - dy;
+        length = SDL_sqrtf(dx * dx + dy * dy);
+        sprite->velocity = length > GAME_CHASE_SPEED ? (Coordinates){dx / length * GAME_CHASE_SPEED, dy / length * GAME_CHASE_SPEED}
+            : (Coordinates){dx, dy};
+    }
+}
+
+/*
+** Before the device is open a sound is only noted, the last one asked for
+** winning: the simulation can run on its own thread, and the device is
+** opened on the main thread by Game_StartAudio.
+*/
+static void Game_PlayBlip(Game *this, float volume, float pitch) {
+    if (this->audio_started) {
+        Game_Audio_Play(&this->audio, this->blip, volume, 0.f, pitch, false);
+        return ;
+    }
+    this->pending_volume = volume;
+    this->pending_pitch = pitch;
+}
+
+/*
+** Main thread only, while the simulation is parked. The audio subsystem and
+** device open with the first sound rather than at startup, off the path to
+** the first frame, and play it; a device that fails to open leaves the game
+** silent and is not retried.
+*/
+void    Game_StartAudio(Game *this) {
+    if (this->audio_started || this->pending_pitch <= 0.f)
+        return ;
+    this->audio_started = true;
+    if (Game_Audio_Init(&this->audio) == false || Game_Audio_Open(&this->audio) == false)
+        SDL_Log("audio: running silent: %s", SDL_GetError());
+    this->blip = Game_Audio_CreateTone(&this->audio, 880.f, 0.08f);
+    Game_Audio_Play(&this->audio, this->blip, this->pending_volume, 0.f, this->pending_pitch, false);
+    this->pending_pitch = 0.f;
+}
+
+static void Game_EndContactCooldown(void *context, Uint64 data) {
+    (void)data;
+    ((Game *)context)->contact_cooldown = GAME_TIMER_NONE;
+}
+
+/*
+** Boo sprites touching the player, to the pixel, turn back before they
+** move; a contact sounds at most once every GAME_CONTACT_COOLDOWN ticks.
+** The box test inside Game_Collision_Test rejects almost every boo; the
+** few left only compare the rows where the two sprites overlap.
+*/
+void    Game_CollidePlayer(Game *this) {
+    const Game_Texture  *boo;
+    Game_Collision_Shape    player;
+    Game_Collision_Shape    shape;
+    Game_Sprite *sprite;
+
+    boo = &this->textures.content[BOO];
+    player = Game_Collision_Shape_Make(&this->player.texture.mask, NULL, this->player.coordinates.x, this->player.coordinates.y);
+    for (size_t index = 0; index < this->sprites.length; index++) {
+        sprite = &this->sprites.content[index];
+        if (sprite->texture != boo)
+            continue ;
+        shape = Game_Collision_Shape_Make(&boo->mask, &this->sprites.sources[index], sprite->coordinates.x, sprite->coordinates.y);
+        if (Game_Collision_Test(&player, &shape)) {
+            sprite->velocity = (Coordinates){-sprite->velocity.x, -sprite->velocity.y};
+            this->contacts++;
+            if (this->contact_cooldown == GAME_TIMER_NONE) {
+                Game_PlayBlip(this, 0.25f, 1.5f);
+                this->contact_cooldown = Game_Timer_Wheel_Schedule(&this->timers, GAME_CONTACT_COOLDOWN,
+                    Game_EndContactCooldown, this, 0);
+            }
+        }
+    }
+}
+
+/* F5: snapshot the simulation into memory and GAME_QUICKSAVE_PATH. */
+bool    Game_QuickSave(Game *this) {
+    Uint64  start;
+
+    start = SDL_GetTicksNS();
+    if (Game_Snapshot_Capture(&this->quicksave, this) == false || Game_Snapshot_SaveFile(&this->quicksave, GAME_QUICKSAVE_PATH) == false) {
+        SDL_Log("quick-save: %s", SDL_GetError());
+        return (false);
+    }
+    SDL_LogVerbose(SDL_LOG_CATEGORY_APPLICATION, "quick-save: %zu bytes in %.3f ms",
+        this->quicksave.length, (double)(SDL_GetTicksNS() - start) / 1e6);
+    Game_PlayBlip(this, 0.5f, 1.f);
+    return (true);
+}
+
+/* F9: back to the last quick-save, falling back to the file from a previous run. */
+bool    Game_QuickLoad(Game *this) {
+    if (this->quicksave.length == 0)
+        return (Game_RestoreFile(this, GAME_QUICKSAVE_PATH));
+    if (Game_Snapshot_Restore(&this->quicksave, this) == false) {
+        SDL_Log("quick-load: snapshot rejected");
+        return (false);
+    }
+    Game_PlayBlip(this, 0.5f, 0.75f);
+    return (true);
+}
+
+bool    Game_RestoreFile(Game *this, const char *path) {
+    if (Game_Snapshot_LoadFile(&this->quicksave, path) == false) {
+        SDL_Log("restore %s: %s", path, SDL_GetError());
+        return (false);
+    }
+    if (Game_Snapshot_Restore(&this->quicksave, this) == false) {
+        SDL_Log("restore %s: not a compatible snapshot for this scene", path);
+        this->quicksave.length = 0;
+        return (false);
+    }
+    return (true);
+}
+
+/* The player script when one is loaded, the GAME_COMMAND_LIST moves otherwise. */
+void    Game_MovePlayer(Game *this, Uint32 buttons) {
+    static const Game_Script_Binding    binding = GAME_PLAYER_SCRIPT_BINDING;
+
+    if (this->player_script.length != 0)
+        Game_Script_Run(&this->player_script, &binding, &this->player, 1, buttons);
+    else
+        Game_Command_ExecuteInput(buttons, &this->player);
+}
+
+/* One simulation step: everything between reading input and rendering. */
+void    Game_Simulate(Game *this) {
+    static const Game_Script_Binding    binding = GAME_SPRITE_SCRIPT_BINDING;
+
+    Game_Timer_Wheel_Advance(&this->timers, 1);
+    if (this->chase) {
+        Game_ChasePlayer(this);
+        Game_CollidePlayer(this);
+    }
+    if (this->sprite_script.length != 0 && this->sprites.length != 0
+        && Game_Script_Run(&this->sprite_script, &binding, this->sprites.content, this->sprites.length, 0) == 0) {
+        SDL_Log("sprite script: %s", SDL_GetError());
+        Game_Script_Init(&this->sprite_script);
+    }
+    Game_Sprite_Array_Update(&this->sprites);
+    Game_Sprite_Array_Animate(&this->sprites, &this->animations, GAME_ANIMATION_FRAME_US);
+    Game_UpdateParticles(this);
+    Game_UpdateCamera(this);
+}
+
+void    Game_Loop(Game  *this) {
+    Game_Command_Handler    handler;
+    SDL_Event   event;
+    bool    running;
+
+    if (this->pipelined && Game_Pipeline_Loop(this))
+        return ;
+    SDL_zero(event);
+    running = true;
+    Game_Command_Handler_Init(&handler, &this->player);
+    handler.window = &this->window;
+    handler.camera = &this->camera;
+    handler.hud = &this->hud;
+    handler.game = this;
+    Game_Timer_Start(&this->timer);
+    while (running) {
+        this->frame_start_ns = SDL_GetTicksNS();
+        Game_HandleEvents(&handler, event, &running);
+        if (running && Game_Idle_IsIdle(&this->idle)) {
+            Game_WaitWhileIdle(this, &handler, NULL, &running);
+            continue ;
+        }
+        Game_Simulate(this);
+        Game_StartAudio(this);
+        Game_Update(this);
+        if (this->stats != NULL)
+            Game_Frame_Stats_RecordLatency(this->stats, SDL_GetTicksNS() - this->frame_start_ns);
+        if (Game_Adaptive_Record(&this->adaptive, this->frame_cost_ns))
+            Game_ApplyAdaptiveLevel(this);
+        Game_Timer_Sync(&this->timer);
+        if (this->stats != NULL)
+            Game_Frame_Stats_Record(this->stats, SDL_GetTicksNS() - this->frame_start_ns,
+                this->window.draw_calls, this->window.fill_pixels, this->window.fill_texels);
+        if (this->frame_limit != 0 && ++this->frame >= this->frame_limit)
+            running = false;
+    }
+}
+
+bool    Game_Texture_LoadFromFile(Game_Texture *this, Game_Window *window, const char *path) {
+    SDL_Surface *loaded_surface;
+    bool    loaded;
+
+    if ((loaded_surface = Game_Bmp_Load(path)) == NULL)
+        return (Game_Error_Failure(&this->error, GAME_SDL_ERROR));
+    Game_Memory_Add(GAME_MEMORY_SURFACES, Game_Memory_SurfaceBytes(loaded_surface));
+    loaded = Game_Texture_LoadFromSurface(this, window, loaded_surface);
+    Game_Memory_Add(GAME_MEMORY_SURFACES, -(Sint64)Game_Memory_SurfaceBytes(loaded_surface));
+    SDL_DestroySurface(loaded_surface);
+    return (loaded);
+}
+
+/* The surface stays the caller's. */
+bool    Game_Texture_LoadFromSurface(Game_Texture *this, Game_Window *window, SDL_Surface *surface) {
+    if ((this->content = SDL_CreateTextureFromSurface(window->renderer, surface)) == NULL)
+        return (Game_Error_Failure(&this->error, GAME_SDL_ERROR));
+    Game_Memory_Add(GAME_MEMORY_TEXTURES, Game_Memory_TextureBytes(this->content));
+    Size_Set(&this->size, surface->w, surface->h);
+    if (Game_Collision_Mask_Build(&this->mask, surface) == false)
+        SDL_Log("collision: %s collides as a box: %s", this->path != NULL ? this->path : "texture", SDL_GetError());
+    if (window->mipmaps && Game_Mip_Chain_Build(&this->mips, window->renderer, surface) == false)
+        SDL_Log("mips: %s is always drawn at full size: %s", this->path != NULL ? this->path : "texture", SDL_GetError());
+    if (++texture_serial == 0)
+        texture_serial = 1;
+    this->id = texture_serial;
+    return (true);
+}
+
+bool    Game_Texture_Array_LoadFromFile(Game_Texture_Array *this, Game_Window *window, Sprite_Code code) {
+    this->content[code].path = texture_path[code];
+    return (Game_Texture_LoadFromFile(&this->content[code], window, texture_path[code]));
+}
+
+/* Turns the images Game_Init queued into textures, waiting for their decoding if needed. */
+bool    Game_Texure_LoadFromFile(Game *this) {
+    if (Game_Startup_Upload(&this->startup, &this->window) == false)
+        return (Game_Error_Failure(&this->error, GAME_SDL_ERROR));
+    return (true);
+}
+
+bool    Game_Texture_IsLoaded(Game_Texture *this) {
+    return (this->content != NULL);
+}
@@ -0,0 +1,356 @@
+#ifndef GAME_H
+# define GAME_H
+
+# include "SDL_lib.h"
+# include "libstd.h"
+# include "game_error.h"
+# include "game_config.h"
+# include "game_stats.h"
+# include "game_adaptive.h"
+# include "game_animation.h"
+# include "game_camera.h"
+# include "game_particle.h"
+# include "game_jobs.h"
+# include "game_render_list.h"
+# include "game_snapshot.h"
+# include "game_startup.h"
+# include "game_memory.h"
+# include "game_bmp.h"
+# include "game_audio.h"
+# include "game_flow.h"
+# include "game_hud.h"
+# include "game_capture.h"
+# include "game_idle.h"
+# include "game_collision.h"
+# include "game_timer_wheel.h"
+# include "game_script.h"
+# include "game_mip.h"
+
+# define DEFAULT_FPS  60
+# define WINDOW_WIDTH 1920
+# define WINDOW_HEIGHT 1080
+# define RENDER_SCALE_MIN 0.25f
+# define RENDER_SCALE_STEP 0.125f
+# define GAME_ANIMATION_FRAME_US (1000000 / DEFAULT_FPS)
+# define GAME_PARTICLE_SIZE 3.f
+# define GAME_PARTICLE_DUST_BURST 6
+# define GAME_SPRITE_BUILD_CHUNK 4096
+# define GAME_CHASE_SPEED 3.f
+# define GAME_TIMER_CAPACITY 4096
+/* Simulation ticks between two contact sounds. */
+# define GAME_CONTACT_COOLDOWN 30
+# define GAME_SPRITE_BYTES (sizeof(Game_Sprite) + sizeof(SDL_FRect) + sizeof(Game_Animation_State))
+
+/* One bit per move command, for inputs that leave the thread that read them. */
+# define GAME_INPUT_UP 0x1u
+# define GAME_INPUT_DOWN 0x2u
+# define GAME_INPUT_LEFT 0x4u
+# define GAME_INPUT_RIGHT 0x8u
+
+# ifndef GAME_SPRITES_DIR
+#  define GAME_SPRITES_DIR "../../sprites/"
+# endif
+
+# define PATH_SPRITE_ROOM GAME_SPRITES_DIR "room.bmp"
+# define PATH_SPRITE_FLOOR GAME_SPRITES_DIR "floor.bmp"
+# define PATH_SPRITE_PLAYER GAME_SPRITES_DIR "player.bmp"
+# define PATH_SPRITE_BOO GAME_SPRITES_DIR "boo.bmp"
+
+# define TEXTURES_NUMBER SPRITE_NUMBER
+
+typedef enum  Sprite_Code {
+    FLOOR,
+    PLAYER,
+    BOO,
+    SPRITE_NUMBER,
+}   Sprite_Code;
+
+typedef struct Size {
+    size_t  width;
+    size_t  height;
+}   Size;
+
+typedef struct Coordinates {
+    float   x;
+    float   y;
+}   Coordinates;
+
+typedef struct Game_Timer {
+    size_t  screen_fps;
+    size_t  ns_per_frame;
+    size_t  rendering_ns;
+    size_t  start_ticks;
+    size_t  paused_ticks;
+    bool    is_paused;
+    bool    is_started;
+}   Game_Timer;
+
+typedef struct Game_Surface {
+    SDL_Surface *content;
+    Game_Error  error;
+}   Game_Surface;
+
+/*
+** `id` is a load-order serial, unique in the process; `code` names the
+** asset and stays the same from one run to the next, SPRITE_NUMBER if none.
+*/
+typedef struct Game_Texture {
+    SDL_Texture *content;
+    Uint16  id;
+    Sprite_Code code;
+    SDL_FRect   rectangle;
+    const char *path;
+    Game_Error  error;
+    Size    size;
+    Game_Collision_Mask mask;
+    Game_Mip_Chain  mips;
+}   Game_Texture;
+
+typedef struct Game_Player {
+    Game_Texture    texture;
+    Coordinates        coordinates;
+    float   speed;
+}   Game_Player;
+
+typedef struct Game_Floor {
+    Game_Texture    texture;
+    Coordinates coordinates;
+}   Game_Floor;
+
+typedef struct Game_Sprite {
+    Game_Texture    *texture;
+    Coordinates coordinates;
+    Coordinates velocity;
+}   Game_Sprite;
+
+/* What behaviour scripts see of a player and of a sprite: players have no velocity, sprites no speed. */
+# define GAME_PLAYER_SCRIPT_BINDING {sizeof(Game_Player), \
+    GAME_SCRIPT_FIELD_BIT(GAME_SCRIPT_X) | GAME_SCRIPT_FIELD_BIT(GAME_SCRIPT_Y) | GAME_SCRIPT_FIELD_BIT(GAME_SCRIPT_SPEED), \
+    {offsetof(Game_Player, coordinates.x), offsetof(Game_Player, coordinates.y), 0, 0, offsetof(Game_Player, speed)}}
+# define GAME_SPRITE_SCRIPT_BINDING {sizeof(Game_Sprite), \
+    GAME_SCRIPT_FIELD_BIT(GAME_SCRIPT_X) | GAME_SCRIPT_FIELD_BIT(GAME_SCRIPT_Y) \
+    | GAME_SCRIPT_FIELD_BIT(GAME_SCRIPT_VX) | GAME_SCRIPT_FIELD_BIT(GAME_SCRIPT_VY), \
+    {offsetof(Game_Sprite, coordinates.x), offsetof(Game_Sprite, coordinates.y), \
+    offsetof(Game_Sprite, velocity.x), offsetof(Game_Sprite, velocity.y), 0}}
+
+/*
+** sources and animations run parallel to content: the animation pass writes
+** every sprite's source rectangle in one sweep and the renderer reads them.
+*/
+typedef struct Game_Sprite_Array {
+    Game_Sprite *content;
+    SDL_FRect   *sources;
+    Game_Animation_State    *animations;
+    size_t  length;
+    size_t  capacity;
+}   Game_Sprite_Array;
+
+typedef struct Game_Texture_Array {
+    Game_Texture    content[TEXTURES_NUMBER];
+    size_t  capacity;
+}   Game_Texture_Array;
+
+typedef struct Game_Window {
+    bool    vsync_enabled;
+    SDL_Window  *content;
+    SDL_Renderer *renderer;
+    SDL_Surface *surface;
+    SDL_Texture *target;
+    float   render_scale;
+    float   zoom;
+    SDL_ScaleMode   scale_mode;
+    size_t  draw_calls;
+    Uint64  fill_pixels;
+    Uint64  fill_texels;
+    bool    mipmaps;
+}   Game_Window;
+
+/*
+** Everything one rendered frame reads. The serial loop points it at the live
+** game state; the pipelined loop draws from a private copy the simulation
+** thread filled (game_pipeline.c).
+*/
+typedef struct Game_Frame_State {
+    Game_Sprite_Array   sprites;
+    Game_Particle_Pool  particles;
+    Game_Camera camera;
+    Coordinates player;
+    Uint64  input_ns;
+}   Game_Frame_State;
+
+typedef struct Game {
+    Game_Window window;
+    Game_Timer timer;
+    Game_Texture_Array  textures;
+    Game_Player player;
+    Game_Floor  floor;
+    Game_Sprite_Array   sprites;
+    Game_Camera camera;
+    Game_Jobs   jobs;
+    Game_Render_List    render_list;
+    Game_Animation_Library  animations;
+    Game_Particle_Pool  particles;
+    size_t  particle_fountain;
+    Coordinates player_previous;
+    Game_Frame_Stats    *stats;
+    Game_Adaptive   adaptive;
+    Game_Quality    quality;
+    Uint64  frame_start_ns;
+    Uint64  frame_cost_ns;
+    size_t  frame;
+    size_t  frame_limit;
+    bool    pipelined;
+    Game_Snapshot   quicksave;
+    Game_Startup    startup;
+    Game_Audio  audio;
+    size_t  blip;
+    bool    audio_started;
+    float   pending_volume;
+    float   pending_pitch;
+    Game_Flow_Field flow;
+    bool    chase;
+    size_t  contacts;
+    Game_Timer_Wheel    timers;
+    Game_Timer_Handle   contact_cooldown;
+    Game_Hud    hud;
+    Game_Capture    capture;
+    Game_Idle   idle;
+    Game_Script player_script;
+    Game_Script sprite_script;
+    Game_Error error;
+}   Game;
+
+/*
+** X(tag, input bit, dx, dy): every command, as a step along the isometric
+** axes in multiples of the entity's speed. The enum and the dispatch switches
+** are generated from this list, so a new command is one line here.
+*/
+# define GAME_COMMAND_LIST(X) \
+    X(MOVE_UP, GAME_INPUT_UP, -1.f, -0.5f) \
+    X(MOVE_DOWN, GAME_INPUT_DOWN, 1.f, 0.5f) \
+    X(MOVE_LEFT, GAME_INPUT_LEFT, -1.f, 0.5f) \
+    X(MOVE_RIGHT, GAME_INPUT_RIGHT, 1.f, -0.5f)
+
+# define GAME_COMMAND_ENUM(tag, input, dx, dy) GAME_COMMAND_##tag,
+
+typedef enum Game_Command_Type {
+    GAME_COMMAND_LIST(GAME_COMMAND_ENUM)
+    GAME_COMMAND_TYPE_COUNT
+}   Game_Command_Type;
+
+/* A queued command: a tag and an entity index, no pointer, so it can be stored and replayed. */
+typedef struct Game_Command {
+    Uint32  entity;
+    Uint32  type;
+}   Game_Command;
+
+typedef struct Game_Command_Handler {
+    Game_Player *target;
+    Game_Window *window;
+    Game_Camera *camera;
+    Game_Hud    *hud;
+    struct Game *game;
+}   Game_Command_Handler;
+
+void    Size_Set(Size *this, size_t width, size_t height);
+void    Size_Init(Size *this);
+size_t  Size_GetWidth(Size *this);
+size_t  Size_GetHeight(Size *this);
+
+void    Coordinates_Init(Coordinates *this);
+float   Coordinates_Getx(Coordinates *this);
+float   Coordinates_Gety(Coordinates *this);
+void    Coordinates_Setx(Coordinates *this, float x);
+void    Coordinates_Sety(Coordinates *this, float y);
+
+void    Game_Timer_Init(Game_Timer *this);
+void    Game_Timer_SetFPS(Game_Timer *this, size_t fps);
+void    Game_Timer_Start(Game_Timer *this);
+void    Game_Timer_Stop(Game_Timer *this);
+void    Game_Timer_Pause(Game_Timer *this);
+void    Game_Timer_Unpause(Game_Timer *this);
+size_t  Game_Timer_GetTicksNS(Game_Timer *this);
+bool    Game_Timer_IsPaused(Game_Timer *this);
+bool    Game_Timer_IsStarted(Game_Timer *this);
+size_t  Game_Timer_Elapsed(Game_Timer *this);
+void    Game_Timer_Sync(Game_Timer *this);
+void    Game_Timer_Sleep(Game_Timer *this);
+
+void    Game_Texture_Init(Game_Texture *this);
+void    Game_Texture_Destroy(Game_Texture *this);
+void    Game_Texture_UpdateRectangle(Game_Texture *this, Coordinates coordinates);
+void    Game_Texture_Render(Game_Texture *this, Coordinates coordinates, Game_Window *window);
+void    Game_Texture_RenderSource(Game_Texture *this, const SDL_FRect *source, Coordinates coordinates, Game_Window *window);
+bool    Game_Texture_LoadFromFile(Game_Texture *this, Game_Window *window, const char *path);
+bool    Game_Texture_LoadFromSurface(Game_Texture *this, Game_Window *window, SDL_Surface *surface);
+bool    Game_Texture_IsLoaded(Game_Texture *this);
+
+void    Game_Texture_Array_Init(Game_Texture_Array *this);
+void    Game_Texture_Array_Destroy(Game_Texture_Array *this, size_t index);
+bool    Game_Texture_Array_LoadFromFile(Game_Texture_Array *this, Game_Window *window, Sprite_Code code);
+
+void    Game_Sprite_Array_Init(Game_Sprite_Array *this);
+bool    Game_Sprite_Array_Reserve(Game_Sprite_Array *this, size_t capacity);
+bool    Game_Sprite_Array_Push(Game_Sprite_Array *this, Game_Sprite sprite);
+bool    Game_Sprite_Array_PushAnimated(Game_Sprite_Array *this, Game_Sprite sprite, Game_Animation_State animation);
+void    Game_Sprite_Array_Update(Game_Sprite_Array *this);
+void    Game_Sprite_Array_Animate(Game_Sprite_Array *this, const Game_Animation_Library *library, Uint32 delta_us);
+void    Game_Sprite_Array_Build(Game_Sprite_Array *this, Game_Render_List *list, Game_Jobs *jobs, const Game_Camera_View *view);
+void    Game_Sprite_Array_Destroy(Game_Sprite_Array *this);
+
+void    Game_Surface_Init(Game_Surface  *this);
+bool    Game_Surface_LoadMedia(Game_Surface *this);
+void    Game_Surface_Destroy(Game_Surface *this);
+
+void    Game_Window_Init(Game_Window *this);
+bool    Game_Window_InitOffscreen(Game_Window *this, int width, int height);
+bool    Game_Window_SetVSync(Game_Window *this, int vsync);
+bool    Game_Window_SetRenderScale(Game_Window *this, float scale);
+void    Game_Window_SetScaleMode(Game_Window *this, SDL_ScaleMode scale_mode);
+void    Game_Window_BeginFrame(Game_Window *this, float zoom);
+void    Game_Window_EndFrame(Game_Window *this);
+void    Game_Window_PresentBlank(Game_Window *this);
+void    Game_Window_Destroy(Game_Window *this);
+
+void    Game_Player_Init(Game_Player *this);
+void    Game_Player_MoveRight(Game_Player *this);
+void    Game_Player_MoveLeft(Game_Player *this);
+void    Game_Player_MoveUp(Game_Player *this);
+void    Game_Player_MoveDown(Game_Player *this);
+void    Game_Player_SlideRight(Game_Player *this);
+void    Game_Player_SlideLeft(Game_Player *this);
+void    Game_Player_SlideUp(Game_Player *this);
+void    Game_Player_SlideDown(Game_Player *this);
+
+void    Game_Floor_Init(Game_Floor  *this);
+
+void    Game_Command_Execute(Game_Command_Type type, Game_Player *entity);
+void    Game_Command_ExecuteInput(Uint32 buttons, Game_Player *entity);
+void    Game_Command_ExecuteBatch(const Game_Command *commands, size_t count, Game_Player *entities);
+void    Game_Command_ExecuteBulk(Game_Command_Type type, Game_Player *entities, size_t count);
+void    Game_Command_Handler_Init(Game_Command_Handler *this, Game_Player *target);
+void    Game_Command_Handler_HandleWindowKey(Game_Command_Handler *this, SDL_Keycode key);
+void    Game_Command_Handler_HandleOverlayKey(Game_Command_Handler *this, SDL_Keycode key);
+void    Game_Command_Handler_HandleInput(Game_Command_Handler *this, SDL_Event event, bool *running);
+
+void    Game_Init(Game *this, Game_Config *config);
+void    Game_Quit(Game *this);
+void    Game_Update(Game *this);
+void    Game_Render(Game *this, Game_Frame_State *state);
+void    Game_Simulate(Game *this);
+bool    Game_QuickSave(Game *this);
+bool    Game_QuickLoad(Game *this);
+bool    Game_RestoreFile(Game *this, const char *path);
+void    Game_ApplyAdaptiveLevel(Game *this);
+void    Game_UpdateParticles(Game *this);
+void    Game_UpdateCamera(Game *this);
+void    Game_ChasePlayer(Game *this);
+void    Game_CollidePlayer(Game *this);
+void    Game_MovePlayer(Game *this, Uint32 buttons);
+void    Game_StartAudio(Game *this);
+void    Game_HandleEvents(Game_Command_Handler *handler, SDL_Event event, bool *running);
+void    Game_WaitWhileIdle(Game *this, Game_Command_Handler *handler, Game_Frame_State *state, bool *running);
+void    Game_Loop(Game  *this);
+bool    Game_Texure_LoadFromFile(Game *this);
+
+#endif
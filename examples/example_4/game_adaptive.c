@@ -0,0 +1,99 @@
+#include "game_adaptive.h"
+
+static const Game_Adaptive_Level    adaptive_levels[] = {
+    {60, 1, {20000, 1.00f, 64.f}},
+    {60, SDL_RENDERER_VSYNC_ADAPTIVE, {10000, 1.00f, 32.f}},
+    {60, SDL_RENDERER_VSYNC_ADAPTIVE, {5000, 0.75f, 16.f}},
+    {45, SDL_RENDERER_VSYNC_DISABLED, {2500, 0.50f, 8.f}},
+    {30, SDL_RENDERER_VSYNC_DISABLED, {1000, 0.50f, 0.f}},
+};
+
+void    Game_Adaptive_Init(Game_Adaptive *this, bool enabled) {
+    this->sample_count = 0;
+    this->level = 0;
+    this->over_budget_windows = 0;
+    this->under_budget_windows = 0;
+    this->cooldown_windows = 0;
+    this->changes = 0;
+    this->enabled = enabled;
+}
+
+size_t  Game_Adaptive_GetLevelCount(void) {
+    return (SDL_arraysize(adaptive_levels));
+}
+
+const Game_Adaptive_Level   *Game_Adaptive_GetLevel(Game_Adaptive *this) {
+    return (&adaptive_levels[this->level]);
+}
+
+Uint64  Game_Adaptive_GetBudgetNS(const Game_Adaptive_Level *level) {
+    return (SDL_NS_PER_SECOND / level->fps);
+}
+
+/* 90th percentile of the window, by insertion sort: the window is tiny. */
+static Uint64   Game_Adaptive_WindowCost(Game_Adaptive *this) {
+    Uint64  sorted[GAME_ADAPTIVE_WINDOW];
+    Uint64  value;
+    size_t  position;
+
+    for (size_t index = 0; index < this->sample_count; index++) {
+        value = this->samples[index];
+        position = index;
+        while (position > 0 && sorted[position - 1] > value) {
+            sorted[position] = sorted[position - 1];
+            position--;
+        }
+        sorted[position] = value;
+    }
+    return (sorted[(this->sample_count * 9) / 10]);
+}
+
+static void Game_Adaptive_SetLevel(Game_Adaptive *this, size_t level) {
+    this->level = level;
+    this->over_budget_windows = 0;
+    this->under_budget_windows = 0;
+    this->cooldown_windows = GAME_ADAPTIVE_COOLDOWN_WINDOWS;
+    this->changes++;
+}
+
+/* Returns true when the level changed and the caller must apply it. */
+bool    Game_Adaptive_Record(Game_Adaptive *this, Uint64 frame_cost_ns) {
+    Uint64  cost;
+    Uint64  budget;
+    Uint64  better_budget;
+
+    if (this->enabled == false)
+        return (false);
+    this->samples[this->sample_count++] = frame_cost_ns;
+    if (this->sample_count < GAME_ADAPTIVE_WINDOW)
+        return (false);
+    cost = Game_Adaptive_WindowCost(this);
+    this->sample_count = 0;
+    if (this->cooldown_windows > 0) {
+        this->cooldown_windows--;
+        return (false);
+    }
+    budget = Game_Adaptive_GetBudgetNS(&adaptive_levels[this->level]);
+    if ((double)cost > (double)budget * GAME_ADAPTIVE_DOWNGRADE_RATIO) {
+        this->under_budget_windows = 0;
+        if (++this->over_budget_windows >= GAME_ADAPTIVE_DOWNGRADE_WINDOWS
+            && this->level + 1 < Game_Adaptive_GetLevelCount()) {
+            Game_Adaptive_SetLevel(this, this->level + 1);
+            return (true);
+        }
+        return (false);
+    }
+    this->over_budget_windows = 0;
+    if (this->level == 0)
+        return (false);
+    better_budget = Game_Adaptive_GetBudgetNS(&adaptive_levels[this->level - 1]);
+    if ((double)cost < (double)better_budget * GAME_ADAPTIVE_UPGRADE_RATIO) {
+        if (++this->under_budget_windows >= GAME_ADAPTIVE_UPGRADE_WINDOWS) {
+            Game_Adaptive_SetLevel(this, this->level - 1);
+            return (true);
+        }
+    }
+    else
+        this->under_budget_windows = 0;
+    return (false);
+}
@@ -0,0 +1,56 @@
+#ifndef GAME_ADAPTIVE_H
+# define GAME_ADAPTIVE_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_ADAPTIVE_WINDOW 30
+# define GAME_ADAPTIVE_DOWNGRADE_RATIO 0.95
+# define GAME_ADAPTIVE_UPGRADE_RATIO 0.70
+# define GAME_ADAPTIVE_DOWNGRADE_WINDOWS 2
+# define GAME_ADAPTIVE_UPGRADE_WINDOWS 6
+# define GAME_ADAPTIVE_COOLDOWN_WINDOWS 3
+
+typedef struct Game_Quality {
+    size_t  particle_limit;
+    float   render_scale;
+    float   culling_margin;
+}   Game_Quality;
+
+/* One rung of the quality ladder; level 0 is the best looking. */
+typedef struct Game_Adaptive_Level {
+    size_t  fps;
+    int     vsync;
+    Game_Quality    quality;
+}   Game_Adaptive_Level;
+
+/*
+** Watches the cost of recent frames (simulation + render work, without the
+** frame-cap sleep or the vsync wait) in windows of GAME_ADAPTIVE_WINDOW
+** frames. The 90th percentile of a window is compared to the frame budget of
+** the current level:
+**   - above DOWNGRADE_RATIO of the budget for DOWNGRADE_WINDOWS windows in a
+**     row, step down one level;
+**   - below UPGRADE_RATIO of the next better level's budget for
+**     UPGRADE_WINDOWS windows in a row, step up one level.
+** The gap between both ratios, the longer upgrade streak and a cooldown after
+** every change keep the controller from oscillating between two levels.
+*/
+typedef struct Game_Adaptive {
+    Uint64  samples[GAME_ADAPTIVE_WINDOW];
+    size_t  sample_count;
+    size_t  level;
+    size_t  over_budget_windows;
+    size_t  under_budget_windows;
+    size_t  cooldown_windows;
+    size_t  changes;
+    bool    enabled;
+}   Game_Adaptive;
+
+void    Game_Adaptive_Init(Game_Adaptive *this, bool enabled);
+bool    Game_Adaptive_Record(Game_Adaptive *this, Uint64 frame_cost_ns);
+const Game_Adaptive_Level   *Game_Adaptive_GetLevel(Game_Adaptive *this);
+size_t  Game_Adaptive_GetLevelCount(void);
+Uint64  Game_Adaptive_GetBudgetNS(const Game_Adaptive_Level *level);
+
+#endif
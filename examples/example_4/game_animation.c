@@ -0,0 +1,120 @@
+#include "game_animation.h"
+#include "game_memory.h"
+
+void    Game_Animation_Library_Init(Game_Animation_Library *this) {
+    this->frames = NULL;
+    this->frame_count = 0;
+    this->lookup = NULL;
+    this->lookup_length = 0;
+    this->clips = NULL;
+    this->clip_count = 0;
+}
+
+static size_t   Game_Animation_Library_Bytes(const Game_Animation_Library *this) {
+    return (sizeof(SDL_FRect) * this->frame_count + sizeof(Uint16) * this->lookup_length
+        + sizeof(Game_Animation_Clip) * this->clip_count);
+}
+
+static Uint32   Game_Animation_Ticks(Uint32 duration_us) {
+    Uint32  ticks;
+
+    ticks = (duration_us + GAME_ANIMATION_TICK_US - 1) / GAME_ANIMATION_TICK_US;
+    return (ticks ? ticks : 1);
+}
+
+/* Returns the clip id, or -1 when the clip is empty or memory runs out. */
+int     Game_Animation_Library_AddClip(Game_Animation_Library *this, const Game_Animation_Frame *frames, size_t count, Game_Animation_Mode mode) {
+    Game_Animation_Clip *clip;
+    SDL_FRect   *new_frames;
+    Uint16  *new_lookup;
+    Game_Animation_Clip *new_clips;
+    size_t  length_ticks;
+
+    if (count == 0 || count > 0xFFFF || this->clip_count >= GAME_ANIMATION_MAX_CLIPS)
+        return (-1);
+    length_ticks = 0;
+    for (size_t index = 0; index < count; index++)
+        length_ticks += Game_Animation_Ticks(frames[index].duration_us);
+    if ((new_frames = realloc(this->frames, sizeof(SDL_FRect) * (this->frame_count + count))) == NULL)
+        return (-1);
+    this->frames = new_frames;
+    if ((new_lookup = realloc(this->lookup, sizeof(Uint16) * (this->lookup_length + length_ticks))) == NULL)
+        return (-1);
+    this->lookup = new_lookup;
+    if ((new_clips = realloc(this->clips, sizeof(Game_Animation_Clip) * (this->clip_count + 1))) == NULL)
+        return (-1);
+    this->clips = new_clips;
+    clip = &this->clips[this->clip_count];
+    clip->first_frame = (Uint32)this->frame_count;
+    clip->frame_count = (Uint32)count;
+    clip->lookup_offset = (Uint32)this->lookup_length;
+    clip->length_ticks = (Uint32)length_ticks;
+    clip->period_us = (Uint32)length_ticks * GAME_ANIMATION_TICK_US * (mode == GAME_ANIMATION_PING_PONG ? 2 : 1);
+    clip->mode = mode;
+    Game_Memory_Add(GAME_MEMORY_ANIMATIONS, (Sint64)(sizeof(SDL_FRect) * count + sizeof(Uint16) * length_ticks
+        + sizeof(Game_Animation_Clip)));
+    for (size_t index = 0; index < count; index++) {
+        this->frames[this->frame_count++] = frames[index].source;
+        for (Uint32 tick = 0; tick < Game_Animation_Ticks(frames[index].duration_us); tick++)
+            this->lookup[this->lookup_length++] = (Uint16)index;
+    }
+    return ((int)this->clip_count++);
+}
+
+/* `count` frames of a sprite sheet laid out row by row, `columns` per row. */
+int     Game_Animation_Library_AddGrid(Game_Animation_Library *this, float frame_width, float frame_height, size_t columns, size_t count, Uint32 duration_us, Game_Animation_Mode mode) {
+    Game_Animation_Frame    *frames;
+    int     clip;
+
+    if (columns == 0 || (frames = malloc(sizeof(Game_Animation_Frame) * count)) == NULL)
+        return (-1);
+    for (size_t index = 0; index < count; index++) {
+        frames[index].source = (SDL_FRect){(float)(index % columns) * frame_width,
+            (float)(index / columns) * frame_height, frame_width, frame_height};
+        frames[index].duration_us = duration_us;
+    }
+    clip = Game_Animation_Library_AddClip(this, frames, count, mode);
+    free(frames);
+    return (clip);
+}
+
+void    Game_Animation_Library_Destroy(Game_Animation_Library *this) {
+    Game_Memory_Add(GAME_MEMORY_ANIMATIONS, -(Sint64)Game_Animation_Library_Bytes(this));
+    free(this->frames);
+    free(this->lookup);
+    free(this->clips);
+    Game_Animation_Library_Init(this);
+}
+
+Game_Animation_State    Game_Animation_State_Create(int clip, Uint32 time_us) {
+    Game_Animation_State    state;
+
+    state.clip = clip < 0 ? GAME_ANIMATION_NONE : (Uint16)clip;
+    state.time_us = time_us;
+    return (state);
+}
+
+/*
+** One pass over every state: advance the time, wrap it by the clip period,
+** and write the current frame's source rectangle for the renderer.
+** States without a clip keep whatever source rectangle they already have.
+*/
+void    Game_Animation_Advance(const Game_Animation_Library *library, Game_Animation_State *states, SDL_FRect *sources, size_t count, Uint32 delta_us) {
+    const Game_Animation_Clip   *clip;
+    Uint32  time;
+    Uint32  tick;
+
+    for (size_t index = 0; index < count; index++) {
+        if (states[index].clip == GAME_ANIMATION_NONE)
+            continue ;
+        clip = &library->clips[states[index].clip];
+        time = states[index].time_us + delta_us;
+        if (time >= clip->period_us)
+            time = clip->mode == GAME_ANIMATION_ONCE ? clip->period_us - 1 : time % clip->period_us;
+        states[index].time_us = time;
+        tick = time / GAME_ANIMATION_TICK_US;
+        if (tick >= clip->length_ticks)
+            tick = 2 * clip->length_ticks - 1 - tick;
+        sources[index] = library->frames[clip->first_frame + library->lookup[clip->lookup_offset + tick]];
+    }
+}
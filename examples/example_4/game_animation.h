@@ -0,0 +1,61 @@
+#ifndef GAME_ANIMATION_H
+# define GAME_ANIMATION_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_ANIMATION_NONE 0xFFFF
+# define GAME_ANIMATION_TICK_US 1000
+# define GAME_ANIMATION_MAX_CLIPS 0xFFFF
+
+typedef enum Game_Animation_Mode {
+    GAME_ANIMATION_ONCE,
+    GAME_ANIMATION_LOOP,
+    GAME_ANIMATION_PING_PONG,
+}   Game_Animation_Mode;
+
+typedef struct Game_Animation_Frame {
+    SDL_FRect   source;
+    Uint32  duration_us;
+}   Game_Animation_Frame;
+
+/*
+** A clip is a run of frames in the library plus a slice of the lookup table
+** holding, for every GAME_ANIMATION_TICK_US of the clip, the frame to show.
+** period_us is the time after which the clip wraps: its length, or twice
+** that for ping-pong clips, which read the table backwards on the way back.
+*/
+typedef struct Game_Animation_Clip {
+    Uint32  first_frame;
+    Uint32  frame_count;
+    Uint32  lookup_offset;
+    Uint32  length_ticks;
+    Uint32  period_us;
+    Game_Animation_Mode mode;
+}   Game_Animation_Clip;
+
+/* Shared, read-only once the clips are registered. */
+typedef struct Game_Animation_Library {
+    SDL_FRect   *frames;
+    size_t  frame_count;
+    Uint16  *lookup;
+    size_t  lookup_length;
+    Game_Animation_Clip *clips;
+    size_t  clip_count;
+}   Game_Animation_Library;
+
+/* Everything an entity stores about its animation. */
+typedef struct Game_Animation_State {
+    Uint16  clip;
+    Uint32  time_us;
+}   Game_Animation_State;
+
+void    Game_Animation_Library_Init(Game_Animation_Library *this);
+int     Game_Animation_Library_AddClip(Game_Animation_Library *this, const Game_Animation_Frame *frames, size_t count, Game_Animation_Mode mode);
+int     Game_Animation_Library_AddGrid(Game_Animation_Library *this, float frame_width, float frame_height, size_t columns, size_t count, Uint32 duration_us, Game_Animation_Mode mode);
+void    Game_Animation_Library_Destroy(Game_Animation_Library *this);
+
+Game_Animation_State    Game_Animation_State_Create(int clip, Uint32 time_us);
+void    Game_Animation_Advance(const Game_Animation_Library *library, Game_Animation_State *states, SDL_FRect *sources, size_t count, Uint32 delta_us);
+
+#endif
@@ -0,0 +1,426 @@
+#include "game_audio.h"
+#include "game_memory.h"
+
+#define GAME_AUDIO_UNIT_STEP ((Uint64)1 << 32)
+
+/* Adds `frames` mono samples to interleaved stereo output with the voice's left and right gains. */
+typedef void    (*Game_Audio_Mixer)(float *output, const float *samples, size_t frames, float left, float right);
+typedef void    (*Game_Audio_Clamp)(float *output, size_t count);
+
+static void Game_Audio_Mix_Scalar(float *output, const float *samples, size_t frames, float left, float right) {
+    for (size_t frame = 0; frame < frames; frame++) {
+        output[frame * 2] += samples[frame] * left;
+        output[frame * 2 + 1] += samples[frame] * right;
+    }
+}
+
+static void Game_Audio_Clamp_Scalar(float *output, size_t count) {
+    for (size_t index = 0; index < count; index++)
+        output[index] = SDL_clamp(output[index], -1.f, 1.f);
+}
+
+#ifdef SDL_SSE_INTRINSICS
+/* unpacklo/hi duplicate each sample into its left and right slot. */
+SDL_TARGETING("sse") static void Game_Audio_Mix_SSE(float *output, const float *samples, size_t frames, float left, float right) {
+    __m128  gains;
+    __m128  mono;
+    size_t  frame;
+
+    gains = _mm_setr_ps(left, right, left, right);
+    for (frame = 0; frame + 4 <= frames; frame += 4) {
+        mono = _mm_loadu_ps(samples + frame);
+        _mm_storeu_ps(output + frame * 2,
+            _mm_add_ps(_mm_loadu_ps(output + frame * 2), _mm_mul_ps(_mm_unpacklo_ps(mono, mono), gains)));
+        _mm_storeu_ps(output + frame * 2 + 4,
+            _mm_add_ps(_mm_loadu_ps(output + frame * 2 + 4), _mm_mul_ps(_mm_unpackhi_ps(mono, mono), gains)));
+    }
+    Game_Audio_Mix_Scalar(output + frame * 2, samples + frame, frames - frame, left, right);
+}
+
+SDL_TARGETING("sse") static void Game_Audio_Clamp_SSE(float *output, size_t count) {
+    size_t  index;
+
+    for (index = 0; index + 4 <= count; index += 4)
+        _mm_storeu_ps(output + index, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(output + index), _mm_set1_ps(-1.f)), _mm_set1_ps(1.f)));
+    Game_Audio_Clamp_Scalar(output + index, count - index);
+}
+#endif
+
+#ifdef SDL_AVX_INTRINSICS
+/* The unpacks work per 128-bit lane, so two lane permutes put the frames back in order. */
+SDL_TARGETING("avx") static void Game_Audio_Mix_AVX(float *output, const float *samples, size_t frames, float left, float right) {
+    __m256  gains;
+    __m256  mono;
+    __m256  low;
+    __m256  high;
+    size_t  frame;
+
+    gains = _mm256_setr_ps(left, right, left, right, left, right, left, right);
+    for (frame = 0; frame + 8 <= frames; frame += 8) {
+        mono = _mm256_loadu_ps(samples + frame);
+        low = _mm256_unpacklo_ps(mono, mono);
+        high = _mm256_unpackhi_ps(mono, mono);
+        _mm256_storeu_ps(output + frame * 2, _mm256_add_ps(_mm256_loadu_ps(output + frame * 2),
+            _mm256_mul_ps(_mm256_permute2f128_ps(low, high, 0x20), gains)));
+        _mm256_storeu_ps(output + frame * 2 + 8, _mm256_add_ps(_mm256_loadu_ps(output + frame * 2 + 8),
+            _mm256_mul_ps(_mm256_permute2f128_ps(low, high, 0x31), gains)));
+    }
+    Game_Audio_Mix_Scalar(output + frame * 2, samples + frame, frames - frame, left, right);
+}
+
+SDL_TARGETING("avx") static void Game_Audio_Clamp_AVX(float *output, size_t count) {
+    size_t  index;
+
+    for (index = 0; index + 8 <= count; index += 8)
+        _mm256_storeu_ps(output + index,
+            _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(output + index), _mm256_set1_ps(-1.f)), _mm256_set1_ps(1.f)));
+    Game_Audio_Clamp_Scalar(output + index, count - index);
+}
+#endif
+
+static const Game_Audio_Mixer   game_audio_mixers[GAME_KERNEL_COUNT] = {
+    Game_Audio_Mix_Scalar,
+#ifdef SDL_SSE_INTRINSICS
+    Game_Audio_Mix_SSE,
+#else
+    Game_Audio_Mix_Scalar,
+#endif
+#ifdef SDL_AVX_INTRINSICS
+    Game_Audio_Mix_AVX,
+#else
+    Game_Audio_Mix_Scalar,
+#endif
+};
+
+static const Game_Audio_Clamp   game_audio_clamps[GAME_KERNEL_COUNT] = {
+    Game_Audio_Clamp_Scalar,
+#ifdef SDL_SSE_INTRINSICS
+    Game_Audio_Clamp_SSE,
+#else
+    Game_Audio_Clamp_Scalar,
+#endif
+#ifdef SDL_AVX_INTRINSICS
+    Game_Audio_Clamp_AVX,
+#else
+    Game_Audio_Clamp_Scalar,
+#endif
+};
+
+/* What each kernel of the table above needs. */
+const Game_Kernel_Isa   game_audio_kernels[GAME_KERNEL_COUNT] = {GAME_KERNEL_ISA_NONE, GAME_KERNEL_ISA_SSE, GAME_KERNEL_ISA_AVX};
+
+bool    Game_Audio_Init(Game_Audio *this) {
+    SDL_zerop(this);
+    this->kernel = Game_Kernel_GetBest(game_audio_kernels);
+    this->next_handle = 1;
+    if ((this->pool = SDL_aligned_alloc(GAME_AUDIO_ALIGNMENT, GAME_AUDIO_POOL_BYTES)) == NULL)
+        return (false);
+    Game_Memory_Add(GAME_MEMORY_AUDIO, GAME_AUDIO_POOL_BYTES);
+    return (true);
+}
+
+static void SDLCALL Game_Audio_Callback(void *data, SDL_AudioStream *stream, int additional, int total) {
+    Game_Audio  *this;
+    size_t  frames;
+    size_t  chunk;
+
+    (void)total;
+    this = data;
+    frames = ((size_t)additional + sizeof(float) * GAME_AUDIO_CHANNELS - 1) / (sizeof(float) * GAME_AUDIO_CHANNELS);
+    while (frames > 0) {
+        chunk = SDL_min(frames, GAME_AUDIO_CHUNK);
+        Game_Audio_Mix(this, this->mix, chunk);
+        SDL_PutAudioStreamData(stream, this->mix, (int)(sizeof(float) * GAME_AUDIO_CHANNELS * chunk));
+        frames -= chunk;
+    }
+}
+
+/* Without a device the game stays silent: commands are still accepted and simply never mixed. */
+bool    Game_Audio_Open(Game_Audio *this) {
+    SDL_AudioSpec   spec;
+
+    if (this->pool == NULL || SDL_InitSubSystem(SDL_INIT_AUDIO) == false)
+        return (false);
+    spec = (SDL_AudioSpec){SDL_AUDIO_F32, GAME_AUDIO_CHANNELS, GAME_AUDIO_FREQUENCY};
+    this->stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, Game_Audio_Callback, this);
+    if (this->stream == NULL || SDL_ResumeAudioStreamDevice(this->stream) == false) {
+        SDL_DestroyAudioStream(this->stream);
+        this->stream = NULL;
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return (false);
+    }
+    return (true);
+}
+
+/* Room for `frames` samples in the pool, registered as the next sound. */
+static float    *Game_Audio_AddSound(Game_Audio *this, size_t frames, Uint32 frequency, size_t *sound) {
+    size_t  bytes;
+    float   *samples;
+
+    bytes = (sizeof(float) * frames + GAME_AUDIO_ALIGNMENT - 1) & ~(size_t)(GAME_AUDIO_ALIGNMENT - 1);
+    if (this->pool == NULL || frames == 0 || frequency == 0 || this->sound_count == GAME_AUDIO_SOUNDS
+        || bytes > GAME_AUDIO_POOL_BYTES - this->pool_used)
+        return (NULL);
+    samples = (float *)(this->pool + this->pool_used);
+    this->pool_used += bytes;
+    *sound = this->sound_count;
+    this->sounds[this->sound_count++] = (Game_Sound){samples, frames, frequency};
+    return (samples);
+}
+
+/* Game thread, before the sound is first played. Returns GAME_AUDIO_NO_SOUND when the pool is full. */
+size_t  Game_Audio_CreateSound(Game_Audio *this, const float *samples, size_t frames, Uint32 frequency) {
+    float   *destination;
+    size_t  sound;
+
+    if ((destination = Game_Audio_AddSound(this, frames, frequency, &sound)) == NULL)
+        return (GAME_AUDIO_NO_SOUND);
+    SDL_memcpy(destination, samples, sizeof(float) * frames);
+    return (sound);
+}
+
+/* Any WAV SDL can read, converted once to mono float at its own rate. */
+size_t  Game_Audio_LoadWAV(Game_Audio *this, const char *path) {
+    SDL_AudioSpec   spec;
+    SDL_AudioSpec   mono;
+    Uint8   *data;
+    Uint32  length;
+    Uint8   *converted;
+    int     converted_length;
+    size_t  sound;
+
+    if (SDL_LoadWAV(path, &spec, &data, &length) == false)
+        return (GAME_AUDIO_NO_SOUND);
+    mono = (SDL_AudioSpec){SDL_AUDIO_F32, 1, spec.freq};
+    if (SDL_ConvertAudioSamples(&spec, data, (int)length, &mono, &converted, &converted_length) == false) {
+        SDL_free(data);
+        return (GAME_AUDIO_NO_SOUND);
+    }
+    SDL_free(data);
+    sound = Game_Audio_CreateSound(this, (const float *)converted, (size_t)converted_length / sizeof(float), (Uint32)spec.freq);
+    SDL_free(converted);
+    return (sound);
+}
+
+/* A short sine blip that decays to silence, for feedback sounds that need no asset. */
+size_t  Game_Audio_CreateTone(Game_Audio *this, float frequency, float seconds) {
+    float   *samples;
+    size_t  frames;
+    size_t  sound;
+
+    frames = (size_t)(seconds * GAME_AUDIO_FREQUENCY);
+    if ((samples = Game_Audio_AddSound(this, frames, GAME_AUDIO_FREQUENCY, &sound)) == NULL)
+        return (GAME_AUDIO_NO_SOUND);
+    for (size_t frame = 0; frame < frames; frame++)
+        samples[frame] = 0.5f * SDL_sinf(2 * SDL_PI_F * frequency * (float)frame / GAME_AUDIO_FREQUENCY)
+            * (1.f - (float)frame / (float)frames) * (1.f - (float)frame / (float)frames);
+    return (sound);
+}
+
+/* Producer side of the ring: one game thread at a time. */
+static bool Game_Audio_Push(Game_Audio *this, const Game_Audio_Command *command) {
+    Uint32  tail;
+
+    tail = SDL_GetAtomicU32(&this->command_tail);
+    if (tail - SDL_GetAtomicU32(&this->command_head) >= GAME_AUDIO_QUEUE) {
+        this->rejected++;
+        return (false);
+    }
+    this->commands[tail & (GAME_AUDIO_QUEUE - 1)] = *command;
+    SDL_SetAtomicU32(&this->command_tail, tail + 1);
+    return (true);
+}
+
+/*
+** Returns the voice's handle for Game_Audio_Stop, or 0 when the command could
+** not be queued. `pan` runs from -1 (left) to 1 (right) and `pitch` scales
+** the playback rate.
+*/
+Uint32  Game_Audio_Play(Game_Audio *this, size_t sound, float volume, float pan, float pitch, bool loop) {
+    Game_Audio_Command  command;
+
+    if (sound >= this->sound_count || pitch <= 0.f)
+        return (0);
+    command = (Game_Audio_Command){GAME_AUDIO_PLAY, this->next_handle, (Uint32)sound, volume, SDL_clamp(pan, -1.f, 1.f), pitch, loop};
+    if (Game_Audio_Push(this, &command) == false)
+        return (0);
+    if (++this->next_handle == 0)
+        this->next_handle = 1;
+    return (command.voice);
+}
+
+bool    Game_Audio_Stop(Game_Audio *this, Uint32 voice) {
+    return (Game_Audio_Push(this, &(Game_Audio_Command){GAME_AUDIO_STOP, voice, 0, 0.f, 0.f, 0.f, false}));
+}
+
+bool    Game_Audio_StopAll(Game_Audio *this) {
+    return (Game_Audio_Push(this, &(Game_Audio_Command){GAME_AUDIO_STOP_ALL, 0, 0, 0.f, 0.f, 0.f, false}));
+}
+
+/* Stops the device, and with it the callback's wakeups; voices resume where they were. */
+bool    Game_Audio_SetPaused(Game_Audio *this, bool paused) {
+    if (this->stream == NULL)
+        return (false);
+    return (paused ? SDL_PauseAudioStreamDevice(this->stream) : SDL_ResumeAudioStreamDevice(this->stream));
+}
+
+/* Constant-power pan, and a 32.32 step that is exactly 1.0 when no resampling is needed. */
+static void Game_Audio_Start(Game_Audio *this, const Game_Audio_Command *command) {
+    Game_Audio_Voice    *voice;
+    const Game_Sound    *sound;
+    float   angle;
+
+    for (voice = this->voices; voice < this->voices + GAME_AUDIO_VOICES && voice->sound != NULL; voice++)
+        ;
+    if (voice == this->voices + GAME_AUDIO_VOICES) {
+        this->dropped++;
+        return ;
+    }
+    sound = &this->sounds[command->sound];
+    angle = (command->pan + 1.f) * SDL_PI_F / 4;
+    voice->sound = sound;
+    voice->position = 0;
+    voice->step = (Uint64)((double)sound->frequency * command->pitch / GAME_AUDIO_FREQUENCY * (double)GAME_AUDIO_UNIT_STEP + 0.5);
+    voice->left = command->volume * SDL_cosf(angle);
+    voice->right = command->volume * SDL_sinf(angle);
+    voice->handle = command->voice;
+    voice->loop = command->loop;
+}
+
+static void Game_Audio_Apply(Game_Audio *this, const Game_Audio_Command *command) {
+    switch (command->type) {
+        case GAME_AUDIO_PLAY:
+            Game_Audio_Start(this, command);
+            break ;
+        case GAME_AUDIO_STOP:
+            for (size_t index = 0; index < GAME_AUDIO_VOICES; index++)
+                if (this->voices[index].handle == command->voice)
+                    this->voices[index].sound = NULL;
+            break ;
+        case GAME_AUDIO_STOP_ALL:
+            for (size_t index = 0; index < GAME_AUDIO_VOICES; index++)
+                this->voices[index].sound = NULL;
+            break ;
+    }
+}
+
+static void Game_Audio_Drain(Game_Audio *this) {
+    Uint32  head;
+    Uint32  tail;
+
+    head = SDL_GetAtomicU32(&this->command_head);
+    tail = SDL_GetAtomicU32(&this->command_tail);
+    for (; head != tail; head++)
+        Game_Audio_Apply(this, &this->commands[head & (GAME_AUDIO_QUEUE - 1)]);
+    SDL_SetAtomicU32(&this->command_head, head);
+}
+
+/*
+** Linear interpolation into the scratch buffer; stops early when a one-shot
+** sound ends. Runs that stay clear of the last source frame skip the end
+** checks, so those only cost once per run.
+*/
+static size_t   Game_Audio_Voice_Resample(Game_Audio_Voice *this, float *scratch, size_t frames) {
+    const Game_Sound    *sound;
+    Uint64  end;
+    Uint64  last;
+    Uint64  position;
+    size_t  written;
+    size_t  run;
+    size_t  index;
+    float   next;
+
+    sound = this->sound;
+    end = (Uint64)sound->frames << 32;
+    last = (Uint64)(sound->frames - 1) << 32;
+    for (written = 0; written < frames; written += run) {
+        if (this->position >= end) {
+            if (this->loop == false)
+                break ;
+            this->position %= end;
+        }
+        if (this->position < last) {
+            run = (size_t)SDL_min((Uint64)(frames - written), (last - this->position + this->step - 1) / this->step);
+            position = this->position;
+            for (size_t frame = written; frame < written + run; frame++) {
+                index = (size_t)(position >> 32);
+                scratch[frame] = sound->samples[index] + (sound->samples[index + 1] - sound->samples[index])
+                    * ((float)(Uint32)position * (1.f / 4294967296.f));
+                position += this->step;
+            }
+            this->position = position;
+            continue ;
+        }
+        next = this->loop ? sound->samples[0] : 0.f;
+        scratch[written] = sound->samples[sound->frames - 1] + (next - sound->samples[sound->frames - 1])
+            * ((float)(Uint32)this->position * (1.f / 4294967296.f));
+        this->position += this->step;
+        run = 1;
+    }
+    return (written);
+}
+
+/* Unresampled voices are mixed straight from the sound. Returns false once a one-shot voice has ended. */
+static bool Game_Audio_Voice_Mix(Game_Audio *this, Game_Audio_Voice *voice, float *output, size_t frames) {
+    Game_Audio_Mixer    mixer;
+    Uint64  end;
+    size_t  done;
+    size_t  count;
+    size_t  index;
+
+    mixer = game_audio_mixers[this->kernel];
+    end = (Uint64)voice->sound->frames << 32;
+    if (voice->step != GAME_AUDIO_UNIT_STEP) {
+        count = Game_Audio_Voice_Resample(voice, this->scratch, frames);
+        mixer(output, this->scratch, count, voice->left, voice->right);
+        return (voice->loop || voice->position < end);
+    }
+    for (done = 0; done < frames; done += count) {
+        if (voice->position >= end) {
+            if (voice->loop == false)
+                return (false);
+            voice->position %= end;
+        }
+        index = (size_t)(voice->position >> 32);
+        count = SDL_min(frames - done, voice->sound->frames - index);
+        mixer(output + done * GAME_AUDIO_CHANNELS, voice->sound->samples + index, count, voice->left, voice->right);
+        voice->position += (Uint64)count << 32;
+    }
+    return (voice->loop || voice->position < end);
+}
+
+/*
+** Audio thread (or any single thread while no device is open): applies the
+** queued commands and writes `frames` interleaved stereo frames to `output`,
+** GAME_AUDIO_CHUNK at a time so commands never wait longer than one chunk.
+*/
+void    Game_Audio_Mix(Game_Audio *this, float *output, size_t frames) {
+    Game_Audio_Voice    *voice;
+    size_t  chunk;
+
+    while (frames > 0) {
+        chunk = SDL_min(frames, GAME_AUDIO_CHUNK);
+        Game_Audio_Drain(this);
+        SDL_memset(output, 0, sizeof(float) * GAME_AUDIO_CHANNELS * chunk);
+        for (voice = this->voices; voice < this->voices + GAME_AUDIO_VOICES; voice++)
+            if (voice->sound != NULL && Game_Audio_Voice_Mix(this, voice, output, chunk) == false)
+                voice->sound = NULL;
+        game_audio_clamps[this->kernel](output, GAME_AUDIO_CHANNELS * chunk);
+        output += GAME_AUDIO_CHANNELS * chunk;
+        frames -= chunk;
+    }
+}
+
+void    Game_Audio_Destroy(Game_Audio *this) {
+    if (this->stream != NULL) {
+        SDL_DestroyAudioStream(this->stream);
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    }
+    if (this->pool != NULL)
+        Game_Memory_Add(GAME_MEMORY_AUDIO, -(Sint64)GAME_AUDIO_POOL_BYTES);
+    SDL_aligned_free(this->pool);
+    this->stream = NULL;
+    this->pool = NULL;
+    this->pool_used = 0;
+    this->sound_count = 0;
+}
@@ -0,0 +1,94 @@
+#ifndef GAME_AUDIO_H
+# define GAME_AUDIO_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+# include "game_kernel.h"
+
+# define GAME_AUDIO_FREQUENCY 48000
+# define GAME_AUDIO_CHANNELS 2
+# define GAME_AUDIO_VOICES 64
+# define GAME_AUDIO_SOUNDS 64
+# define GAME_AUDIO_QUEUE 256
+# define GAME_AUDIO_CHUNK 256
+# define GAME_AUDIO_POOL_BYTES (8 * 1024 * 1024)
+# define GAME_AUDIO_ALIGNMENT 64
+# define GAME_AUDIO_NO_SOUND ((size_t)-1)
+
+typedef enum Game_Audio_Command_Type {
+    GAME_AUDIO_PLAY,
+    GAME_AUDIO_STOP,
+    GAME_AUDIO_STOP_ALL,
+}   Game_Audio_Command_Type;
+
+/* Mono float samples, stored in the audio pool and never freed before Game_Audio_Destroy. */
+typedef struct Game_Sound {
+    const float *samples;
+    size_t  frames;
+    Uint32  frequency;
+}   Game_Sound;
+
+typedef struct Game_Audio_Command {
+    Game_Audio_Command_Type type;
+    Uint32  voice;
+    Uint32  sound;
+    float   volume;
+    float   pan;
+    float   pitch;
+    bool    loop;
+}   Game_Audio_Command;
+
+/* `position` and `step` count source frames in 32.32 fixed point; a free voice has no sound. */
+typedef struct Game_Audio_Voice {
+    const Game_Sound    *sound;
+    Uint64  position;
+    Uint64  step;
+    float   left;
+    float   right;
+    Uint32  handle;
+    bool    loop;
+}   Game_Audio_Voice;
+
+/*
+** Software mixer behind an SDL audio stream callback. The game (one thread
+** at a time) only fills sound buffers, before playing them, and pushes
+** commands into a single-producer single-consumer ring; the callback, on
+** SDL's audio thread, drains the ring every GAME_AUDIO_CHUNK frames and
+** mixes the live voices.
+** Neither side ever waits for the other: a full ring rejects the command,
+** a play with no free voice is dropped. Everything below `voices` belongs
+** to the audio thread once the device is open.
+*/
+typedef struct Game_Audio {
+    SDL_AudioStream *stream;
+    Uint8   *pool;
+    size_t  pool_used;
+    Game_Sound  sounds[GAME_AUDIO_SOUNDS];
+    size_t  sound_count;
+    Game_Audio_Command  commands[GAME_AUDIO_QUEUE];
+    SDL_AtomicU32   command_head;
+    SDL_AtomicU32   command_tail;
+    Uint32  next_handle;
+    size_t  rejected;
+    Game_Audio_Voice    voices[GAME_AUDIO_VOICES];
+    Game_Kernel kernel;
+    size_t  dropped;
+    float   scratch[GAME_AUDIO_CHUNK];
+    float   mix[GAME_AUDIO_CHUNK * GAME_AUDIO_CHANNELS];
+}   Game_Audio;
+
+extern const Game_Kernel_Isa    game_audio_kernels[GAME_KERNEL_COUNT];
+
+bool    Game_Audio_Init(Game_Audio *this);
+bool    Game_Audio_Open(Game_Audio *this);
+size_t  Game_Audio_CreateSound(Game_Audio *this, const float *samples, size_t frames, Uint32 frequency);
+size_t  Game_Audio_LoadWAV(Game_Audio *this, const char *path);
+size_t  Game_Audio_CreateTone(Game_Audio *this, float frequency, float seconds);
+Uint32  Game_Audio_Play(Game_Audio *this, size_t sound, float volume, float pan, float pitch, bool loop);
+bool    Game_Audio_Stop(Game_Audio *this, Uint32 voice);
+bool    Game_Audio_StopAll(Game_Audio *this);
+bool    Game_Audio_SetPaused(Game_Audio *this, bool paused);
+void    Game_Audio_Mix(Game_Audio *this, float *output, size_t frames);
+void    Game_Audio_Destroy(Game_Audio *this);
+
+#endif
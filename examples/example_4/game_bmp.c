@@ -0,0 +1,325 @@
+#include "game_bmp.h"
+
+#define GAME_BMP_FILE_HEADER 14
+#define GAME_BMP_INFO_HEADER 40
+#define GAME_BMP_RGB 0
+#define GAME_BMP_BITFIELDS 3
+#define GAME_BMP_OPAQUE 0xFF000000u
+
+typedef enum Game_Bmp_Layout {
+    GAME_BMP_LAYOUT_BGRA,
+    GAME_BMP_LAYOUT_BGRX,
+    GAME_BMP_LAYOUT_BGR,
+    GAME_BMP_LAYOUT_COUNT,
+}   Game_Bmp_Layout;
+
+/*
+** Converts one row of `width` pixels. `key` is the opaque ARGB color that
+** becomes transparent, or 0 for none (no opaque pixel is 0).
+*/
+typedef void    (*Game_Bmp_Row)(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key);
+
+static Uint32   Game_Bmp_Read32(const Uint8 *bytes) {
+    Uint32  value;
+
+    SDL_memcpy(&value, bytes, sizeof(value));
+    return (SDL_Swap32LE(value));
+}
+
+static Uint16   Game_Bmp_Read16(const Uint8 *bytes) {
+    Uint16  value;
+
+    SDL_memcpy(&value, bytes, sizeof(value));
+    return (SDL_Swap16LE(value));
+}
+
+/* c * a / 255 rounded, exactly, on the red/blue pair then on green. */
+static inline Uint32    Game_Bmp_Premultiply(Uint32 pixel) {
+    Uint32  alpha;
+    Uint32  rb;
+    Uint32  g;
+
+    alpha = pixel >> 24;
+    rb = (pixel & 0x00FF00FFu) * alpha + 0x00800080u;
+    g = (pixel & 0x0000FF00u) * alpha + 0x00008000u;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+    g = ((g + ((g >> 8) & 0x0000FF00u)) >> 8) & 0x0000FF00u;
+    return ((pixel & 0xFF000000u) | rb | g);
+}
+
+static inline Uint32    Game_Bmp_Key(Uint32 pixel, Uint32 key) {
+    return (pixel == key ? 0 : pixel);
+}
+
+static void Game_Bmp_Row_BGRA(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    (void)key;
+    for (size_t x = 0; x < width; x++)
+        destination[x] = Game_Bmp_Premultiply(Game_Bmp_Read32(source + x * 4));
+}
+
+static void Game_Bmp_Row_BGRX(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    for (size_t x = 0; x < width; x++)
+        destination[x] = Game_Bmp_Key(Game_Bmp_Read32(source + x * 4) | GAME_BMP_OPAQUE, key);
+}
+
+static void Game_Bmp_Row_BGR(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    const Uint8 *pixel;
+
+    for (size_t x = 0; x < width; x++) {
+        pixel = source + x * 3;
+        destination[x] = Game_Bmp_Key(GAME_BMP_OPAQUE | (Uint32)pixel[2] << 16 | (Uint32)pixel[1] << 8 | pixel[0], key);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Two pixels widened to 16-bit lanes; the alpha lane is multiplied by 255 so it comes out unchanged. */
+SDL_TARGETING("sse2") static inline __m128i Game_Bmp_Premultiply_SSE2(__m128i color) {
+    __m128i alpha;
+    __m128i product;
+
+    alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(alpha, _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+    product = _mm_add_epi16(_mm_mullo_epi16(color, alpha), _mm_set1_epi16(128));
+    return (_mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8));
+}
+
+SDL_TARGETING("sse2") static void Game_Bmp_Row_BGRA_SSE(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    __m128i pixels;
+    size_t  x;
+
+    for (x = 0; x + 4 <= width; x += 4) {
+        pixels = _mm_loadu_si128((const __m128i *)(source + x * 4));
+        pixels = _mm_packus_epi16(Game_Bmp_Premultiply_SSE2(_mm_unpacklo_epi8(pixels, _mm_setzero_si128())),
+            Game_Bmp_Premultiply_SSE2(_mm_unpackhi_epi8(pixels, _mm_setzero_si128())));
+        _mm_storeu_si128((__m128i *)(destination + x), pixels);
+    }
+    Game_Bmp_Row_BGRA(destination + x, source + x * 4, width - x, key);
+}
+
+SDL_TARGETING("sse2") static void Game_Bmp_Row_BGRX_SSE(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    __m128i pixels;
+    size_t  x;
+
+    for (x = 0; x + 4 <= width; x += 4) {
+        pixels = _mm_or_si128(_mm_loadu_si128((const __m128i *)(source + x * 4)), _mm_set1_epi32((int)GAME_BMP_OPAQUE));
+        pixels = _mm_andnot_si128(_mm_cmpeq_epi32(pixels, _mm_set1_epi32((int)key)), pixels);
+        _mm_storeu_si128((__m128i *)(destination + x), pixels);
+    }
+    Game_Bmp_Row_BGRX(destination + x, source + x * 4, width - x, key);
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+/* Four 3-byte pixels per 16-byte load, so the load stays in the row while 6 pixels are left. */
+SDL_TARGETING("ssse3") static void Game_Bmp_Row_BGR_SSE(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    __m128i shuffle;
+    __m128i pixels;
+    size_t  x;
+
+    shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    for (x = 0; x + 6 <= width; x += 4) {
+        pixels = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(source + x * 3)), shuffle);
+        pixels = _mm_or_si128(pixels, _mm_set1_epi32((int)GAME_BMP_OPAQUE));
+        pixels = _mm_andnot_si128(_mm_cmpeq_epi32(pixels, _mm_set1_epi32((int)key)), pixels);
+        _mm_storeu_si128((__m128i *)(destination + x), pixels);
+    }
+    Game_Bmp_Row_BGR(destination + x, source + x * 3, width - x, key);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static inline __m256i Game_Bmp_Premultiply_AVX2(__m256i color) {
+    __m256i alpha;
+    __m256i product;
+
+    alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm256_or_si256(alpha, _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0));
+    product = _mm256_add_epi16(_mm256_mullo_epi16(color, alpha), _mm256_set1_epi16(128));
+    return (_mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8));
+}
+
+/* Unpack and pack both work per 128-bit lane, so the pixels come back in order. */
+SDL_TARGETING("avx2") static void Game_Bmp_Row_BGRA_AVX2(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    __m256i pixels;
+    size_t  x;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        pixels = _mm256_loadu_si256((const __m256i *)(source + x * 4));
+        pixels = _mm256_packus_epi16(Game_Bmp_Premultiply_AVX2(_mm256_unpacklo_epi8(pixels, _mm256_setzero_si256())),
+            Game_Bmp_Premultiply_AVX2(_mm256_unpackhi_epi8(pixels, _mm256_setzero_si256())));
+        _mm256_storeu_si256((__m256i *)(destination + x), pixels);
+    }
+    Game_Bmp_Row_BGRA(destination + x, source + x * 4, width - x, key);
+}
+
+SDL_TARGETING("avx2") static void Game_Bmp_Row_BGRX_AVX2(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    __m256i pixels;
+    size_t  x;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        pixels = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(source + x * 4)), _mm256_set1_epi32((int)GAME_BMP_OPAQUE));
+        pixels = _mm256_andnot_si256(_mm256_cmpeq_epi32(pixels, _mm256_set1_epi32((int)key)), pixels);
+        _mm256_storeu_si256((__m256i *)(destination + x), pixels);
+    }
+    Game_Bmp_Row_BGRX(destination + x, source + x * 4, width - x, key);
+}
+
+/*
+** Eight 3-byte pixels: the permute moves source bytes 12..23 into the upper
+** lane, then one in-lane shuffle spreads each lane's four pixels. The 32-byte
+** load needs 11 pixels left in the row.
+*/
+SDL_TARGETING("avx2") static void Game_Bmp_Row_BGR_AVX2(Uint32 *destination, const Uint8 *source, size_t width, Uint32 key) {
+    __m256i spread;
+    __m256i shuffle;
+    __m256i pixels;
+    size_t  x;
+
+    spread = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+    shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+        0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    for (x = 0; x + 11 <= width; x += 8) {
+        pixels = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i *)(source + x * 3)), spread);
+        pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), _mm256_set1_epi32((int)GAME_BMP_OPAQUE));
+        pixels = _mm256_andnot_si256(_mm256_cmpeq_epi32(pixels, _mm256_set1_epi32((int)key)), pixels);
+        _mm256_storeu_si256((__m256i *)(destination + x), pixels);
+    }
+    Game_Bmp_Row_BGR(destination + x, source + x * 3, width - x, key);
+}
+#endif
+
+static const Game_Bmp_Row  game_bmp_rows[GAME_KERNEL_COUNT][GAME_BMP_LAYOUT_COUNT] = {
+    {Game_Bmp_Row_BGRA, Game_Bmp_Row_BGRX, Game_Bmp_Row_BGR},
+#if defined(SDL_SSE2_INTRINSICS) && defined(SDL_SSE4_1_INTRINSICS)
+    {Game_Bmp_Row_BGRA_SSE, Game_Bmp_Row_BGRX_SSE, Game_Bmp_Row_BGR_SSE},
+#else
+    {Game_Bmp_Row_BGRA, Game_Bmp_Row_BGRX, Game_Bmp_Row_BGR},
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    {Game_Bmp_Row_BGRA_AVX2, Game_Bmp_Row_BGRX_AVX2, Game_Bmp_Row_BGR_AVX2},
+#else
+    {Game_Bmp_Row_BGRA, Game_Bmp_Row_BGRX, Game_Bmp_Row_BGR},
+#endif
+};
+
+/* What each kernel of the table above needs. */
+const Game_Kernel_Isa   game_bmp_kernels[GAME_KERNEL_COUNT] = {GAME_KERNEL_ISA_NONE, GAME_KERNEL_ISA_SSE41, GAME_KERNEL_ISA_AVX2};
+
+/* BGRA in memory is ARGB8888 on a little-endian machine, which every other layout is converted to. */
+static bool Game_Bmp_GetLayout(const Uint8 *bytes, size_t size, Uint32 header, Game_Bmp_Layout *layout) {
+    const Uint8 *masks;
+    Uint16  bits;
+    Uint32  compression;
+
+    bits = Game_Bmp_Read16(bytes + 28);
+    compression = Game_Bmp_Read32(bytes + 30);
+    if (bits == 24 && compression == GAME_BMP_RGB)
+        *layout = GAME_BMP_LAYOUT_BGR;
+    else if (bits == 32 && compression == GAME_BMP_RGB)
+        *layout = GAME_BMP_LAYOUT_BGRX;
+    else if (bits == 32 && compression == GAME_BMP_BITFIELDS) {
+        masks = bytes + GAME_BMP_FILE_HEADER + GAME_BMP_INFO_HEADER;
+        if (size < GAME_BMP_FILE_HEADER + GAME_BMP_INFO_HEADER + 12 || Game_Bmp_Read32(masks) != 0x00FF0000u || Game_Bmp_Read32(masks + 4) != 0x0000FF00u
+            || Game_Bmp_Read32(masks + 8) != 0x000000FFu)
+            return (false);
+        if (header >= GAME_BMP_INFO_HEADER + 16 && size >= GAME_BMP_FILE_HEADER + GAME_BMP_INFO_HEADER + 16
+            && Game_Bmp_Read32(masks + 12) == 0xFF000000u)
+            *layout = GAME_BMP_LAYOUT_BGRA;
+        else
+            *layout = GAME_BMP_LAYOUT_BGRX;
+    }
+    else
+        return (false);
+    return (true);
+}
+
+SDL_Surface *Game_Bmp_DecodeWith(const void *data, size_t size, Uint32 color_key, Game_Kernel kernel) {
+    const Uint8 *bytes;
+    Game_Bmp_Layout layout;
+    Game_Bmp_Row    row;
+    SDL_Surface *surface;
+    Uint32  header;
+    Uint32  offset;
+    Sint32  width;
+    Sint32  height;
+    size_t  rows;
+    size_t  stride;
+
+    bytes = data;
+    if (size < GAME_BMP_FILE_HEADER + GAME_BMP_INFO_HEADER || bytes[0] != 'B' || bytes[1] != 'M') {
+        SDL_SetError("not a BMP file");
+        return (NULL);
+    }
+    offset = Game_Bmp_Read32(bytes + 10);
+    header = Game_Bmp_Read32(bytes + 14);
+    width = (Sint32)Game_Bmp_Read32(bytes + 18);
+    height = (Sint32)Game_Bmp_Read32(bytes + 22);
+    rows = height < 0 ? (size_t)-(Sint64)height : (size_t)height;
+    if (header < GAME_BMP_INFO_HEADER || width <= 0 || width > GAME_BMP_MAX_SIDE || rows == 0 || rows > GAME_BMP_MAX_SIDE
+        || Game_Bmp_GetLayout(bytes, size, header, &layout) == false) {
+        SDL_SetError("BMP layout not handled by the fast path");
+        return (NULL);
+    }
+    stride = (((size_t)width * Game_Bmp_Read16(bytes + 28) + 31) / 32) * 4;
+    if (offset > size || stride * rows > size - offset) {
+        SDL_SetError("truncated BMP file");
+        return (NULL);
+    }
+    if ((surface = SDL_CreateSurface(width, (int)rows, SDL_PIXELFORMAT_ARGB8888)) == NULL)
+        return (NULL);
+    row = game_bmp_rows[SDL_min(kernel, Game_Kernel_GetBest(game_bmp_kernels))][layout];
+    color_key = color_key == GAME_BMP_NO_COLOR_KEY ? 0 : (color_key | GAME_BMP_OPAQUE);
+    for (size_t y = 0; y < rows; y++)
+        row((Uint32 *)((Uint8 *)surface->pixels + y * (size_t)surface->pitch),
+            bytes + offset + stride * (height < 0 ? y : rows - 1 - y), (size_t)width, color_key);
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    return (surface);
+}
+
+SDL_Surface *Game_Bmp_Decode(const void *data, size_t size, Uint32 color_key) {
+    return (Game_Bmp_DecodeWith(data, size, color_key, Game_Kernel_GetBest(game_bmp_kernels)));
+}
+
+/*
+** Brings what SDL_image decoded to what the fast path makes: ARGB8888, keyed
+** when the image has no alpha, premultiplied when it has, tagged
+** SDL_BLENDMODE_BLEND_PREMULTIPLIED. `surface` is consumed.
+*/
+static SDL_Surface  *Game_Bmp_Normalize(SDL_Surface *surface, Uint32 color_key) {
+    SDL_Surface *converted;
+    Uint32  *row;
+    bool    alpha;
+
+    if (surface == NULL)
+        return (NULL);
+    alpha = SDL_ISPIXELFORMAT_ALPHA(surface->format) || SDL_SurfaceHasColorKey(surface);
+    converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+    SDL_DestroySurface(surface);
+    if (converted == NULL)
+        return (NULL);
+    color_key = color_key == GAME_BMP_NO_COLOR_KEY ? 0 : (color_key | GAME_BMP_OPAQUE);
+    for (int y = 0; y < converted->h; y++) {
+        row = (Uint32 *)((Uint8 *)converted->pixels + (size_t)y * (size_t)converted->pitch);
+        for (int x = 0; x < converted->w; x++)
+            row[x] = alpha ? Game_Bmp_Premultiply(row[x]) : Game_Bmp_Key(row[x] | GAME_BMP_OPAQUE, color_key);
+    }
+    SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    return (converted);
+}
+
+/*
+** One read of the file; what the fast path does not handle goes to SDL_image
+** from the same buffer and comes out in the same form.
+*/
+SDL_Surface *Game_Bmp_Load(const char *path) {
+    SDL_Surface *surface;
+    void    *data;
+    size_t  size;
+
+    if ((data = SDL_LoadFile(path, &size)) == NULL)
+        return (NULL);
+    if ((surface = Game_Bmp_Decode(data, size, GAME_BMP_COLOR_KEY)) == NULL)
+        surface = Game_Bmp_Normalize(IMG_Load_IO(SDL_IOFromConstMem(data, size), true), GAME_BMP_COLOR_KEY);
+    SDL_free(data);
+    return (surface);
+}
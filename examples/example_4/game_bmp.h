@@ -0,0 +1,29 @@
+#ifndef GAME_BMP_H
+# define GAME_BMP_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+# include "game_kernel.h"
+
+# define GAME_BMP_MAX_SIDE 16384
+# define GAME_BMP_NO_COLOR_KEY 0xFFFFFFFFu
+/* Images without an alpha channel get this RGB color as their transparent one. */
+# define GAME_BMP_COLOR_KEY 0xFF00FFu
+
+/*
+** Direct decoder for the BMPs the game ships: 24-bit BGR and 32-bit BGRA or
+** BGRX, bottom-up or top-down. Headers are read from a memory buffer and
+** every row is converted in one pass into the ARGB8888 surface that becomes
+** the texture: the color key turns into alpha 0 and colors are premultiplied
+** by alpha, so the surface is tagged SDL_BLENDMODE_BLEND_PREMULTIPLIED and
+** SDL_CreateTextureFromSurface uploads it without converting again. Other
+** formats fail with an SDL error; Game_Bmp_Load hands them to SDL_image and
+** converts, keys and premultiplies the result the same way.
+*/
+extern const Game_Kernel_Isa    game_bmp_kernels[GAME_KERNEL_COUNT];
+
+SDL_Surface *Game_Bmp_DecodeWith(const void *data, size_t size, Uint32 color_key, Game_Kernel kernel);
+SDL_Surface *Game_Bmp_Decode(const void *data, size_t size, Uint32 color_key);
+SDL_Surface *Game_Bmp_Load(const char *path);
+
+#endif
@@ -0,0 +1,73 @@
+#include "game_camera.h"
+
+void    Game_Camera_Init(Game_Camera *this, float view_width, float view_height) {
+    this->view_width = view_width;
+    this->view_height = view_height;
+    this->x = view_width / 2;
+    this->y = view_height / 2;
+    this->zoom = 1.f;
+    this->dead_zone_width = view_width - 2 * GAME_CAMERA_DEAD_ZONE_MARGIN_X;
+    this->dead_zone_height = view_height - 2 * GAME_CAMERA_DEAD_ZONE_MARGIN_Y;
+    this->smoothing = GAME_CAMERA_SMOOTHING;
+    this->snap = true;
+}
+
+void    Game_Camera_LookAt(Game_Camera *this, float x, float y) {
+    this->x = x;
+    this->y = y;
+}
+
+void    Game_Camera_SetZoom(Game_Camera *this, float zoom) {
+    this->zoom = SDL_clamp(zoom, GAME_CAMERA_ZOOM_MIN, GAME_CAMERA_ZOOM_MAX);
+}
+
+static float    Game_Camera_DeadZoneTarget(float center, float target, float half_zone) {
+    if (target < center - half_zone)
+        return (target + half_zone);
+    if (target > center + half_zone)
+        return (target - half_zone);
+    return (center);
+}
+
+void    Game_Camera_Follow(Game_Camera *this, float x, float y, float delta) {
+    float   blend;
+
+    blend = 1.f - SDL_expf(-this->smoothing * delta);
+    this->x += (Game_Camera_DeadZoneTarget(this->x, x, this->dead_zone_width / (2 * this->zoom)) - this->x) * blend;
+    this->y += (Game_Camera_DeadZoneTarget(this->y, y, this->dead_zone_height / (2 * this->zoom)) - this->y) * blend;
+}
+
+/*
+** With snapping on, the offset is rounded so that integer world positions
+** land on whole output pixels (`pixel_scale` is the render target scale):
+** a slowly scrolling camera then moves the scene by whole pixels instead of
+** resampling every sprite at a new sub-pixel phase each frame.
+*/
+Game_Camera_View    Game_Camera_GetView(const Game_Camera *this, float pixel_scale, float culling_margin) {
+    Game_Camera_View    view;
+    float   half_width;
+    float   half_height;
+    float   margin;
+    float   pixels;
+
+    half_width = this->view_width / (2 * this->zoom);
+    half_height = this->view_height / (2 * this->zoom);
+    view.zoom = this->zoom;
+    view.scale = this->zoom * pixel_scale;
+    view.offset_x = half_width - this->x;
+    view.offset_y = half_height - this->y;
+    if (this->snap) {
+        pixels = this->zoom * pixel_scale;
+        view.offset_x = SDL_roundf(view.offset_x * pixels) / pixels;
+        view.offset_y = SDL_roundf(view.offset_y * pixels) / pixels;
+    }
+    margin = culling_margin / this->zoom;
+    view.bounds = (SDL_FRect){-view.offset_x - margin, -view.offset_y - margin,
+        2 * (half_width + margin), 2 * (half_height + margin)};
+    return (view);
+}
+
+bool    Game_Camera_View_IsVisible(const Game_Camera_View *this, float x, float y, float width, float height) {
+    return (x + width > this->bounds.x && x < this->bounds.x + this->bounds.w
+        && y + height > this->bounds.y && y < this->bounds.y + this->bounds.h);
+}
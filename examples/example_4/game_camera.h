@@ -0,0 +1,53 @@
+#ifndef GAME_CAMERA_H
+# define GAME_CAMERA_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_CAMERA_ZOOM_MIN 0.5f
+# define GAME_CAMERA_ZOOM_MAX 4.f
+# define GAME_CAMERA_ZOOM_STEP 1.25f
+# define GAME_CAMERA_SMOOTHING 8.f
+# define GAME_CAMERA_DEAD_ZONE_MARGIN_X 320.f
+# define GAME_CAMERA_DEAD_ZONE_MARGIN_Y 200.f
+
+/*
+** The camera centres the view on the world point (x, y). The target may
+** wander inside the dead zone (screen pixels around the centre) without
+** moving the camera; outside it the camera eases towards the target at a
+** rate of `smoothing` per second.
+*/
+typedef struct Game_Camera {
+    float   x;
+    float   y;
+    float   zoom;
+    float   view_width;
+    float   view_height;
+    float   dead_zone_width;
+    float   dead_zone_height;
+    float   smoothing;
+    bool    snap;
+}   Game_Camera;
+
+/*
+** Computed once per frame. The renderer scale carries the zoom, so a world
+** position maps to renderer coordinates by adding the offset only. `scale`
+** is output pixels per world unit, zoom and render scale together. `bounds`
+** is the visible world rectangle grown by the culling margin.
+*/
+typedef struct Game_Camera_View {
+    float   offset_x;
+    float   offset_y;
+    float   zoom;
+    float   scale;
+    SDL_FRect   bounds;
+}   Game_Camera_View;
+
+void    Game_Camera_Init(Game_Camera *this, float view_width, float view_height);
+void    Game_Camera_LookAt(Game_Camera *this, float x, float y);
+void    Game_Camera_SetZoom(Game_Camera *this, float zoom);
+void    Game_Camera_Follow(Game_Camera *this, float x, float y, float delta);
+Game_Camera_View    Game_Camera_GetView(const Game_Camera *this, float pixel_scale, float culling_margin);
+bool    Game_Camera_View_IsVisible(const Game_Camera_View *this, float x, float y, float width, float height);
+
+#endif
@@ -0,0 +1,286 @@
+#include "game_capture.h"
+#include "game_memory.h"
+
+static size_t   Game_Capture_Align(size_t bytes) {
+    return ((bytes + GAME_CAPTURE_ALIGNMENT - 1) & ~(size_t)(GAME_CAPTURE_ALIGNMENT - 1));
+}
+
+void    Game_Capture_Init(Game_Capture *this) {
+    SDL_zerop(this);
+    this->scale = 1;
+    this->every = 1;
+}
+
+bool    Game_Capture_IsOpen(const Game_Capture *this) {
+    return (this->file != NULL);
+}
+
+/* Box filter: each output pixel is the per-channel mean of a scale x scale block, scale being 2 or 4. */
+static void Game_Capture_Downscale(Game_Capture *this, const Uint32 *source) {
+    const Uint32    *row;
+    Uint32  sums[4];
+    Uint32  pixel;
+    int     shift;
+
+    shift = this->scale == 2 ? 2 : 4;
+    for (int y = 0; y < this->output_height; y++)
+        for (int x = 0; x < this->output_width; x++) {
+            SDL_zeroa(sums);
+            for (int dy = 0; dy < this->scale; dy++) {
+                row = source + (size_t)(y * this->scale + dy) * (size_t)this->width + (size_t)(x * this->scale);
+                for (int dx = 0; dx < this->scale; dx++) {
+                    pixel = row[dx];
+                    sums[0] += pixel >> 24;
+                    sums[1] += (pixel >> 16) & 0xFF;
+                    sums[2] += (pixel >> 8) & 0xFF;
+                    sums[3] += pixel & 0xFF;
+                }
+            }
+            this->scaled[(size_t)y * (size_t)this->output_width + (size_t)x] = (sums[0] >> shift) << 24
+                | (sums[1] >> shift) << 16 | (sums[2] >> shift) << 8 | sums[3] >> shift;
+        }
+}
+
+/* Full-range BT.601, 8-bit fixed point; chroma from the mean of each 2x2 block. */
+static void Game_Capture_ToYCbCr(Game_Capture *this, const Uint32 *source, size_t stride) {
+    const Uint32    *row;
+    Uint8   *luma;
+    Uint8   *blue;
+    Uint8   *red;
+    Uint32  pixel;
+    int     r;
+    int     g;
+    int     b;
+
+    luma = this->planes;
+    blue = luma + (size_t)this->output_width * (size_t)this->output_height;
+    red = blue + (size_t)(this->output_width / 2) * (size_t)(this->output_height / 2);
+    for (int y = 0; y < this->output_height; y++) {
+        row = source + (size_t)y * stride;
+        for (int x = 0; x < this->output_width; x++) {
+            pixel = row[x];
+            luma[(size_t)y * (size_t)this->output_width + (size_t)x] = (Uint8)((77 * ((pixel >> 16) & 0xFF)
+                + 150 * ((pixel >> 8) & 0xFF) + 29 * (pixel & 0xFF) + 128) >> 8);
+        }
+    }
+    for (int y = 0; y < this->output_height / 2; y++)
+        for (int x = 0; x < this->output_width / 2; x++) {
+            r = 0;
+            g = 0;
+            b = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                row = source + (size_t)(y * 2 + dy) * stride + (size_t)(x * 2);
+                for (int dx = 0; dx < 2; dx++) {
+                    r += (int)((row[dx] >> 16) & 0xFF);
+                    g += (int)((row[dx] >> 8) & 0xFF);
+                    b += (int)(row[dx] & 0xFF);
+                }
+            }
+            r = (r + 2) / 4;
+            g = (g + 2) / 4;
+            b = (b + 2) / 4;
+            blue[(size_t)y * (size_t)(this->output_width / 2) + (size_t)x] = (Uint8)(((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128);
+            red[(size_t)y * (size_t)(this->output_width / 2) + (size_t)x] = (Uint8)(((128 * r - 107 * g - 21 * b + 128) >> 8) + 128);
+        }
+}
+
+/* Encoder thread. A full-size capture is read straight from its slot. */
+static void Game_Capture_Encode(Game_Capture *this, const Uint32 *slot) {
+    const Uint32    *source;
+    size_t  stride;
+    size_t  row_bytes;
+    Uint64  start;
+    bool    written;
+
+    start = SDL_GetTicksNS();
+    source = slot;
+    stride = (size_t)this->width;
+    if (this->scale > 1) {
+        Game_Capture_Downscale(this, slot);
+        source = this->scaled;
+        stride = (size_t)this->output_width;
+    }
+    if (this->format == GAME_CAPTURE_Y4M) {
+        Game_Capture_ToYCbCr(this, source, stride);
+        written = SDL_WriteIO(this->file, "FRAME\n", 6) == 6
+            && SDL_WriteIO(this->file, this->planes, this->frame_bytes) == this->frame_bytes;
+    }
+    else {
+        row_bytes = sizeof(Uint32) * (size_t)this->output_width;
+        written = true;
+        for (int y = 0; y < this->output_height && written; y++)
+            written = SDL_WriteIO(this->file, source + (size_t)y * stride, row_bytes) == row_bytes;
+    }
+    if (written)
+        this->written++;
+    this->encode_ns += SDL_GetTicksNS() - start;
+}
+
+static int  Game_Capture_Main(void *data) {
+    Game_Capture    *this;
+    const Uint32    *slot;
+
+    this = data;
+    SDL_LockMutex(this->mutex);
+    while (true) {
+        while (this->tail == this->head && this->quit == false)
+            SDL_WaitCondition(this->ready, this->mutex);
+        if (this->tail == this->head)
+            break ;
+        slot = this->slots[this->tail % GAME_CAPTURE_SLOTS];
+        SDL_UnlockMutex(this->mutex);
+        Game_Capture_Encode(this, slot);
+        SDL_LockMutex(this->mutex);
+        this->tail++;
+    }
+    SDL_UnlockMutex(this->mutex);
+    return (0);
+}
+
+static bool Game_Capture_Allocate(Game_Capture *this) {
+    size_t  slot_bytes;
+    size_t  scaled_bytes;
+    char    *cursor;
+
+    slot_bytes = Game_Capture_Align(sizeof(Uint32) * (size_t)this->width * (size_t)this->height);
+    scaled_bytes = this->scale > 1 ? Game_Capture_Align(sizeof(Uint32) * (size_t)this->output_width * (size_t)this->output_height) : 0;
+    this->frame_bytes = this->format == GAME_CAPTURE_Y4M ? (size_t)this->output_width * (size_t)this->output_height * 3 / 2
+        : sizeof(Uint32) * (size_t)this->output_width * (size_t)this->output_height;
+    this->block_bytes = slot_bytes * GAME_CAPTURE_SLOTS + scaled_bytes
+        + (this->format == GAME_CAPTURE_Y4M ? Game_Capture_Align(this->frame_bytes) : 0);
+    if ((this->block = SDL_aligned_alloc(GAME_CAPTURE_ALIGNMENT, this->block_bytes)) == NULL) {
+        this->block_bytes = 0;
+        return (false);
+    }
+    Game_Memory_Add(GAME_MEMORY_CAPTURE, (Sint64)this->block_bytes);
+    cursor = this->block;
+    for (size_t slot = 0; slot < GAME_CAPTURE_SLOTS; slot++, cursor += slot_bytes)
+        this->slots[slot] = (Uint32 *)cursor;
+    this->scaled = scaled_bytes != 0 ? (Uint32 *)cursor : NULL;
+    this->planes = this->format == GAME_CAPTURE_Y4M ? (Uint8 *)(cursor + scaled_bytes) : NULL;
+    return (true);
+}
+
+/*
+** `path` ending in .y4m gets a YUV4MPEG2 stream any player or ffmpeg reads;
+** anything else gets headerless BGRA frames of the size Game_Capture_Print
+** reports. The frame size is the renderer's output size divided by `scale`
+** (1, 2 or 4), rounded down to even for Y4M. The nominal frame rate is
+** `fps` / `every`. Nothing is left open on failure.
+*/
+bool    Game_Capture_Open(Game_Capture *this, SDL_Renderer *renderer, const char *path, int scale, size_t every, int fps) {
+    size_t  length;
+
+    Game_Capture_Init(this);
+    if (scale != 1 && scale != 2 && scale != 4) {
+        SDL_SetError("capture scale must be 1, 2 or 4");
+        return (false);
+    }
+    if (every == 0 || SDL_GetRenderOutputSize(renderer, &this->width, &this->height) == false)
+        return (false);
+    length = SDL_strlen(path);
+    this->format = length >= 4 && SDL_strcasecmp(path + length - 4, ".y4m") == 0 ? GAME_CAPTURE_Y4M : GAME_CAPTURE_RAW;
+    this->scale = scale;
+    this->every = every;
+    this->output_width = this->width / scale;
+    this->output_height = this->height / scale;
+    if (this->format == GAME_CAPTURE_Y4M) {
+        this->output_width &= ~1;
+        this->output_height &= ~1;
+    }
+    if (this->output_width == 0 || this->output_height == 0) {
+        SDL_SetError("%dx%d is too small to capture at scale %d", this->width, this->height, scale);
+        return (false);
+    }
+    if (Game_Capture_Allocate(this) == false || (this->file = SDL_IOFromFile(path, "wb")) == NULL
+        || (this->format == GAME_CAPTURE_Y4M && SDL_IOprintf(this->file, "YUV4MPEG2 W%d H%d F%d:%zu Ip A1:1 C420jpeg\n",
+            this->output_width, this->output_height, fps, every) == 0)
+        || (this->mutex = SDL_CreateMutex()) == NULL || (this->ready = SDL_CreateCondition()) == NULL
+        || (this->thread = SDL_CreateThread(Game_Capture_Main, "game_capture", this)) == NULL) {
+        Game_Capture_Close(this);
+        return (false);
+    }
+    return (true);
+}
+
+/*
+** Render thread, after the frame is drawn and before it is presented.
+** A readback of another size (the window was resized) is cropped or padded
+** with black to the size the capture was opened with.
+*/
+void    Game_Capture_Frame(Game_Capture *this, SDL_Renderer *renderer) {
+    SDL_Surface *surface;
+    SDL_Surface *converted;
+    Uint32  *slot;
+    Uint64  start;
+    bool    full;
+    int     rows;
+
+    if (this->file == NULL || this->frames++ % this->every != 0)
+        return ;
+    SDL_LockMutex(this->mutex);
+    full = this->head - this->tail == GAME_CAPTURE_SLOTS;
+    SDL_UnlockMutex(this->mutex);
+    if (full) {
+        this->dropped++;
+        return ;
+    }
+    start = SDL_GetTicksNS();
+    if ((surface = SDL_RenderReadPixels(renderer, NULL)) != NULL && surface->format != SDL_PIXELFORMAT_ARGB8888) {
+        converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+        SDL_DestroySurface(surface);
+        surface = converted;
+    }
+    if (surface == NULL) {
+        this->failed++;
+        return ;
+    }
+    slot = this->slots[this->head % GAME_CAPTURE_SLOTS];
+    if (surface->w != this->width || surface->h != this->height)
+        SDL_memset(slot, 0, sizeof(Uint32) * (size_t)this->width * (size_t)this->height);
+    rows = SDL_min(surface->h, this->height);
+    for (int y = 0; y < rows; y++)
+        SDL_memcpy(slot + (size_t)y * (size_t)this->width, (Uint8 *)surface->pixels + (size_t)y * (size_t)surface->pitch,
+            sizeof(Uint32) * (size_t)SDL_min(surface->w, this->width));
+    SDL_DestroySurface(surface);
+    this->readback_ns += SDL_GetTicksNS() - start;
+    this->captured++;
+    SDL_LockMutex(this->mutex);
+    this->head++;
+    SDL_SignalCondition(this->ready);
+    SDL_UnlockMutex(this->mutex);
+}
+
+void    Game_Capture_Print(const Game_Capture *this, FILE *output) {
+    fprintf(output, "capture       %zu of %zu frames written, %zu dropped, %zu failed reads, %dx%d %s\n",
+        this->written, this->frames, this->dropped, this->failed, this->output_width, this->output_height,
+        this->format == GAME_CAPTURE_Y4M ? "y4m 4:2:0" : "raw bgra");
+    fprintf(output, "capture ms    readback %.3f avg (render thread), encode %.3f avg (encoder thread)\n",
+        this->captured != 0 ? (double)this->readback_ns / (double)this->captured / 1e6 : 0.0,
+        this->written != 0 ? (double)this->encode_ns / (double)this->written / 1e6 : 0.0);
+}
+
+/* Lets the encoder finish every frame already captured; the counters survive for Game_Capture_Print. */
+void    Game_Capture_Close(Game_Capture *this) {
+    if (this->thread != NULL) {
+        SDL_LockMutex(this->mutex);
+        this->quit = true;
+        SDL_SignalCondition(this->ready);
+        SDL_UnlockMutex(this->mutex);
+        SDL_WaitThread(this->thread, NULL);
+        this->thread = NULL;
+    }
+    SDL_DestroyCondition(this->ready);
+    SDL_DestroyMutex(this->mutex);
+    SDL_CloseIO(this->file);
+    Game_Memory_Add(GAME_MEMORY_CAPTURE, -(Sint64)this->block_bytes);
+    SDL_aligned_free(this->block);
+    this->ready = NULL;
+    this->mutex = NULL;
+    this->file = NULL;
+    this->block = NULL;
+    this->block_bytes = 0;
+    SDL_zeroa(this->slots);
+    this->scaled = NULL;
+    this->planes = NULL;
+}
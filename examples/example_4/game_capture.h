@@ -0,0 +1,63 @@
+#ifndef GAME_CAPTURE_H
+# define GAME_CAPTURE_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_CAPTURE_SLOTS 4
+# define GAME_CAPTURE_ALIGNMENT 64
+
+typedef enum Game_Capture_Format {
+    GAME_CAPTURE_Y4M,
+    GAME_CAPTURE_RAW,
+}   Game_Capture_Format;
+
+/*
+** Gameplay recording. The render thread reads each captured frame back right
+** before it is presented and copies it into one of GAME_CAPTURE_SLOTS
+** preallocated ARGB8888 buffers; an encoder thread box-downscales it by
+** `scale`, converts it (Y4M: 4:2:0 full-range YCbCr, raw: BGRA bytes) and
+** writes it out. When the encoder is a whole ring behind, the frame is
+** dropped and counted rather than waited for: the readback itself is the
+** only cost the frame pays. `every` keeps one frame in that many.
+** `head` and `tail` are guarded by `mutex`; a slot between them belongs to
+** the encoder.
+*/
+typedef struct Game_Capture {
+    SDL_IOStream    *file;
+    Game_Capture_Format format;
+    int     width;
+    int     height;
+    int     scale;
+    int     output_width;
+    int     output_height;
+    size_t  every;
+    Uint32  *slots[GAME_CAPTURE_SLOTS];
+    Uint32  *scaled;
+    Uint8   *planes;
+    size_t  frame_bytes;
+    void    *block;
+    size_t  block_bytes;
+    SDL_Thread  *thread;
+    SDL_Mutex   *mutex;
+    SDL_Condition   *ready;
+    size_t  head;
+    size_t  tail;
+    bool    quit;
+    size_t  frames;
+    size_t  captured;
+    size_t  dropped;
+    size_t  failed;
+    size_t  written;
+    Uint64  readback_ns;
+    Uint64  encode_ns;
+}   Game_Capture;
+
+void    Game_Capture_Init(Game_Capture *this);
+bool    Game_Capture_Open(Game_Capture *this, SDL_Renderer *renderer, const char *path, int scale, size_t every, int fps);
+void    Game_Capture_Frame(Game_Capture *this, SDL_Renderer *renderer);
+bool    Game_Capture_IsOpen(const Game_Capture *this);
+void    Game_Capture_Print(const Game_Capture *this, FILE *output);
+void    Game_Capture_Close(Game_Capture *this);
+
+#endif
@@ -0,0 +1,216 @@
+#include "game_collision.h"
+#include "game_memory.h"
+
+/*
+** One 64-column window of a shape, over the rows that overlap: `words` is
+** its first row in the chunk the window starts in, `next` the distance to
+** the same row one chunk to the right, `shift` the window's bit offset.
+*/
+typedef struct Game_Collision_Run {
+    const Uint64    *words;
+    size_t  next;
+    int     shift;
+}   Game_Collision_Run;
+
+/* Whether any of `rows` rows has a bit set in both windows and in `keep`. */
+typedef bool    (*Game_Collision_Rows)(Game_Collision_Run a, Game_Collision_Run b, Uint64 keep, size_t rows);
+
+void    Game_Collision_Mask_Init(Game_Collision_Mask *this) {
+    SDL_zerop(this);
+}
+
+/*
+** Packs the surface's alpha into the mask. The size is kept even when the
+** words cannot be allocated, so the texture still collides as a box.
+*/
+bool    Game_Collision_Mask_Build(Game_Collision_Mask *this, SDL_Surface *surface) {
+    SDL_Surface *converted;
+    const Uint32    *pixels;
+    size_t  bytes;
+
+    Game_Collision_Mask_Destroy(this);
+    if (surface == NULL || surface->w <= 0 || surface->h <= 0)
+        return (false);
+    this->width = surface->w;
+    this->height = surface->h;
+    this->chunks = ((size_t)surface->w + 63) / 64 + 1;
+    bytes = sizeof(Uint64) * this->chunks * (size_t)surface->h;
+    converted = surface->format == SDL_PIXELFORMAT_ARGB8888 ? surface : SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+    if (converted == NULL || (this->words = SDL_aligned_alloc(GAME_COLLISION_ALIGNMENT, bytes)) == NULL) {
+        if (converted != surface)
+            SDL_DestroySurface(converted);
+        return (false);
+    }
+    this->bytes = bytes;
+    Game_Memory_Add(GAME_MEMORY_COLLISION, (Sint64)bytes);
+    SDL_memset(this->words, 0, bytes);
+    for (int y = 0; y < this->height; y++) {
+        pixels = (const Uint32 *)((const Uint8 *)converted->pixels + (size_t)y * (size_t)converted->pitch);
+        for (int x = 0; x < this->width; x++)
+            if (pixels[x] >> 24 >= GAME_COLLISION_ALPHA)
+                this->words[(size_t)(x / 64) * (size_t)this->height + (size_t)y] |= (Uint64)1 << (x % 64);
+    }
+    if (converted != surface)
+        SDL_DestroySurface(converted);
+    return (true);
+}
+
+void    Game_Collision_Mask_Destroy(Game_Collision_Mask *this) {
+    Game_Memory_Add(GAME_MEMORY_COLLISION, -(Sint64)this->bytes);
+    SDL_aligned_free(this->words);
+    SDL_zerop(this);
+}
+
+/* Whole pixels, and a source clipped to the mask; NULL stands for the whole mask. */
+Game_Collision_Shape    Game_Collision_Shape_Make(const Game_Collision_Mask *mask, const SDL_FRect *source, float x, float y) {
+    Game_Collision_Shape    shape;
+    int     left;
+    int     top;
+
+    shape.mask = mask;
+    shape.x = (int)SDL_floorf(x);
+    shape.y = (int)SDL_floorf(y);
+    if (source == NULL) {
+        shape.source = (SDL_Rect){0, 0, mask->width, mask->height};
+        return (shape);
+    }
+    left = SDL_clamp((int)source->x, 0, mask->width);
+    top = SDL_clamp((int)source->y, 0, mask->height);
+    shape.source = (SDL_Rect){left, top, SDL_clamp((int)source->w, 0, mask->width - left),
+        SDL_clamp((int)source->h, 0, mask->height - top)};
+    return (shape);
+}
+
+/* A shift of 0 must not reach the next word: x << 64 is undefined. */
+static inline Uint64    Game_Collision_Window(const Uint64 *word, size_t next, int shift) {
+    return (shift == 0 ? word[0] : word[0] >> shift | word[next] << (64 - shift));
+}
+
+static bool Game_Collision_Rows_Scalar(Game_Collision_Run a, Game_Collision_Run b, Uint64 keep, size_t rows) {
+    for (size_t row = 0; row < rows; row++)
+        if ((Game_Collision_Window(a.words + row, a.next, a.shift) & Game_Collision_Window(b.words + row, b.next, b.shift) & keep) != 0)
+            return (true);
+    return (false);
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Two rows per vector. A vector shift by 64 yields 0, so a shift of 0 needs no special case here. */
+SDL_TARGETING("sse2") static bool Game_Collision_Rows_SSE(Game_Collision_Run a, Game_Collision_Run b, Uint64 keep, size_t rows) {
+    __m128i a_right;
+    __m128i a_left;
+    __m128i b_right;
+    __m128i b_left;
+    __m128i both;
+    size_t  row;
+
+    a_right = _mm_cvtsi32_si128(a.shift);
+    a_left = _mm_cvtsi32_si128(64 - a.shift);
+    b_right = _mm_cvtsi32_si128(b.shift);
+    b_left = _mm_cvtsi32_si128(64 - b.shift);
+    for (row = 0; row + 2 <= rows; row += 2) {
+        both = _mm_and_si128(
+            _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128((const __m128i *)(a.words + row)), a_right),
+                _mm_sll_epi64(_mm_loadu_si128((const __m128i *)(a.words + a.next + row)), a_left)),
+            _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128((const __m128i *)(b.words + row)), b_right),
+                _mm_sll_epi64(_mm_loadu_si128((const __m128i *)(b.words + b.next + row)), b_left)));
+        both = _mm_and_si128(both, _mm_set1_epi64x((long long)keep));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(both, _mm_setzero_si128())) != 0xFFFF)
+            return (true);
+    }
+    a.words += row;
+    b.words += row;
+    return (Game_Collision_Rows_Scalar(a, b, keep, rows - row));
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2") static bool Game_Collision_Rows_AVX2(Game_Collision_Run a, Game_Collision_Run b, Uint64 keep, size_t rows) {
+    __m128i a_right;
+    __m128i a_left;
+    __m128i b_right;
+    __m128i b_left;
+    __m256i both;
+    size_t  row;
+
+    a_right = _mm_cvtsi32_si128(a.shift);
+    a_left = _mm_cvtsi32_si128(64 - a.shift);
+    b_right = _mm_cvtsi32_si128(b.shift);
+    b_left = _mm_cvtsi32_si128(64 - b.shift);
+    for (row = 0; row + 4 <= rows; row += 4) {
+        both = _mm256_and_si256(
+            _mm256_or_si256(_mm256_srl_epi64(_mm256_loadu_si256((const __m256i *)(a.words + row)), a_right),
+                _mm256_sll_epi64(_mm256_loadu_si256((const __m256i *)(a.words + a.next + row)), a_left)),
+            _mm256_or_si256(_mm256_srl_epi64(_mm256_loadu_si256((const __m256i *)(b.words + row)), b_right),
+                _mm256_sll_epi64(_mm256_loadu_si256((const __m256i *)(b.words + b.next + row)), b_left)));
+        if (_mm256_testz_si256(both, _mm256_set1_epi64x((long long)keep)) == 0)
+            return (true);
+    }
+    a.words += row;
+    b.words += row;
+    return (Game_Collision_Rows_Scalar(a, b, keep, rows - row));
+}
+#endif
+
+static const Game_Collision_Rows    game_collision_rows[GAME_KERNEL_COUNT] = {
+    Game_Collision_Rows_Scalar,
+#ifdef SDL_SSE2_INTRINSICS
+    Game_Collision_Rows_SSE,
+#else
+    Game_Collision_Rows_Scalar,
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    Game_Collision_Rows_AVX2,
+#else
+    Game_Collision_Rows_Scalar,
+#endif
+};
+
+/* What each kernel of the table above needs. */
+const Game_Kernel_Isa   game_collision_kernels[GAME_KERNEL_COUNT] = {GAME_KERNEL_ISA_NONE, GAME_KERNEL_ISA_SSE2, GAME_KERNEL_ISA_AVX2};
+
+static Game_Collision_Run   Game_Collision_GetRun(const Game_Collision_Shape *shape, int column, int row) {
+    return ((Game_Collision_Run){shape->mask->words + (size_t)(column / 64) * (size_t)shape->mask->height + (size_t)row,
+        (size_t)shape->mask->height, column % 64});
+}
+
+/*
+** Box test first: most pairs stop at the four comparisons. The overlap is
+** then walked one 64-column window at a time, each window over all the
+** overlapping rows; `keep` cuts the last window at the overlap's right edge
+** so bits past a sprite-sheet frame never count. `kernel` is taken as
+** given, so it must be one this CPU runs: callers pick it once, as
+** Game_Collision_Test does. Returns at the first shared pixel.
+*/
+bool    Game_Collision_TestWith(const Game_Collision_Shape *a, const Game_Collision_Shape *b, Game_Kernel kernel) {
+    Game_Collision_Rows rows;
+    int     left;
+    int     top;
+    int     width;
+    int     height;
+    Uint64  keep;
+
+    left = SDL_max(a->x, b->x);
+    top = SDL_max(a->y, b->y);
+    width = SDL_min(a->x + a->source.w, b->x + b->source.w) - left;
+    height = SDL_min(a->y + a->source.h, b->y + b->source.h) - top;
+    if (width <= 0 || height <= 0)
+        return (false);
+    if (a->mask->words == NULL || b->mask->words == NULL)
+        return (true);
+    rows = game_collision_rows[kernel];
+    for (int column = 0; column < width; column += 64) {
+        keep = width - column >= 64 ? ~(Uint64)0 : ((Uint64)1 << (width - column)) - 1;
+        if (rows(Game_Collision_GetRun(a, a->source.x + left - a->x + column, a->source.y + top - a->y),
+            Game_Collision_GetRun(b, b->source.x + left - b->x + column, b->source.y + top - b->y), keep, (size_t)height))
+            return (true);
+    }
+    return (false);
+}
+
+bool    Game_Collision_Test(const Game_Collision_Shape *a, const Game_Collision_Shape *b) {
+    static Game_Kernel  kernel = GAME_KERNEL_COUNT;
+
+    if (kernel == GAME_KERNEL_COUNT)
+        kernel = Game_Kernel_GetBest(game_collision_kernels);
+    return (Game_Collision_TestWith(a, b, kernel));
+}
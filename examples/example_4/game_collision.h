@@ -0,0 +1,49 @@
+#ifndef GAME_COLLISION_H
+# define GAME_COLLISION_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+# include "game_kernel.h"
+
+/* Pixels at least this opaque are solid. */
+# define GAME_COLLISION_ALPHA 0x80
+# define GAME_COLLISION_ALIGNMENT 64
+
+/*
+** One bit per pixel, set where the texture is solid, packed 64 columns to a
+** word with column 0 in the lowest bit. Words are stored column-chunk major,
+** `words[chunk * height + row]`, so one chunk of consecutive rows is
+** contiguous and a vector covers several rows at the same shift. A trailing
+** chunk of zeros lets any 64-bit window starting inside the mask read its
+** next word. A mask without words (not built, or built from nothing) makes
+** every test a box test.
+*/
+typedef struct Game_Collision_Mask {
+    Uint64  *words;
+    size_t  bytes;
+    size_t  chunks;
+    int     width;
+    int     height;
+}   Game_Collision_Mask;
+
+/*
+** A mask placed in the world: `source`, a rectangle inside the mask (a
+** sprite-sheet frame, or the whole mask), has its top-left at `x`, `y`.
+*/
+typedef struct Game_Collision_Shape {
+    const Game_Collision_Mask   *mask;
+    SDL_Rect    source;
+    int     x;
+    int     y;
+}   Game_Collision_Shape;
+
+extern const Game_Kernel_Isa    game_collision_kernels[GAME_KERNEL_COUNT];
+
+void    Game_Collision_Mask_Init(Game_Collision_Mask *this);
+bool    Game_Collision_Mask_Build(Game_Collision_Mask *this, SDL_Surface *surface);
+void    Game_Collision_Mask_Destroy(Game_Collision_Mask *this);
+Game_Collision_Shape    Game_Collision_Shape_Make(const Game_Collision_Mask *mask, const SDL_FRect *source, float x, float y);
+bool    Game_Collision_TestWith(const Game_Collision_Shape *a, const Game_Collision_Shape *b, Game_Kernel kernel);
+bool    Game_Collision_Test(const Game_Collision_Shape *a, const Game_Collision_Shape *b);
+
+#endif
@@ -0,0 +1,146 @@
+#include "game_config.h"
+#include "SDL_lib.h"
+
+void    Game_Config_Init(Game_Config *this) {
+    this->stress_sprites = 0;
+    this->stress_particles = 0;
+    this->frame_limit = 0;
+    this->offscreen = false;
+    this->adaptive = -1;
+    this->render_scale = 0.f;
+    this->zoom = 0.f;
+    this->mipmaps = true;
+    this->render_linear = true;
+    this->animated = false;
+    this->pipelined = false;
+    this->chase = false;
+    this->hud = false;
+    this->capture_path = NULL;
+    this->capture_scale = 1;
+    this->capture_every = 1;
+    this->paused = false;
+    this->idle_wake_ms = 0;
+    this->player_script_path = NULL;
+    this->sprite_script_path = NULL;
+    this->restore_path = NULL;
+}
+
+bool    Game_Config_IsStress(const Game_Config *this) {
+    return (this->stress_sprites != 0 || this->stress_particles != 0);
+}
+
+void    Game_Config_PrintUsage(const char *name) {
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  --stress <sprites>   run the stress scene with <sprites> moving sprites and print frame statistics\n"
+        "  --particles <count>  keep <count> particles alive in the stress scene\n"
+        "  --frames <count>     stop after <count> frames (stress default: %d)\n"
+        "  --animated           animate the stress sprites from 2x2 sprite-sheet clips\n"
+        "  --chase              boo sprites in the stress scene chase the player along a flow field\n"
+        "  --restore <path>     start from a snapshot written by F5 (F9 reloads the last one)\n"
+        "  --pipelined          simulate frame N+1 on a second thread while frame N renders\n"
+        "  --offscreen          render into an offscreen surface instead of a window\n"
+        "  --hud                start with the performance overlay shown (F1 toggles it)\n"
+        "  --capture <path>     record the frames to <path>: YUV4MPEG2 if it ends in .y4m, raw BGRA otherwise\n"
+        "  --capture-scale <n>  record at 1/n of the output size (1, 2 or 4)\n"
+        "  --capture-every <n>  record one frame in <n>\n"
+        "  --paused             start paused (P toggles it); paused, minimised or unfocused, the game sleeps until an event\n"
+        "  --idle-wake <ms>     while idle, also wake and redraw every <ms> milliseconds\n"
+        "  --player-script <p>  move the player with the behaviour script at <p> instead of the built-in commands\n"
+        "  --sprite-script <p>  run the behaviour script at <p> on every sprite each step\n"
+        "  --adaptive           adapt frame rate, vsync and quality to the measured frame cost\n"
+        "                       (default, except in the stress scene)\n"
+        "  --no-adaptive        keep 60 fps and full quality whatever the frame cost\n"
+        "  --zoom <z>           start with the camera zoomed to z (0.5 to 4)\n"
+        "  --no-mips            draw every sprite from its full-size texture whatever the zoom\n"
+        "  --render-scale <s>   draw the scene at s * window size (0.25 to 1) and upscale it\n"
+        "  --render-filter <f>  upscale filter: nearest or linear (default)\n"
+        "                       PageUp/PageDown change the scale at runtime, F2 toggles the filter\n"
+        "                       = and - zoom the camera in and out, F3 prints the memory accounting\n"
+        "                       F1 shows or hides the performance overlay\n",
+        name, GAME_CONFIG_DEFAULT_STRESS_FRAMES);
+}
+
+static bool Game_Config_ParseSize(const char *text, size_t *value) {
+    char    *end;
+    unsigned long long  parsed;
+
+    parsed = SDL_strtoull(text, &end, 10);
+    if (end == text || *end != '\0')
+        return (false);
+    *value = (size_t)parsed;
+    return (true);
+}
+
+bool    Game_Config_Parse(Game_Config *this, int argc, char **argv) {
+    for (int index = 1; index < argc; index++) {
+        if (SDL_strcmp(argv[index], "--stress") == 0 && index + 1 < argc) {
+            if (Game_Config_ParseSize(argv[++index], &this->stress_sprites) == false)
+                return (false);
+        }
+        else if (SDL_strcmp(argv[index], "--particles") == 0 && index + 1 < argc) {
+            if (Game_Config_ParseSize(argv[++index], &this->stress_particles) == false)
+                return (false);
+        }
+        else if (SDL_strcmp(argv[index], "--frames") == 0 && index + 1 < argc) {
+            if (Game_Config_ParseSize(argv[++index], &this->frame_limit) == false)
+                return (false);
+        }
+        else if (SDL_strcmp(argv[index], "--animated") == 0)
+            this->animated = true;
+        else if (SDL_strcmp(argv[index], "--chase") == 0)
+            this->chase = true;
+        else if (SDL_strcmp(argv[index], "--restore") == 0 && index + 1 < argc)
+            this->restore_path = argv[++index];
+        else if (SDL_strcmp(argv[index], "--pipelined") == 0)
+            this->pipelined = true;
+        else if (SDL_strcmp(argv[index], "--offscreen") == 0)
+            this->offscreen = true;
+        else if (SDL_strcmp(argv[index], "--hud") == 0)
+            this->hud = true;
+        else if (SDL_strcmp(argv[index], "--capture") == 0 && index + 1 < argc)
+            this->capture_path = argv[++index];
+        else if (SDL_strcmp(argv[index], "--capture-scale") == 0 && index + 1 < argc) {
+            if (Game_Config_ParseSize(argv[++index], &this->capture_scale) == false
+                || (this->capture_scale != 1 && this->capture_scale != 2 && this->capture_scale != 4))
+                return (false);
+        }
+        else if (SDL_strcmp(argv[index], "--capture-every") == 0 && index + 1 < argc) {
+            if (Game_Config_ParseSize(argv[++index], &this->capture_every) == false || this->capture_every == 0)
+                return (false);
+        }
+        else if (SDL_strcmp(argv[index], "--paused") == 0)
+            this->paused = true;
+        else if (SDL_strcmp(argv[index], "--idle-wake") == 0 && index + 1 < argc) {
+            if (Game_Config_ParseSize(argv[++index], &this->idle_wake_ms) == false)
+                return (false);
+        }
+        else if (SDL_strcmp(argv[index], "--player-script") == 0 && index + 1 < argc)
+            this->player_script_path = argv[++index];
+        else if (SDL_strcmp(argv[index], "--sprite-script") == 0 && index + 1 < argc)
+            this->sprite_script_path = argv[++index];
+        else if (SDL_strcmp(argv[index], "--render-scale") == 0 && index + 1 < argc)
+            this->render_scale = (float)SDL_atof(argv[++index]);
+        else if (SDL_strcmp(argv[index], "--zoom") == 0 && index + 1 < argc)
+            this->zoom = (float)SDL_atof(argv[++index]);
+        else if (SDL_strcmp(argv[index], "--no-mips") == 0)
+            this->mipmaps = false;
+        else if (SDL_strcmp(argv[index], "--render-filter") == 0 && index + 1 < argc) {
+            index++;
+            if (SDL_strcmp(argv[index], "nearest") != 0 && SDL_strcmp(argv[index], "linear") != 0)
+                return (false);
+            this->render_linear = SDL_strcmp(argv[index], "linear") == 0;
+        }
+        else if (SDL_strcmp(argv[index], "--adaptive") == 0)
+            this->adaptive = 1;
+        else if (SDL_strcmp(argv[index], "--no-adaptive") == 0)
+            this->adaptive = 0;
+        else
+            return (false);
+    }
+    if (Game_Config_IsStress(this) && this->frame_limit == 0)
+        this->frame_limit = GAME_CONFIG_DEFAULT_STRESS_FRAMES;
+    if (this->adaptive < 0)
+        this->adaptive = Game_Config_IsStress(this) == false;
+    return (true);
+}
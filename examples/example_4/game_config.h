@@ -0,0 +1,37 @@
+#ifndef GAME_CONFIG_H
+# define GAME_CONFIG_H
+
+# include "libstd.h"
+
+# define GAME_CONFIG_DEFAULT_STRESS_FRAMES 600
+
+typedef struct Game_Config {
+    size_t  stress_sprites;
+    size_t  stress_particles;
+    size_t  frame_limit;
+    bool    offscreen;
+    int     adaptive;
+    float   render_scale;
+    float   zoom;
+    bool    mipmaps;
+    bool    render_linear;
+    bool    animated;
+    bool    pipelined;
+    bool    chase;
+    bool    hud;
+    const char  *capture_path;
+    size_t  capture_scale;
+    size_t  capture_every;
+    bool    paused;
+    size_t  idle_wake_ms;
+    const char  *player_script_path;
+    const char  *sprite_script_path;
+    const char  *restore_path;
+}   Game_Config;
+
+void    Game_Config_Init(Game_Config *this);
+bool    Game_Config_Parse(Game_Config *this, int argc, char **argv);
+void    Game_Config_PrintUsage(const char *name);
+bool    Game_Config_IsStress(const Game_Config *this);
+
+#endif
@@ -20,8 +20,8 @@ void    Game_Error_Append(Game_Error *this, Game_Error_Code error_code) {
 }
 
 bool    Game_Error_Failure(Game_Error *this, Game_Error_Code error_code) {
-    if (this->length < MAX_ERROR_NUMBER)
-        this->code[this->length++] = error_code;
+    Game_Error_Append(this, error_code);
+    return (false);
 }
 
 void    Game_Error_Code_PrintMessage(Game_Error_Code this) {
@@ -0,0 +1,189 @@
+#include "game_flow.h"
+#include "game_memory.h"
+
+#define GAME_FLOW_ALIGNMENT 64
+#define GAME_FLOW_DIAGONAL 0.70710678f
+/* Open cell the integration has not reached; a wall is this with the low bit set, GAME_FLOW_UNREACHABLE. */
+#define GAME_FLOW_UNVISITED 0xFFFFFFFEu
+
+/* Unit steering vectors, x to the right and y down like the screen. */
+const float game_flow_vectors[GAME_FLOW_DIRECTION_COUNT][2] = {
+    {0.f, 0.f}, {1.f, 0.f}, {GAME_FLOW_DIAGONAL, GAME_FLOW_DIAGONAL}, {0.f, 1.f}, {-GAME_FLOW_DIAGONAL, GAME_FLOW_DIAGONAL},
+    {-1.f, 0.f}, {-GAME_FLOW_DIAGONAL, -GAME_FLOW_DIAGONAL}, {0.f, -1.f}, {GAME_FLOW_DIAGONAL, -GAME_FLOW_DIAGONAL},
+};
+
+static const int    game_flow_offsets[GAME_FLOW_DIRECTION_COUNT][2] = {
+    {0, 0}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1},
+};
+
+static size_t   Game_Flow_Align(size_t bytes) {
+    return ((bytes + GAME_FLOW_ALIGNMENT - 1) & ~(size_t)(GAME_FLOW_ALIGNMENT - 1));
+}
+
+bool    Game_Flow_Field_Init(Game_Flow_Field *this, size_t width, size_t height, float tile) {
+    size_t  cells;
+    size_t  bytes;
+    size_t  words;
+    char    *cursor;
+
+    SDL_zerop(this);
+    this->goal = GAME_FLOW_NO_GOAL;
+    if (width == 0 || height == 0 || tile <= 0.f || width + 2 > SDL_MAX_UINT32 / (height + 2))
+        return (false);
+    cells = (width + 2) * (height + 2);
+    bytes = Game_Flow_Align(cells);
+    words = Game_Flow_Align(sizeof(Uint32) * cells);
+    if ((this->block = SDL_aligned_alloc(GAME_FLOW_ALIGNMENT, bytes * 2 + words * 2)) == NULL)
+        return (false);
+    this->block_bytes = bytes * 2 + words * 2;
+    Game_Memory_Add(GAME_MEMORY_NAVIGATION, (Sint64)this->block_bytes);
+    cursor = this->block;
+    this->blocked = (Uint8 *)cursor;
+    this->directions = (Uint8 *)(cursor += bytes);
+    this->costs = (Uint32 *)(cursor += bytes);
+    this->queue = (Uint32 *)(cursor += words);
+    this->width = width;
+    this->height = height;
+    this->stride = width + 2;
+    this->tile = tile;
+    this->inverse_tile = 1.f / tile;
+    SDL_memset(this->directions, GAME_FLOW_NONE, cells);
+    SDL_memset(this->blocked, true, cells);
+    for (size_t y = 1; y <= height; y++)
+        SDL_memset(this->blocked + y * this->stride + 1, false, width);
+    return (true);
+}
+
+/* Walls only take effect at the next rebuild, which the next SetGoal is then forced to do. */
+void    Game_Flow_Field_SetBlocked(Game_Flow_Field *this, size_t x, size_t y, bool blocked) {
+    if (x >= this->width || y >= this->height)
+        return ;
+    this->blocked[(y + 1) * this->stride + x + 1] = blocked;
+    this->goal = GAME_FLOW_NO_GOAL;
+}
+
+/* The cell under a world position; positions off the grid belong to the nearest edge cell. */
+size_t  Game_Flow_Field_GetCell(const Game_Flow_Field *this, float x, float y) {
+    size_t  column;
+    size_t  row;
+
+    column = x > 0.f ? (size_t)(x * this->inverse_tile) : 0;
+    row = y > 0.f ? (size_t)(y * this->inverse_tile) : 0;
+    return ((SDL_min(row, this->height - 1) + 1) * this->stride + SDL_min(column, this->width - 1) + 1);
+}
+
+/* Breadth-first from the goal: every reached cell gets its step count, walls and cut-off cells keep their sentinel. */
+static void Game_Flow_Field_Integrate(Game_Flow_Field *this, size_t goal) {
+    const ptrdiff_t neighbours[4] = {1, -1, (ptrdiff_t)this->stride, -(ptrdiff_t)this->stride};
+    Uint32  *costs;
+    size_t  cells;
+    size_t  head;
+    size_t  tail;
+    size_t  cell;
+    size_t  next;
+    Uint32  cost;
+
+    costs = this->costs;
+    cells = this->stride * (this->height + 2);
+    for (size_t index = 0; index < cells; index++)
+        costs[index] = GAME_FLOW_UNVISITED | this->blocked[index];
+    if (costs[goal] != GAME_FLOW_UNVISITED)
+        return ;
+    costs[goal] = 0;
+    this->queue[0] = (Uint32)goal;
+    head = 0;
+    tail = 1;
+    while (head < tail) {
+        cell = this->queue[head++];
+        cost = costs[cell] + 1;
+        for (size_t index = 0; index < 4; index++) {
+            next = cell + (size_t)neighbours[index];
+            if (costs[next] == GAME_FLOW_UNVISITED) {
+                costs[next] = cost;
+                this->queue[tail++] = (Uint32)next;
+            }
+        }
+    }
+}
+
+/*
+** Each cell's cheapest neighbour. Walls and unreached cells cost at least
+** GAME_FLOW_UNVISITED, so they never win, and a diagonal is skipped when
+** either cell beside it is one of them.
+*/
+static void Game_Flow_Field_DirectionTask(void *context, size_t task, size_t worker) {
+    Game_Flow_Field *this;
+    ptrdiff_t   offsets[GAME_FLOW_DIRECTION_COUNT];
+    const Uint32    *costs;
+    size_t  end;
+    Uint32  best;
+    Uint8   direction;
+
+    (void)worker;
+    this = context;
+    for (size_t index = 0; index < GAME_FLOW_DIRECTION_COUNT; index++)
+        offsets[index] = game_flow_offsets[index][0] + game_flow_offsets[index][1] * (ptrdiff_t)this->stride;
+    end = SDL_min((task + 1) * GAME_FLOW_ROWS_PER_TASK, this->height) + 1;
+    for (size_t y = task * GAME_FLOW_ROWS_PER_TASK + 1; y < end; y++)
+        for (size_t cell = y * this->stride + 1; cell < y * this->stride + 1 + this->width; cell++) {
+            costs = this->costs + cell;
+            direction = GAME_FLOW_NONE;
+            best = costs[0];
+            if (best != 0 && best < GAME_FLOW_UNVISITED)
+                for (int index = GAME_FLOW_EAST; index < GAME_FLOW_DIRECTION_COUNT; index++) {
+                    if (costs[offsets[index]] >= best)
+                        continue ;
+                    if (index % 2 == 0 && (costs[game_flow_offsets[index][0]] >= GAME_FLOW_UNVISITED
+                        || costs[offsets[index] - game_flow_offsets[index][0]] >= GAME_FLOW_UNVISITED))
+                        continue ;
+                    best = costs[offsets[index]];
+                    direction = (Uint8)index;
+                }
+            this->directions[cell] = direction;
+        }
+}
+
+/*
+** The integration is one wavefront and stays on the calling thread; the
+** direction pass reads finished costs only, so its row bands are
+** independent. `jobs` may be NULL to run them all here, which a caller that
+** does not own the workers at that moment has to do.
+*/
+void    Game_Flow_Field_Build(Game_Flow_Field *this, size_t goal, Game_Jobs *jobs) {
+    size_t  tasks;
+
+    if (this->block == NULL || goal >= this->stride * (this->height + 2))
+        return ;
+    Game_Flow_Field_Integrate(this, goal);
+    tasks = (this->height + GAME_FLOW_ROWS_PER_TASK - 1) / GAME_FLOW_ROWS_PER_TASK;
+    if (jobs != NULL)
+        Game_Jobs_Run(jobs, Game_Flow_Field_DirectionTask, this, tasks);
+    else
+        for (size_t task = 0; task < tasks; task++)
+            Game_Flow_Field_DirectionTask(this, task, 0);
+    this->goal = goal;
+    this->rebuilds++;
+}
+
+/* Rebuilds only when the goal moved to another cell; returns whether it did. */
+bool    Game_Flow_Field_SetGoal(Game_Flow_Field *this, float x, float y, Game_Jobs *jobs) {
+    size_t  goal;
+
+    if (this->block == NULL || (goal = Game_Flow_Field_GetCell(this, x, y)) == this->goal)
+        return (false);
+    Game_Flow_Field_Build(this, goal, jobs);
+    return (true);
+}
+
+Game_Flow_Direction Game_Flow_Field_Sample(const Game_Flow_Field *this, float x, float y) {
+    if (this->block == NULL)
+        return (GAME_FLOW_NONE);
+    return ((Game_Flow_Direction)this->directions[Game_Flow_Field_GetCell(this, x, y)]);
+}
+
+void    Game_Flow_Field_Destroy(Game_Flow_Field *this) {
+    Game_Memory_Add(GAME_MEMORY_NAVIGATION, -(Sint64)this->block_bytes);
+    SDL_aligned_free(this->block);
+    SDL_zerop(this);
+    this->goal = GAME_FLOW_NO_GOAL;
+}
@@ -0,0 +1,65 @@
+#ifndef GAME_FLOW_H
+# define GAME_FLOW_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+# include "game_jobs.h"
+
+# define GAME_FLOW_TILE 32.f
+# define GAME_FLOW_ROWS_PER_TASK 16
+# define GAME_FLOW_UNREACHABLE 0xFFFFFFFFu
+# define GAME_FLOW_NO_GOAL ((size_t)-1)
+
+/* Where a cell's agents head next; NONE on the goal, walls and cells cut off from it. */
+typedef enum Game_Flow_Direction {
+    GAME_FLOW_NONE,
+    GAME_FLOW_EAST,
+    GAME_FLOW_SOUTH_EAST,
+    GAME_FLOW_SOUTH,
+    GAME_FLOW_SOUTH_WEST,
+    GAME_FLOW_WEST,
+    GAME_FLOW_NORTH_WEST,
+    GAME_FLOW_NORTH,
+    GAME_FLOW_NORTH_EAST,
+    GAME_FLOW_DIRECTION_COUNT,
+}   Game_Flow_Direction;
+
+/*
+** Flow field over a grid of `tile`-pixel cells, every cell pointing one step
+** down the shortest path to the goal cell. A rebuild is a breadth-first
+** integration from the goal (4-connected, unit cost) followed by the
+** direction pass, which picks each cell's cheapest of its 8 neighbours and
+** runs over GAME_FLOW_ROWS_PER_TASK row bands spread on the job workers.
+** A diagonal is only taken when both cells it cuts past are open.
+** Steering is then one table lookup per agent, whatever the crowd size.
+** The arrays are `stride` = width + 2 cells wide and two rows taller: a
+** permanent ring of walls, so neither pass checks bounds. Cell indices
+** (GetCell, Build) count in that padded layout.
+*/
+typedef struct Game_Flow_Field {
+    Uint8   *blocked;
+    Uint32  *costs;
+    Uint8   *directions;
+    Uint32  *queue;
+    void    *block;
+    size_t  block_bytes;
+    size_t  width;
+    size_t  height;
+    size_t  stride;
+    float   tile;
+    float   inverse_tile;
+    size_t  goal;
+    size_t  rebuilds;
+}   Game_Flow_Field;
+
+extern const float  game_flow_vectors[GAME_FLOW_DIRECTION_COUNT][2];
+
+bool    Game_Flow_Field_Init(Game_Flow_Field *this, size_t width, size_t height, float tile);
+void    Game_Flow_Field_SetBlocked(Game_Flow_Field *this, size_t x, size_t y, bool blocked);
+size_t  Game_Flow_Field_GetCell(const Game_Flow_Field *this, float x, float y);
+void    Game_Flow_Field_Build(Game_Flow_Field *this, size_t goal, Game_Jobs *jobs);
+bool    Game_Flow_Field_SetGoal(Game_Flow_Field *this, float x, float y, Game_Jobs *jobs);
+Game_Flow_Direction Game_Flow_Field_Sample(const Game_Flow_Field *this, float x, float y);
+void    Game_Flow_Field_Destroy(Game_Flow_Field *this);
+
+#endif
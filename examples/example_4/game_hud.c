@@ -0,0 +1,287 @@
+#include "game_hud.h"
+#include "game_memory.h"
+
+#define GAME_HUD_ATLAS_COLUMNS 16
+#define GAME_HUD_ATLAS_WIDTH (GAME_HUD_ATLAS_COLUMNS * GAME_HUD_CELL)
+#define GAME_HUD_ATLAS_HEIGHT ((GAME_HUD_GLYPHS / GAME_HUD_ATLAS_COLUMNS + 1) * GAME_HUD_CELL)
+#define GAME_HUD_SOLID GAME_HUD_GLYPHS
+#define GAME_HUD_MARGIN 8.f
+#define GAME_HUD_PADDING 8.f
+#define GAME_HUD_LINE ((GAME_HUD_GLYPH_HEIGHT + 3) * GAME_HUD_SCALE)
+#define GAME_HUD_ADVANCE ((GAME_HUD_GLYPH_WIDTH + 1) * GAME_HUD_SCALE)
+#define GAME_HUD_BAR 3.f
+#define GAME_HUD_TEXT_LINES 4
+
+/* One row of five pixels per byte, leftmost pixel in bit 4; characters left out are blank. */
+static const Uint8  game_hud_font[GAME_HUD_GLYPHS][GAME_HUD_GLYPH_HEIGHT] = {
+    ['%' - ' '] = {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},
+    ['(' - ' '] = {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},
+    [')' - ' '] = {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},
+    ['+' - ' '] = {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},
+    ['-' - ' '] = {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},
+    ['.' - ' '] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},
+    ['/' - ' '] = {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},
+    ['0' - ' '] = {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},
+    ['1' - ' '] = {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},
+    ['2' - ' '] = {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},
+    ['3' - ' '] = {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},
+    ['4' - ' '] = {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},
+    ['5' - ' '] = {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},
+    ['6' - ' '] = {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},
+    ['7' - ' '] = {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},
+    ['8' - ' '] = {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},
+    ['9' - ' '] = {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},
+    [':' - ' '] = {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},
+    ['=' - ' '] = {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00},
+    ['A' - ' '] = {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},
+    ['B' - ' '] = {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},
+    ['C' - ' '] = {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},
+    ['D' - ' '] = {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},
+    ['E' - ' '] = {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},
+    ['F' - ' '] = {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},
+    ['G' - ' '] = {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},
+    ['H' - ' '] = {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},
+    ['I' - ' '] = {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},
+    ['J' - ' '] = {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},
+    ['K' - ' '] = {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},
+    ['L' - ' '] = {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},
+    ['M' - ' '] = {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},
+    ['N' - ' '] = {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},
+    ['O' - ' '] = {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},
+    ['P' - ' '] = {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},
+    ['Q' - ' '] = {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},
+    ['R' - ' '] = {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},
+    ['S' - ' '] = {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},
+    ['T' - ' '] = {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},
+    ['U' - ' '] = {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},
+    ['V' - ' '] = {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},
+    ['W' - ' '] = {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},
+    ['X' - ' '] = {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},
+    ['Y' - ' '] = {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},
+    ['Z' - ' '] = {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},
+};
+
+static const SDL_FColor game_hud_panel = {0.f, 0.f, 0.f, 0.6f};
+static const SDL_FColor game_hud_text = {1.f, 1.f, 1.f, 1.f};
+static const SDL_FColor game_hud_good = {0.3f, 0.9f, 0.3f, 1.f};
+static const SDL_FColor game_hud_late = {1.f, 0.8f, 0.2f, 1.f};
+static const SDL_FColor game_hud_missed = {1.f, 0.3f, 0.2f, 1.f};
+
+static SDL_Surface  *Game_Hud_Rasterize(void) {
+    SDL_Surface *surface;
+    Uint32  *row;
+    size_t  left;
+    size_t  top;
+
+    if ((surface = SDL_CreateSurface(GAME_HUD_ATLAS_WIDTH, GAME_HUD_ATLAS_HEIGHT, SDL_PIXELFORMAT_ARGB8888)) == NULL)
+        return (NULL);
+    SDL_memset(surface->pixels, 0, (size_t)surface->pitch * (size_t)surface->h);
+    for (size_t glyph = 0; glyph <= GAME_HUD_GLYPHS; glyph++) {
+        left = glyph % GAME_HUD_ATLAS_COLUMNS * GAME_HUD_CELL;
+        top = glyph / GAME_HUD_ATLAS_COLUMNS * GAME_HUD_CELL;
+        for (size_t y = 0; y < GAME_HUD_CELL; y++) {
+            row = (Uint32 *)((Uint8 *)surface->pixels + (top + y) * (size_t)surface->pitch) + left;
+            for (size_t x = 0; x < GAME_HUD_CELL; x++)
+                if (glyph == GAME_HUD_SOLID || (y < GAME_HUD_GLYPH_HEIGHT && x < GAME_HUD_GLYPH_WIDTH
+                    && (game_hud_font[glyph][y] >> (GAME_HUD_GLYPH_WIDTH - 1 - x)) & 1))
+                    row[x] = 0xFFFFFFFFu;
+        }
+    }
+    return (surface);
+}
+
+/*
+** Nothing is built here: the atlas and the buffers come with the first
+** frame the overlay is drawn, so an overlay that is never shown costs
+** nothing at startup.
+*/
+void    Game_Hud_Init(Game_Hud *this) {
+    SDL_zerop(this);
+}
+
+/*
+** The atlas and the index buffer never change after this; the vertex buffer
+** is refilled every frame. Tried once: an overlay that cannot be built stays
+** hidden.
+*/
+static bool Game_Hud_Start(Game_Hud *this, SDL_Renderer *renderer) {
+    SDL_Surface *surface;
+
+    this->started = true;
+    if ((surface = Game_Hud_Rasterize()) == NULL)
+        return (false);
+    this->atlas = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    if (this->atlas == NULL)
+        return (false);
+    if ((this->vertices = malloc((sizeof(SDL_Vertex) * 4 + sizeof(int) * 6) * GAME_HUD_QUADS)) == NULL) {
+        SDL_DestroyTexture(this->atlas);
+        this->atlas = NULL;
+        return (false);
+    }
+    Game_Memory_Add(GAME_MEMORY_TEXTURES, Game_Memory_TextureBytes(this->atlas));
+    SDL_SetTextureBlendMode(this->atlas, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(this->atlas, SDL_SCALEMODE_NEAREST);
+    this->buffer_bytes = (sizeof(SDL_Vertex) * 4 + sizeof(int) * 6) * GAME_HUD_QUADS;
+    Game_Memory_Add(GAME_MEMORY_RENDER, (Sint64)this->buffer_bytes);
+    this->indices = (int *)(this->vertices + GAME_HUD_QUADS * 4);
+    for (int quad = 0; quad < GAME_HUD_QUADS; quad++) {
+        this->indices[quad * 6 + 0] = quad * 4 + 0;
+        this->indices[quad * 6 + 1] = quad * 4 + 1;
+        this->indices[quad * 6 + 2] = quad * 4 + 2;
+        this->indices[quad * 6 + 3] = quad * 4 + 0;
+        this->indices[quad * 6 + 4] = quad * 4 + 2;
+        this->indices[quad * 6 + 5] = quad * 4 + 3;
+    }
+    return (true);
+}
+
+/* Showing the overlay starts a fresh history, so the time it spent hidden is not graphed as one long frame. */
+void    Game_Hud_Toggle(Game_Hud *this) {
+    this->visible = this->visible == false;
+    this->history_index = 0;
+    this->history_length = 0;
+    this->last_ns = 0;
+    this->refresh_ns = 0;
+}
+
+static void Game_Hud_Quad(Game_Hud *this, SDL_FRect rectangle, SDL_FRect source, SDL_FColor color) {
+    SDL_Vertex  *vertex;
+
+    if (this->vertices == NULL || this->quads == GAME_HUD_QUADS)
+        return ;
+    vertex = &this->vertices[this->quads++ * 4];
+    vertex[0] = (SDL_Vertex){{rectangle.x, rectangle.y}, color, {source.x, source.y}};
+    vertex[1] = (SDL_Vertex){{rectangle.x + rectangle.w, rectangle.y}, color, {source.x + source.w, source.y}};
+    vertex[2] = (SDL_Vertex){{rectangle.x + rectangle.w, rectangle.y + rectangle.h}, color, {source.x + source.w, source.y + source.h}};
+    vertex[3] = (SDL_Vertex){{rectangle.x, rectangle.y + rectangle.h}, color, {source.x, source.y + source.h}};
+}
+
+/* A solid rectangle, sampled from the middle of the atlas's solid cell. */
+void    Game_Hud_Rect(Game_Hud *this, float x, float y, float width, float height, SDL_FColor color) {
+    SDL_FRect   source;
+
+    source.x = ((float)(GAME_HUD_SOLID % GAME_HUD_ATLAS_COLUMNS * GAME_HUD_CELL) + GAME_HUD_CELL / 2.f) / GAME_HUD_ATLAS_WIDTH;
+    source.y = ((float)(GAME_HUD_SOLID / GAME_HUD_ATLAS_COLUMNS * GAME_HUD_CELL) + GAME_HUD_CELL / 2.f) / GAME_HUD_ATLAS_HEIGHT;
+    source.w = 0.f;
+    source.h = 0.f;
+    Game_Hud_Quad(this, (SDL_FRect){x, y, width, height}, source, color);
+}
+
+/* Appends one quad per visible glyph; returns the right edge of the widest line. */
+float   Game_Hud_Text(Game_Hud *this, float x, float y, const char *text, SDL_FColor color) {
+    SDL_FRect   source;
+    size_t  glyph;
+    float   cursor;
+    float   right;
+
+    cursor = x;
+    right = x;
+    for (; *text != '\0'; text++) {
+        if (*text == '\n') {
+            cursor = x;
+            y += GAME_HUD_LINE;
+            continue ;
+        }
+        glyph = (size_t)(Uint8)SDL_toupper((unsigned char)*text) - ' ';
+        if (glyph < GAME_HUD_GLYPHS && glyph != 0) {
+            source.x = (float)(glyph % GAME_HUD_ATLAS_COLUMNS * GAME_HUD_CELL) / GAME_HUD_ATLAS_WIDTH;
+            source.y = (float)(glyph / GAME_HUD_ATLAS_COLUMNS * GAME_HUD_CELL) / GAME_HUD_ATLAS_HEIGHT;
+            source.w = (float)GAME_HUD_GLYPH_WIDTH / GAME_HUD_ATLAS_WIDTH;
+            source.h = (float)GAME_HUD_GLYPH_HEIGHT / GAME_HUD_ATLAS_HEIGHT;
+            Game_Hud_Quad(this, (SDL_FRect){cursor, y, GAME_HUD_GLYPH_WIDTH * GAME_HUD_SCALE,
+                GAME_HUD_GLYPH_HEIGHT * GAME_HUD_SCALE}, source, color);
+        }
+        cursor += GAME_HUD_ADVANCE;
+        right = SDL_max(right, cursor);
+    }
+    return (right);
+}
+
+/* Rebuilds the panel and text quads from the history and the counters; the panel is quad 0, under the rest. */
+static void Game_Hud_Refresh(Game_Hud *this, const Game_Hud_Counters *counters) {
+    char    text[256];
+    Uint64  total;
+    Uint64  longest;
+    double  average_ms;
+    float   right;
+
+    total = 0;
+    longest = 0;
+    for (size_t index = 0; index < this->history_length; index++) {
+        total += this->history[index];
+        longest = SDL_max(longest, this->history[index]);
+    }
+    average_ms = this->history_length != 0 ? (double)total / (double)this->history_length / 1e6 : 0.0;
+    SDL_snprintf(text, sizeof(text),
+        "FPS %.1f  frame %.2f ms  max %.2f ms\n"
+        "draw calls %zu  sprites %zu  particles %zu\n"
+        "memory %.1f MiB  peak %.1f MiB\n"
+        "hud %.3f ms",
+        average_ms > 0.0 ? 1000.0 / average_ms : 0.0, average_ms, (double)longest / 1e6,
+        counters->draw_calls, counters->sprites, counters->particles,
+        (double)counters->memory / (1024.0 * 1024.0), (double)counters->memory_peak / (1024.0 * 1024.0),
+        (double)this->cost_ns / 1e6);
+    this->quads = 1;
+    right = Game_Hud_Text(this, GAME_HUD_MARGIN + GAME_HUD_PADDING, GAME_HUD_MARGIN + GAME_HUD_PADDING, text, game_hud_text);
+    this->text_quads = this->quads;
+    this->quads = 0;
+    Game_Hud_Rect(this, GAME_HUD_MARGIN, GAME_HUD_MARGIN,
+        SDL_max(right, GAME_HUD_MARGIN + GAME_HUD_PADDING + GAME_HUD_HISTORY * GAME_HUD_BAR) + GAME_HUD_PADDING - GAME_HUD_MARGIN,
+        GAME_HUD_PADDING * 2 + GAME_HUD_TEXT_LINES * GAME_HUD_LINE + GAME_HUD_GRAPH_HEIGHT, game_hud_panel);
+    this->quads = this->text_quads;
+}
+
+/* Oldest frame on the left; bars turn amber past one 60 Hz frame and red past two, the line marks 16.7 ms. */
+static void Game_Hud_Graph(Game_Hud *this) {
+    Uint64  frame_ns;
+    float   left;
+    float   bottom;
+    float   height;
+
+    left = GAME_HUD_MARGIN + GAME_HUD_PADDING;
+    bottom = GAME_HUD_MARGIN + GAME_HUD_PADDING + GAME_HUD_TEXT_LINES * GAME_HUD_LINE + GAME_HUD_GRAPH_HEIGHT;
+    for (size_t index = 0; index < this->history_length; index++) {
+        frame_ns = this->history[(this->history_index + GAME_HUD_HISTORY - this->history_length + index) % GAME_HUD_HISTORY];
+        height = SDL_min((float)frame_ns / 1e6f / GAME_HUD_GRAPH_MS, 1.f) * GAME_HUD_GRAPH_HEIGHT;
+        Game_Hud_Rect(this, left + (float)index * GAME_HUD_BAR, bottom - height, GAME_HUD_BAR - 1.f, height,
+            frame_ns <= 16700000 ? game_hud_good : frame_ns <= 33300000 ? game_hud_late : game_hud_missed);
+    }
+    Game_Hud_Rect(this, left, bottom - 16.7f / GAME_HUD_GRAPH_MS * GAME_HUD_GRAPH_HEIGHT, GAME_HUD_HISTORY * GAME_HUD_BAR, 1.f,
+        game_hud_text);
+}
+
+/* Call once per presented frame, after the scene, with the renderer back in window coordinates. */
+bool    Game_Hud_Render(Game_Hud *this, SDL_Renderer *renderer, const Game_Hud_Counters *counters) {
+    Uint64  start;
+    bool    drawn;
+
+    if (this->started == false && Game_Hud_Start(this, renderer) == false)
+        SDL_Log("hud: unavailable: %s", SDL_GetError());
+    if (this->atlas == NULL || this->vertices == NULL)
+        return (false);
+    start = SDL_GetTicksNS();
+    if (this->last_ns != 0) {
+        this->history[this->history_index] = start - this->last_ns;
+        this->history_index = (this->history_index + 1) % GAME_HUD_HISTORY;
+        this->history_length = SDL_min(this->history_length + 1, GAME_HUD_HISTORY);
+    }
+    this->last_ns = start;
+    if (start >= this->refresh_ns) {
+        Game_Hud_Refresh(this, counters);
+        this->refresh_ns = start + GAME_HUD_REFRESH_NS;
+    }
+    this->quads = this->text_quads;
+    Game_Hud_Graph(this);
+    drawn = SDL_RenderGeometry(renderer, this->atlas, this->vertices, (int)(this->quads * 4), this->indices, (int)(this->quads * 6));
+    this->cost_ns = SDL_GetTicksNS() - start;
+    return (drawn);
+}
+
+void    Game_Hud_Destroy(Game_Hud *this) {
+    Game_Memory_Add(GAME_MEMORY_TEXTURES, -(Sint64)Game_Memory_TextureBytes(this->atlas));
+    Game_Memory_Add(GAME_MEMORY_RENDER, -(Sint64)this->buffer_bytes);
+    SDL_DestroyTexture(this->atlas);
+    free(this->vertices);
+    SDL_zerop(this);
+}
@@ -0,0 +1,60 @@
+#ifndef GAME_HUD_H
+# define GAME_HUD_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_HUD_GLYPHS 64
+# define GAME_HUD_GLYPH_WIDTH 5
+# define GAME_HUD_GLYPH_HEIGHT 7
+# define GAME_HUD_CELL 8
+# define GAME_HUD_SCALE 2.f
+# define GAME_HUD_QUADS 512
+# define GAME_HUD_HISTORY 120
+# define GAME_HUD_REFRESH_NS 250000000
+# define GAME_HUD_GRAPH_HEIGHT 80.f
+# define GAME_HUD_GRAPH_MS 33.3f
+
+/* What the overlay reports besides its own frame timing, read from the frame being drawn. */
+typedef struct Game_Hud_Counters {
+    size_t  draw_calls;
+    size_t  sprites;
+    size_t  particles;
+    size_t  memory;
+    size_t  memory_peak;
+}   Game_Hud_Counters;
+
+/*
+** Performance overlay in window coordinates. The glyph atlas (ASCII space to
+** underscore, lowercase drawn as uppercase, plus one solid cell for the
+** panel and graph) is rasterised once from a built-in 5x7 font. Every frame
+** is one SDL_RenderGeometry call: the panel and text quads, rebuilt every
+** GAME_HUD_REFRESH_NS so the numbers stay readable, then the frame-time
+** graph over the last GAME_HUD_HISTORY frames. `cost_ns` is the overlay's
+** own CPU time for the previous frame, shown in its last line.
+*/
+typedef struct Game_Hud {
+    SDL_Texture *atlas;
+    SDL_Vertex  *vertices;
+    int     *indices;
+    size_t  buffer_bytes;
+    size_t  quads;
+    size_t  text_quads;
+    Uint64  history[GAME_HUD_HISTORY];
+    size_t  history_index;
+    size_t  history_length;
+    Uint64  last_ns;
+    Uint64  refresh_ns;
+    Uint64  cost_ns;
+    bool    visible;
+    bool    started;
+}   Game_Hud;
+
+void    Game_Hud_Init(Game_Hud *this);
+void    Game_Hud_Toggle(Game_Hud *this);
+void    Game_Hud_Rect(Game_Hud *this, float x, float y, float width, float height, SDL_FColor color);
+float   Game_Hud_Text(Game_Hud *this, float x, float y, const char *text, SDL_FColor color);
+bool    Game_Hud_Render(Game_Hud *this, SDL_Renderer *renderer, const Game_Hud_Counters *counters);
+void    Game_Hud_Destroy(Game_Hud *this);
+
+#endif
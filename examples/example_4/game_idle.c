@@ -0,0 +1,134 @@
+#include "game_idle.h"
+#include <time.h>
+
+/* CPU time of the whole process, every thread included: what the battery pays. */
+static Uint64   Game_Idle_GetCPUNS(void) {
+    clock_t cpu;
+
+    cpu = clock();
+    return (cpu == (clock_t)-1 ? 0 : (Uint64)((double)cpu * 1e9 / CLOCKS_PER_SEC));
+}
+
+void    Game_Idle_Init(Game_Idle *this, Uint64 wake_interval_ns) {
+    SDL_zerop(this);
+    this->wake_interval_ns = wake_interval_ns;
+}
+
+/* Only the transitions between active and idle start or close an idle period. */
+void    Game_Idle_Set(Game_Idle *this, Game_Idle_Reason reason, bool set) {
+    Uint32  reasons;
+    Uint64  now;
+
+    reasons = set ? this->reasons | (Uint32)reason : this->reasons & ~(Uint32)reason;
+    if ((reasons != 0) != (this->reasons != 0)) {
+        now = SDL_GetTicksNS();
+        if (reasons != 0) {
+            this->entered_ns = now;
+            this->entered_cpu_ns = Game_Idle_GetCPUNS();
+            this->next_wake_ns = now + this->wake_interval_ns;
+            this->redraw = false;
+            this->periods++;
+        }
+        else {
+            this->idle_ns += now - this->entered_ns;
+            this->cpu_ns += Game_Idle_GetCPUNS() - this->entered_cpu_ns;
+        }
+    }
+    this->reasons = reasons;
+}
+
+bool    Game_Idle_IsIdle(const Game_Idle *this) {
+    return (this->reasons != 0);
+}
+
+/*
+** Window visibility and focus, and the pause key (P). Returns whether the
+** event was one of them, so the caller does not handle it again.
+*/
+bool    Game_Idle_HandleEvent(Game_Idle *this, const SDL_Event *event) {
+    switch (event->type) {
+        case SDL_EVENT_WINDOW_MINIMIZED:
+        case SDL_EVENT_WINDOW_HIDDEN:
+        case SDL_EVENT_WINDOW_OCCLUDED:
+            Game_Idle_Set(this, GAME_IDLE_MINIMIZED, true);
+            return (true);
+        case SDL_EVENT_WINDOW_RESTORED:
+        case SDL_EVENT_WINDOW_MAXIMIZED:
+        case SDL_EVENT_WINDOW_SHOWN:
+        case SDL_EVENT_WINDOW_EXPOSED:
+            Game_Idle_Set(this, GAME_IDLE_MINIMIZED, false);
+            this->redraw = true;
+            return (true);
+        case SDL_EVENT_WINDOW_FOCUS_LOST:
+            Game_Idle_Set(this, GAME_IDLE_UNFOCUSED, true);
+            return (true);
+        case SDL_EVENT_WINDOW_FOCUS_GAINED:
+            Game_Idle_Set(this, GAME_IDLE_UNFOCUSED, false);
+            return (true);
+        case SDL_EVENT_KEY_DOWN:
+            if (event->key.key != SDLK_P)
+                return (false);
+            if (event->key.repeat == false)
+                Game_Idle_Set(this, GAME_IDLE_PAUSED, (this->reasons & GAME_IDLE_PAUSED) == 0);
+            return (true);
+        default:
+            return (false);
+    }
+}
+
+void    Game_Idle_RequestRedraw(Game_Idle *this) {
+    this->redraw = true;
+}
+
+/*
+** Blocks until an event, stored in `event`, or the next scheduled wake, which
+** asks for a redraw. Without a wake interval only an event ends the wait.
+** Returns whether an event came.
+*/
+bool    Game_Idle_Wait(Game_Idle *this, SDL_Event *event) {
+    Sint32  timeout;
+    Uint64  now;
+    bool    received;
+
+    timeout = -1;
+    if (this->wake_interval_ns != 0) {
+        now = SDL_GetTicksNS();
+        timeout = this->next_wake_ns <= now ? 0
+            : (Sint32)SDL_min((this->next_wake_ns - now + 999999) / 1000000, (Uint64)SDL_MAX_SINT32);
+    }
+    received = SDL_WaitEventTimeout(event, timeout);
+    this->wakeups++;
+    if (this->wake_interval_ns != 0 && (now = SDL_GetTicksNS()) >= this->next_wake_ns) {
+        this->next_wake_ns = now + this->wake_interval_ns;
+        this->redraw = true;
+    }
+    return (received);
+}
+
+/* Whether to draw the paused state now; a minimised window drops the request. */
+bool    Game_Idle_TakeRedraw(Game_Idle *this) {
+    bool    redraw;
+
+    redraw = this->redraw && (this->reasons & GAME_IDLE_MINIMIZED) == 0;
+    this->redraw = false;
+    this->redraws += redraw;
+    return (redraw);
+}
+
+/* Totals include the idle period still open, if the game quits while idle. */
+void    Game_Idle_Print(const Game_Idle *this, FILE *output) {
+    Uint64  idle_ns;
+    Uint64  cpu_ns;
+
+    idle_ns = this->idle_ns;
+    cpu_ns = this->cpu_ns;
+    if (this->reasons != 0) {
+        idle_ns += SDL_GetTicksNS() - this->entered_ns;
+        cpu_ns += Game_Idle_GetCPUNS() - this->entered_cpu_ns;
+    }
+    fprintf(output, "idle          %.2f s over %zu periods, %zu wakeups (%.1f/s), %zu redraws\n",
+        (double)idle_ns / 1e9, this->periods, this->wakeups,
+        idle_ns != 0 ? (double)this->wakeups * 1e9 / (double)idle_ns : 0.0, this->redraws);
+    fprintf(output, "idle cpu      %.3f s, %.2f%% of one core (all threads)\n",
+        (double)cpu_ns / 1e9, idle_ns != 0 ? (double)cpu_ns * 100.0 / (double)idle_ns : 0.0);
+}
@@ -0,0 +1,46 @@
+#ifndef GAME_IDLE_H
+# define GAME_IDLE_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+/* Why the game is idle; any one of them is enough. */
+typedef enum Game_Idle_Reason {
+    GAME_IDLE_PAUSED = 1 << 0,
+    GAME_IDLE_MINIMIZED = 1 << 1,
+    GAME_IDLE_UNFOCUSED = 1 << 2,
+}   Game_Idle_Reason;
+
+/*
+** Idle state and its accounting. While any reason is set, the loop blocks in
+** Game_Idle_Wait instead of simulating and presenting: it wakes on the next
+** event or, when `wake_interval_ns` is not 0, at the next scheduled wake.
+** `redraw` asks for one frame of the paused state (an exposed window, a key
+** that changed what the frame shows, a due wake); it is never granted while
+** minimised. Wall time, wakeups and process CPU time are summed over every
+** idle period so the cost of sitting idle can be read off at exit.
+*/
+typedef struct Game_Idle {
+    Uint32  reasons;
+    Uint64  wake_interval_ns;
+    Uint64  next_wake_ns;
+    bool    redraw;
+    Uint64  entered_ns;
+    Uint64  entered_cpu_ns;
+    Uint64  idle_ns;
+    Uint64  cpu_ns;
+    size_t  periods;
+    size_t  wakeups;
+    size_t  redraws;
+}   Game_Idle;
+
+void    Game_Idle_Init(Game_Idle *this, Uint64 wake_interval_ns);
+void    Game_Idle_Set(Game_Idle *this, Game_Idle_Reason reason, bool set);
+bool    Game_Idle_IsIdle(const Game_Idle *this);
+bool    Game_Idle_HandleEvent(Game_Idle *this, const SDL_Event *event);
+void    Game_Idle_RequestRedraw(Game_Idle *this);
+bool    Game_Idle_Wait(Game_Idle *this, SDL_Event *event);
+bool    Game_Idle_TakeRedraw(Game_Idle *this);
+void    Game_Idle_Print(const Game_Idle *this, FILE *output);
+
+#endif
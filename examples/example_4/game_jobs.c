@@ -0,0 +1,124 @@
+#include "game_jobs.h"
+
+/*
+** A fixed set of SDL threads parked on a condition variable. Run publishes a
+** batch under the mutex and bumps the generation; every thread, the caller
+** included, then claims task indices from one atomic counter until the batch
+** is exhausted. Run returns once the last worker has checked back in.
+*/
+
+static void Game_Jobs_Drain(Game_Jobs *this, size_t worker) {
+    int     task;
+
+    while ((task = SDL_AddAtomicInt(&this->next_task, 1)) < (int)this->task_count)
+        this->function(this->context, (size_t)task, worker);
+}
+
+static int  Game_Jobs_Worker_Main(void *data) {
+    Game_Jobs_Worker    *worker;
+    Game_Jobs   *jobs;
+    Uint32  seen;
+
+    worker = data;
+    jobs = worker->jobs;
+    seen = 0;
+    SDL_LockMutex(jobs->mutex);
+    while (true) {
+        while (jobs->generation == seen && jobs->quit == false)
+            SDL_WaitCondition(jobs->wake, jobs->mutex);
+        if (jobs->quit)
+            break ;
+        seen = jobs->generation;
+        SDL_UnlockMutex(jobs->mutex);
+        Game_Jobs_Drain(jobs, worker->index);
+        SDL_LockMutex(jobs->mutex);
+        if (--jobs->pending == 0)
+            SDL_SignalCondition(jobs->done);
+    }
+    SDL_UnlockMutex(jobs->mutex);
+    return (0);
+}
+
+/*
+** Sets up a pool of up to `threads` workers. The threads themselves are only
+** started by the first batch that can use them, so a pool that is never run
+** in parallel costs nothing at startup.
+*/
+bool    Game_Jobs_Init(Game_Jobs *this, size_t threads) {
+    this->thread_count = 0;
+    this->requested = 0;
+    this->started = false;
+    this->generation = 0;
+    this->pending = 0;
+    this->quit = false;
+    SDL_SetAtomicInt(&this->next_task, 0);
+    this->mutex = SDL_CreateMutex();
+    this->wake = SDL_CreateCondition();
+    this->done = SDL_CreateCondition();
+    if (this->mutex == NULL || this->wake == NULL || this->done == NULL)
+        return (false);
+    this->requested = SDL_min(threads, GAME_JOBS_MAX_WORKERS - 1);
+    return (true);
+}
+
+/* Fewer threads than requested (even none) still gives a usable pool. */
+static void Game_Jobs_Start(Game_Jobs *this) {
+    Game_Jobs_Worker    *worker;
+
+    this->started = true;
+    while (this->thread_count < this->requested) {
+        worker = &this->workers[this->thread_count + 1];
+        worker->jobs = this;
+        worker->index = this->thread_count + 1;
+        if ((worker->thread = SDL_CreateThread(Game_Jobs_Worker_Main, "game_jobs", worker)) == NULL) {
+            SDL_Log("jobs: running with %zu worker threads: %s", this->thread_count, SDL_GetError());
+            return ;
+        }
+        this->thread_count++;
+    }
+}
+
+/* Counts the workers the pool may use, started or not, so per-worker storage can be sized before the first Run. */
+size_t  Game_Jobs_GetWorkerCount(const Game_Jobs *this) {
+    return (this->requested + 1);
+}
+
+void    Game_Jobs_Run(Game_Jobs *this, Game_Job_Function function, void *context, size_t task_count) {
+    if (this->started == false && this->requested != 0 && task_count > 1)
+        Game_Jobs_Start(this);
+    if (this->thread_count == 0 || task_count <= 1) {
+        for (size_t task = 0; task < task_count; task++)
+            function(context, task, 0);
+        return ;
+    }
+    SDL_LockMutex(this->mutex);
+    this->function = function;
+    this->context = context;
+    this->task_count = task_count;
+    SDL_SetAtomicInt(&this->next_task, 0);
+    this->pending = this->thread_count;
+    this->generation++;
+    SDL_BroadcastCondition(this->wake);
+    SDL_UnlockMutex(this->mutex);
+    Game_Jobs_Drain(this, 0);
+    SDL_LockMutex(this->mutex);
+    while (this->pending != 0)
+        SDL_WaitCondition(this->done, this->mutex);
+    SDL_UnlockMutex(this->mutex);
+}
+
+void    Game_Jobs_Destroy(Game_Jobs *this) {
+    SDL_LockMutex(this->mutex);
+    this->quit = true;
+    SDL_BroadcastCondition(this->wake);
+    SDL_UnlockMutex(this->mutex);
+    for (size_t index = 1; index <= this->thread_count; index++)
+        SDL_WaitThread(this->workers[index].thread, NULL);
+    this->thread_count = 0;
+    SDL_DestroyCondition(this->done);
+    SDL_DestroyCondition(this->wake);
+    SDL_DestroyMutex(this->mutex);
+    this->done = NULL;
+    this->wake = NULL;
+    this->mutex = NULL;
+}
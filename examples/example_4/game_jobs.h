@@ -0,0 +1,46 @@
+#ifndef GAME_JOBS_H
+# define GAME_JOBS_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_JOBS_MAX_WORKERS 8
+
+/*
+** `task` is in [0, task_count); `worker` is in [0, Game_Jobs_GetWorkerCount)
+** and identifies the calling thread, so a task can write to per-worker
+** storage without locking. The thread calling Game_Jobs_Run is worker 0.
+*/
+typedef void    (*Game_Job_Function)(void *context, size_t task, size_t worker);
+
+struct Game_Jobs;
+
+typedef struct Game_Jobs_Worker {
+    struct Game_Jobs    *jobs;
+    SDL_Thread  *thread;
+    size_t  index;
+}   Game_Jobs_Worker;
+
+typedef struct Game_Jobs {
+    Game_Jobs_Worker    workers[GAME_JOBS_MAX_WORKERS];
+    size_t  thread_count;
+    size_t  requested;
+    bool    started;
+    SDL_Mutex   *mutex;
+    SDL_Condition   *wake;
+    SDL_Condition   *done;
+    Game_Job_Function   function;
+    void    *context;
+    size_t  task_count;
+    SDL_AtomicInt   next_task;
+    size_t  pending;
+    Uint32  generation;
+    bool    quit;
+}   Game_Jobs;
+
+bool    Game_Jobs_Init(Game_Jobs *this, size_t threads);
+size_t  Game_Jobs_GetWorkerCount(const Game_Jobs *this);
+void    Game_Jobs_Run(Game_Jobs *this, Game_Job_Function function, void *context, size_t task_count);
+void    Game_Jobs_Destroy(Game_Jobs *this);
+
+#endif
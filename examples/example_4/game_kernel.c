@@ -0,0 +1,53 @@
+#include "game_kernel.h"
+
+#define GAME_KERNEL_QUERIED 0x80000000u
+
+static SDL_AtomicU32    game_kernel_supported;
+
+/* Bit n set when this build has intrinsics for instruction set n and this CPU runs it. */
+static Uint32   Game_Kernel_GetSupported(void) {
+    Uint32  supported;
+
+    if ((supported = SDL_GetAtomicU32(&game_kernel_supported)) != 0)
+        return (supported);
+    supported = GAME_KERNEL_QUERIED | 1u << GAME_KERNEL_ISA_NONE;
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE())
+        supported |= 1u << GAME_KERNEL_ISA_SSE;
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2())
+        supported |= 1u << GAME_KERNEL_ISA_SSE2;
+#endif
+#if defined(SDL_SSE2_INTRINSICS) && defined(SDL_SSE4_1_INTRINSICS)
+    if (SDL_HasSSE41())
+        supported |= 1u << GAME_KERNEL_ISA_SSE41;
+#endif
+#ifdef SDL_AVX_INTRINSICS
+    if (SDL_HasAVX())
+        supported |= 1u << GAME_KERNEL_ISA_AVX;
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2())
+        supported |= 1u << GAME_KERNEL_ISA_AVX2;
+#endif
+    SDL_SetAtomicU32(&game_kernel_supported, supported);
+    return (supported);
+}
+
+Game_Kernel Game_Kernel_GetBest(const Game_Kernel_Isa needs[GAME_KERNEL_COUNT]) {
+    Uint32  supported;
+    int     kernel;
+
+    supported = Game_Kernel_GetSupported();
+    for (kernel = GAME_KERNEL_COUNT - 1; kernel > GAME_KERNEL_SCALAR; kernel--)
+        if (supported & 1u << needs[kernel])
+            break ;
+    return ((Game_Kernel)kernel);
+}
+
+const char  *Game_Kernel_GetName(const Game_Kernel_Isa needs[GAME_KERNEL_COUNT], Game_Kernel kernel) {
+    static const char   *names[GAME_KERNEL_ISA_COUNT] = {"scalar", "sse", "sse", "sse", "avx", "avx2"};
+
+    return (names[needs[kernel]]);
+}
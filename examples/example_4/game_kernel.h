@@ -0,0 +1,38 @@
+#ifndef GAME_KERNEL_H
+# define GAME_KERNEL_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+/*
+** The kernels of a module with SIMD loops, narrowest first: a scalar one,
+** a 128-bit one and a 256-bit one. Each module indexes its own function
+** table with these and names the instruction set every entry needs.
+*/
+typedef enum Game_Kernel {
+    GAME_KERNEL_SCALAR,
+    GAME_KERNEL_SSE,
+    GAME_KERNEL_AVX,
+    GAME_KERNEL_COUNT,
+}   Game_Kernel;
+
+typedef enum Game_Kernel_Isa {
+    GAME_KERNEL_ISA_NONE,
+    GAME_KERNEL_ISA_SSE,
+    GAME_KERNEL_ISA_SSE2,
+    GAME_KERNEL_ISA_SSE41,
+    GAME_KERNEL_ISA_AVX,
+    GAME_KERNEL_ISA_AVX2,
+    GAME_KERNEL_ISA_COUNT,
+}   Game_Kernel_Isa;
+
+/*
+** The widest kernel whose instruction set this build has intrinsics for
+** and this CPU runs. The CPU is queried once per process, so this is
+** cheap, but not free enough for an inner loop: pick once and keep it.
+*/
+Game_Kernel Game_Kernel_GetBest(const Game_Kernel_Isa needs[GAME_KERNEL_COUNT]);
+/* Bench and log name of a kernel: "scalar", "sse", "avx" or "avx2". */
+const char  *Game_Kernel_GetName(const Game_Kernel_Isa needs[GAME_KERNEL_COUNT], Game_Kernel kernel);
+
+#endif
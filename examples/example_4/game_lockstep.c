@@ -0,0 +1,265 @@
+#include "game_lockstep.h"
+
+#define GAME_LOCKSTEP_LIMIT_X (GAME_FIXED(WINDOW_WIDTH) - GAME_LOCKSTEP_SIZE)
+#define GAME_LOCKSTEP_LIMIT_Y (GAME_FIXED(WINDOW_HEIGHT) - GAME_LOCKSTEP_SIZE)
+
+static Uint32   Game_Lockstep_Random(Uint32 *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return (*state);
+}
+
+void    Game_Lockstep_State_Init(Game_Lockstep_State *this, Uint32 seed) {
+    Game_Lockstep_Body  *body;
+
+    SDL_zerop(this);
+    this->random = seed ? seed : 0x9E3779B9u;
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+        this->player_x[player] = GAME_FIXED(WINDOW_WIDTH) / (GAME_LOCKSTEP_PLAYERS + 1) * (Game_Fixed)(player + 1);
+        this->player_y[player] = GAME_FIXED(WINDOW_HEIGHT / 2);
+    }
+    for (size_t index = 0; index < GAME_LOCKSTEP_BODIES; index++) {
+        body = &this->bodies[index];
+        body->x = (Game_Fixed)(Game_Lockstep_Random(&this->random) % (Uint32)GAME_LOCKSTEP_LIMIT_X);
+        body->y = (Game_Fixed)(Game_Lockstep_Random(&this->random) % (Uint32)GAME_LOCKSTEP_LIMIT_Y);
+        body->velocity_x = (Game_Fixed)(Game_Lockstep_Random(&this->random) % (Uint32)GAME_FIXED(8)) - GAME_FIXED(4);
+        body->velocity_y = (Game_Fixed)(Game_Lockstep_Random(&this->random) % (Uint32)GAME_FIXED(8)) - GAME_FIXED(4);
+    }
+}
+
+/* Same moves as GAME_COMMAND_LIST, on the isometric axes. */
+static void Game_Lockstep_MovePlayer(Game_Lockstep_State *this, size_t player, Uint32 input) {
+    Game_Fixed  x;
+    Game_Fixed  y;
+
+    x = this->player_x[player];
+    y = this->player_y[player];
+    if (input & GAME_INPUT_UP) {
+        x -= GAME_LOCKSTEP_SPEED;
+        y -= GAME_LOCKSTEP_SPEED / 2;
+    }
+    if (input & GAME_INPUT_DOWN) {
+        x += GAME_LOCKSTEP_SPEED;
+        y += GAME_LOCKSTEP_SPEED / 2;
+    }
+    if (input & GAME_INPUT_RIGHT) {
+        x += GAME_LOCKSTEP_SPEED;
+        y -= GAME_LOCKSTEP_SPEED / 2;
+    }
+    if (input & GAME_INPUT_LEFT) {
+        x -= GAME_LOCKSTEP_SPEED;
+        y += GAME_LOCKSTEP_SPEED / 2;
+    }
+    this->player_x[player] = SDL_clamp(x, 0, GAME_LOCKSTEP_LIMIT_X);
+    this->player_y[player] = SDL_clamp(y, 0, GAME_LOCKSTEP_LIMIT_Y);
+}
+
+static void Game_Lockstep_Bounce(Game_Fixed *position, Game_Fixed *velocity, Game_Fixed limit) {
+    *position += *velocity;
+    if (*position < 0) {
+        *position = -*position;
+        *velocity = -*velocity;
+    }
+    else if (*position > limit) {
+        *position = 2 * limit - *position;
+        *velocity = -*velocity;
+    }
+}
+
+/* Bodies a player touches are kicked away from it at a random speed. */
+static void Game_Lockstep_Push(Game_Lockstep_State *this, Game_Lockstep_Body *body, size_t player) {
+    Game_Fixed  dx;
+    Game_Fixed  dy;
+    Game_Fixed  speed;
+
+    dx = body->x - this->player_x[player];
+    dy = body->y - this->player_y[player];
+    if (dx <= -GAME_LOCKSTEP_SIZE || dx >= GAME_LOCKSTEP_SIZE || dy <= -GAME_LOCKSTEP_SIZE || dy >= GAME_LOCKSTEP_SIZE)
+        return ;
+    speed = GAME_FIXED_ONE + (Game_Fixed)(Game_Lockstep_Random(&this->random) % (Uint32)GAME_FIXED(4));
+    body->velocity_x = dx >= 0 ? speed : -speed;
+    body->velocity_y = dy >= 0 ? speed : -speed;
+}
+
+/* The whole simulation: it only reads the state and the inputs of this tick. */
+void    Game_Lockstep_Step(Game_Lockstep_State *this, const Uint32 inputs[GAME_LOCKSTEP_PLAYERS]) {
+    Game_Lockstep_Body  *body;
+
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++)
+        Game_Lockstep_MovePlayer(this, player, inputs[player]);
+    for (size_t index = 0; index < GAME_LOCKSTEP_BODIES; index++) {
+        body = &this->bodies[index];
+        Game_Lockstep_Bounce(&body->x, &body->velocity_x, GAME_LOCKSTEP_LIMIT_X);
+        Game_Lockstep_Bounce(&body->y, &body->velocity_y, GAME_LOCKSTEP_LIMIT_Y);
+        for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++)
+            Game_Lockstep_Push(this, body, player);
+    }
+    this->tick++;
+}
+
+Uint64  Game_Lockstep_State_Hash(const Game_Lockstep_State *this) {
+    return (Game_Snapshot_Hash(this, sizeof(*this)));
+}
+
+void    Game_Lockstep_Peer_Init(Game_Lockstep_Peer *this, size_t local, Uint32 seed) {
+    SDL_zerop(this);
+    Game_Lockstep_State_Init(&this->state, seed);
+    for (size_t slot = 0; slot < GAME_LOCKSTEP_WINDOW; slot++)
+        this->saved[slot].tick = GAME_LOCKSTEP_NO_TICK;
+    for (size_t slot = 0; slot < GAME_LOCKSTEP_INPUTS; slot++)
+        for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++)
+            this->input_ticks[slot][player] = GAME_LOCKSTEP_NO_TICK;
+    this->rollback_tick = GAME_LOCKSTEP_NO_TICK;
+    this->local = local;
+}
+
+/* Ticks below this one have every player's input: their states are final. */
+Uint32  Game_Lockstep_Peer_GetConfirmedTick(const Game_Lockstep_Peer *this) {
+    Uint32  tick;
+
+    tick = this->received[0];
+    for (size_t player = 1; player < GAME_LOCKSTEP_PLAYERS; player++)
+        tick = SDL_min(tick, this->received[player]);
+    return (tick);
+}
+
+/* Running one more tick must leave every unconfirmed tick within the snapshot window. */
+bool    Game_Lockstep_Peer_CanAdvance(const Game_Lockstep_Peer *this) {
+    return (this->state.tick + 1 - Game_Lockstep_Peer_GetConfirmedTick(this) <= GAME_LOCKSTEP_WINDOW);
+}
+
+/* Hash of the state at the start of `tick`, once no rollback can change it. */
+bool    Game_Lockstep_Peer_GetHash(const Game_Lockstep_Peer *this, Uint32 tick, Uint64 *hash) {
+    size_t  slot;
+
+    slot = tick % GAME_LOCKSTEP_WINDOW;
+    if (tick > Game_Lockstep_Peer_GetConfirmedTick(this) || this->saved[slot].tick != tick
+        || (this->rollback_tick != GAME_LOCKSTEP_NO_TICK && tick > this->rollback_tick))
+        return (false);
+    *hash = this->hashes[slot];
+    return (true);
+}
+
+static void Game_Lockstep_Peer_Confirm(Game_Lockstep_Peer *this, size_t player, Uint32 tick, Uint32 input) {
+    size_t  slot;
+
+    slot = tick % GAME_LOCKSTEP_INPUTS;
+    if (this->input_ticks[slot][player] == tick && this->confirmed[slot][player] == false
+        && this->inputs[slot][player] != input && (this->rollback_tick == GAME_LOCKSTEP_NO_TICK || tick < this->rollback_tick))
+        this->rollback_tick = tick;
+    this->inputs[slot][player] = input;
+    this->input_ticks[slot][player] = tick;
+    this->confirmed[slot][player] = true;
+    while (this->input_ticks[this->received[player] % GAME_LOCKSTEP_INPUTS][player] == this->received[player]
+        && this->confirmed[this->received[player] % GAME_LOCKSTEP_INPUTS][player]) {
+        this->last_input[player] = this->inputs[this->received[player] % GAME_LOCKSTEP_INPUTS][player];
+        this->received[player]++;
+    }
+}
+
+/* Saves the current state, then runs its tick with confirmed or predicted inputs. */
+static void Game_Lockstep_Peer_Simulate(Game_Lockstep_Peer *this) {
+    Uint32  inputs[GAME_LOCKSTEP_PLAYERS];
+    Uint32  tick;
+    size_t  slot;
+
+    tick = this->state.tick;
+    this->saved[tick % GAME_LOCKSTEP_WINDOW] = this->state;
+    this->hashes[tick % GAME_LOCKSTEP_WINDOW] = Game_Lockstep_State_Hash(&this->state);
+    slot = tick % GAME_LOCKSTEP_INPUTS;
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+        if (this->input_ticks[slot][player] != tick || this->confirmed[slot][player] == false) {
+            this->inputs[slot][player] = this->last_input[player];
+            this->input_ticks[slot][player] = tick;
+            this->confirmed[slot][player] = false;
+        }
+        inputs[player] = this->inputs[slot][player];
+    }
+    Game_Lockstep_Step(&this->state, inputs);
+}
+
+static void Game_Lockstep_Peer_Rollback(Game_Lockstep_Peer *this) {
+    Uint64  start;
+    Uint32  present;
+    size_t  depth;
+
+    if (this->rollback_tick == GAME_LOCKSTEP_NO_TICK)
+        return ;
+    start = SDL_GetTicksNS();
+    present = this->state.tick;
+    depth = present - this->rollback_tick;
+    this->state = this->saved[this->rollback_tick % GAME_LOCKSTEP_WINDOW];
+    this->rollback_tick = GAME_LOCKSTEP_NO_TICK;
+    while (this->state.tick < present)
+        Game_Lockstep_Peer_Simulate(this);
+    this->rollbacks++;
+    this->resimulated_ticks += depth;
+    this->rollback_depth_peak = SDL_max(this->rollback_depth_peak, depth);
+    this->rollback_ns += SDL_GetTicksNS() - start;
+}
+
+/*
+** Runs the next tick with the local `input` and fills `message` for the other
+** peers. Returns false, without consuming the input, while the peer is too far
+** ahead of its confirmed inputs and has to wait for the network.
+*/
+bool    Game_Lockstep_Peer_Advance(Game_Lockstep_Peer *this, Uint32 input, Game_Lockstep_Message *message) {
+    Uint32  tick;
+
+    if (Game_Lockstep_Peer_CanAdvance(this) == false)
+        return (false);
+    Game_Lockstep_Peer_Rollback(this);
+    tick = this->state.tick;
+    Game_Lockstep_Peer_Confirm(this, this->local, tick, input);
+    Game_Lockstep_Peer_Simulate(this);
+    message->tick = tick;
+    message->input = input;
+    message->hash_tick = Game_Lockstep_Peer_GetConfirmedTick(this);
+    if (Game_Lockstep_Peer_GetHash(this, message->hash_tick, &message->hash) == false)
+        message->hash_tick = GAME_LOCKSTEP_NO_TICK;
+    return (true);
+}
+
+void    Game_Lockstep_Peer_Receive(Game_Lockstep_Peer *this, size_t player, const Game_Lockstep_Message *message) {
+    Uint64  hash;
+
+    Game_Lockstep_Peer_Confirm(this, player, message->tick, message->input);
+    if (message->hash_tick == GAME_LOCKSTEP_NO_TICK || Game_Lockstep_Peer_GetHash(this, message->hash_tick, &hash) == false)
+        return ;
+    this->hash_checks++;
+    if (hash != message->hash)
+        this->desyncs++;
+}
+
+void    Game_Loopback_Init(Game_Loopback *this, Uint32 latency, Uint32 jitter, Uint32 seed) {
+    this->head = 0;
+    this->length = 0;
+    this->latency = latency;
+    this->jitter = jitter;
+    this->random = seed ? seed : 0x9E3779B9u;
+    this->last_delivery = 0;
+}
+
+bool    Game_Loopback_Send(Game_Loopback *this, const Game_Lockstep_Message *message, Uint32 now) {
+    size_t  slot;
+    Uint32  delay;
+
+    if (this->length == GAME_LOOPBACK_CAPACITY)
+        return (false);
+    delay = this->latency + (this->jitter ? Game_Lockstep_Random(&this->random) % (this->jitter + 1) : 0);
+    slot = (this->head + this->length++) % GAME_LOOPBACK_CAPACITY;
+    this->messages[slot] = *message;
+    this->deliver_at[slot] = SDL_max(now + delay, this->last_delivery);
+    this->last_delivery = this->deliver_at[slot];
+    return (true);
+}
+
+bool    Game_Loopback_Receive(Game_Loopback *this, Uint32 now, Game_Lockstep_Message *message) {
+    if (this->length == 0 || this->deliver_at[this->head] > now)
+        return (false);
+    *message = this->messages[this->head];
+    this->head = (this->head + 1) % GAME_LOOPBACK_CAPACITY;
+    this->length--;
+    return (true);
+}
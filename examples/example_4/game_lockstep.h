@@ -0,0 +1,110 @@
+#ifndef GAME_LOCKSTEP_H
+# define GAME_LOCKSTEP_H
+
+# include "game.h"
+
+# define GAME_FIXED_SHIFT 16
+# define GAME_FIXED_ONE (1 << GAME_FIXED_SHIFT)
+# define GAME_FIXED(integer) ((Game_Fixed)(integer) * GAME_FIXED_ONE)
+# define GAME_FIXED_TO_FLOAT(value) ((float)(value) / GAME_FIXED_ONE)
+
+# define GAME_LOCKSTEP_PLAYERS 2
+# define GAME_LOCKSTEP_WINDOW 16
+# define GAME_LOCKSTEP_INPUTS (GAME_LOCKSTEP_WINDOW * 4)
+# define GAME_LOCKSTEP_BODIES 512
+# define GAME_LOCKSTEP_SPEED GAME_FIXED(8)
+# define GAME_LOCKSTEP_SIZE GAME_FIXED(32)
+# define GAME_LOCKSTEP_NO_TICK 0xFFFFFFFFu
+# define GAME_LOOPBACK_CAPACITY 256
+
+/* 16.16 fixed point: integer arithmetic gives the same bits on every machine. */
+typedef Sint32  Game_Fixed;
+
+typedef struct Game_Lockstep_Body {
+    Game_Fixed  x;
+    Game_Fixed  y;
+    Game_Fixed  velocity_x;
+    Game_Fixed  velocity_y;
+}   Game_Lockstep_Body;
+
+/*
+** Everything a tick reads or writes, with no pointers and no padding, so a
+** snapshot is a struct copy and the hash covers every byte. One tick is one
+** DEFAULT_FPS frame; nothing depends on how long the frame really took.
+*/
+typedef struct Game_Lockstep_State {
+    Uint32  tick;
+    Uint32  random;
+    Game_Fixed  player_x[GAME_LOCKSTEP_PLAYERS];
+    Game_Fixed  player_y[GAME_LOCKSTEP_PLAYERS];
+    Game_Lockstep_Body  bodies[GAME_LOCKSTEP_BODIES];
+}   Game_Lockstep_State;
+
+/* What peers exchange: one tick of input, and the hash of a confirmed tick. */
+typedef struct Game_Lockstep_Message {
+    Uint32  tick;
+    Uint32  input;
+    Uint32  hash_tick;
+    Uint64  hash;
+}   Game_Lockstep_Message;
+
+/*
+** One player's view of the match. Remote inputs that have not arrived are
+** predicted (the last confirmed input is repeated) so the local simulation
+** never waits. When a real input differs from the prediction used, the next
+** Advance restores the snapshot of that tick and re-simulates up to the
+** present. `saved` holds the state at the start of tick t in slot
+** t % GAME_LOCKSTEP_WINDOW, which bounds how far a peer may run ahead of its
+** confirmed inputs.
+*/
+typedef struct Game_Lockstep_Peer {
+    Game_Lockstep_State state;
+    Game_Lockstep_State saved[GAME_LOCKSTEP_WINDOW];
+    Uint64  hashes[GAME_LOCKSTEP_WINDOW];
+    Uint32  inputs[GAME_LOCKSTEP_INPUTS][GAME_LOCKSTEP_PLAYERS];
+    Uint32  input_ticks[GAME_LOCKSTEP_INPUTS][GAME_LOCKSTEP_PLAYERS];
+    bool    confirmed[GAME_LOCKSTEP_INPUTS][GAME_LOCKSTEP_PLAYERS];
+    Uint32  received[GAME_LOCKSTEP_PLAYERS];
+    Uint32  last_input[GAME_LOCKSTEP_PLAYERS];
+    Uint32  rollback_tick;
+    size_t  local;
+    size_t  rollbacks;
+    size_t  resimulated_ticks;
+    size_t  rollback_depth_peak;
+    Uint64  rollback_ns;
+    size_t  hash_checks;
+    size_t  desyncs;
+}   Game_Lockstep_Peer;
+
+/*
+** In-process stand-in for the network: messages arrive `latency` ticks after
+** they are sent, plus up to `jitter` more, and in order, as over an ordered
+** transport.
+*/
+typedef struct Game_Loopback {
+    Game_Lockstep_Message   messages[GAME_LOOPBACK_CAPACITY];
+    Uint32  deliver_at[GAME_LOOPBACK_CAPACITY];
+    size_t  head;
+    size_t  length;
+    Uint32  latency;
+    Uint32  jitter;
+    Uint32  random;
+    Uint32  last_delivery;
+}   Game_Loopback;
+
+void    Game_Lockstep_State_Init(Game_Lockstep_State *this, Uint32 seed);
+void    Game_Lockstep_Step(Game_Lockstep_State *this, const Uint32 inputs[GAME_LOCKSTEP_PLAYERS]);
+Uint64  Game_Lockstep_State_Hash(const Game_Lockstep_State *this);
+
+void    Game_Lockstep_Peer_Init(Game_Lockstep_Peer *this, size_t local, Uint32 seed);
+bool    Game_Lockstep_Peer_CanAdvance(const Game_Lockstep_Peer *this);
+bool    Game_Lockstep_Peer_Advance(Game_Lockstep_Peer *this, Uint32 input, Game_Lockstep_Message *message);
+void    Game_Lockstep_Peer_Receive(Game_Lockstep_Peer *this, size_t player, const Game_Lockstep_Message *message);
+Uint32  Game_Lockstep_Peer_GetConfirmedTick(const Game_Lockstep_Peer *this);
+bool    Game_Lockstep_Peer_GetHash(const Game_Lockstep_Peer *this, Uint32 tick, Uint64 *hash);
+
+void    Game_Loopback_Init(Game_Loopback *this, Uint32 latency, Uint32 jitter, Uint32 seed);
+bool    Game_Loopback_Send(Game_Loopback *this, const Game_Lockstep_Message *message, Uint32 now);
+bool    Game_Loopback_Receive(Game_Loopback *this, Uint32 now, Game_Lockstep_Message *message);
+
+#endif
@@ -0,0 +1,87 @@
+#include "game_memory.h"
+
+static const char   *game_memory_names[GAME_MEMORY_CATEGORY_COUNT] = {
+    "surfaces", "textures", "mips", "entities", "particles", "render", "animations", "navigation", "collision", "timers", "snapshots", "audio", "capture", "logs", "structs"
+};
+
+static SDL_SpinLock game_memory_lock;
+static Sint64   game_memory_bytes[GAME_MEMORY_CATEGORY_COUNT];
+static Sint64   game_memory_peaks[GAME_MEMORY_CATEGORY_COUNT];
+static Sint64   game_memory_total;
+static Sint64   game_memory_total_peak;
+
+void    Game_Memory_Add(Game_Memory_Category category, Sint64 bytes) {
+    SDL_LockSpinlock(&game_memory_lock);
+    game_memory_bytes[category] += bytes;
+    game_memory_total += bytes;
+    if (game_memory_bytes[category] > game_memory_peaks[category])
+        game_memory_peaks[category] = game_memory_bytes[category];
+    if (game_memory_total > game_memory_total_peak)
+        game_memory_total_peak = game_memory_total;
+    SDL_UnlockSpinlock(&game_memory_lock);
+}
+
+static size_t   Game_Memory_Read(const Sint64 *counter) {
+    Sint64  bytes;
+
+    SDL_LockSpinlock(&game_memory_lock);
+    bytes = *counter;
+    SDL_UnlockSpinlock(&game_memory_lock);
+    return (bytes > 0 ? (size_t)bytes : 0);
+}
+
+size_t  Game_Memory_GetBytes(Game_Memory_Category category) {
+    return (Game_Memory_Read(&game_memory_bytes[category]));
+}
+
+size_t  Game_Memory_GetPeak(Game_Memory_Category category) {
+    return (Game_Memory_Read(&game_memory_peaks[category]));
+}
+
+size_t  Game_Memory_GetTotal(void) {
+    return (Game_Memory_Read(&game_memory_total));
+}
+
+size_t  Game_Memory_GetTotalPeak(void) {
+    return (Game_Memory_Read(&game_memory_total_peak));
+}
+
+size_t  Game_Memory_SurfaceBytes(const SDL_Surface *surface) {
+    if (surface == NULL)
+        return (0);
+    return ((size_t)surface->pitch * (size_t)surface->h);
+}
+
+size_t  Game_Memory_TextureBytes(const SDL_Texture *texture) {
+    if (texture == NULL)
+        return (0);
+    return ((size_t)texture->w * (size_t)texture->h * (size_t)SDL_BYTESPERPIXEL(texture->format));
+}
+
+void    Game_Memory_Print(FILE *output) {
+    fprintf(output, "memory KiB    now / peak ");
+    for (size_t category = 0; category < GAME_MEMORY_CATEGORY_COUNT; category++)
+        if (Game_Memory_GetPeak(category) != 0)
+            fprintf(output, " %s %.1f/%.1f", game_memory_names[category],
+                (double)Game_Memory_GetBytes(category) / 1024.0, (double)Game_Memory_GetPeak(category) / 1024.0);
+    fprintf(output, "  total %.1f/%.1f\n", (double)Game_Memory_GetTotal() / 1024.0,
+        (double)Game_Memory_GetTotalPeak() / 1024.0);
+}
+
+/* Reports every category that is not back to zero; returns whether there was one. */
+bool    Game_Memory_PrintLeaks(FILE *output) {
+    Sint64  bytes;
+    bool    leaked;
+
+    leaked = false;
+    for (size_t category = 0; category < GAME_MEMORY_CATEGORY_COUNT; category++) {
+        SDL_LockSpinlock(&game_memory_lock);
+        bytes = game_memory_bytes[category];
+        SDL_UnlockSpinlock(&game_memory_lock);
+        if (bytes == 0)
+            continue ;
+        fprintf(output, "memory leak   %s: %lld bytes still accounted\n", game_memory_names[category], (long long)bytes);
+        leaked = true;
+    }
+    return (leaked);
+}
@@ -0,0 +1,44 @@
+#ifndef GAME_MEMORY_H
+# define GAME_MEMORY_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+typedef enum Game_Memory_Category {
+    GAME_MEMORY_SURFACES,
+    GAME_MEMORY_TEXTURES,
+    GAME_MEMORY_MIPS,
+    GAME_MEMORY_ENTITIES,
+    GAME_MEMORY_PARTICLES,
+    GAME_MEMORY_RENDER,
+    GAME_MEMORY_ANIMATIONS,
+    GAME_MEMORY_NAVIGATION,
+    GAME_MEMORY_COLLISION,
+    GAME_MEMORY_TIMERS,
+    GAME_MEMORY_SNAPSHOTS,
+    GAME_MEMORY_AUDIO,
+    GAME_MEMORY_CAPTURE,
+    GAME_MEMORY_LOGS,
+    GAME_MEMORY_STRUCTS,
+    GAME_MEMORY_CATEGORY_COUNT,
+}   Game_Memory_Category;
+
+/*
+** Process-wide byte counts, one per category, with the peak each one and
+** their sum reached. Every owner adds what it allocates and subtracts what
+** it frees, so a category left above zero after Game_Quit is a leak.
+** Textures count width * height * bytes per pixel of their format, the copy
+** the renderer keeps; the driver's own overhead is not visible from here.
+** Safe to call from any thread.
+*/
+void    Game_Memory_Add(Game_Memory_Category category, Sint64 bytes);
+size_t  Game_Memory_GetBytes(Game_Memory_Category category);
+size_t  Game_Memory_GetPeak(Game_Memory_Category category);
+size_t  Game_Memory_GetTotal(void);
+size_t  Game_Memory_GetTotalPeak(void);
+size_t  Game_Memory_SurfaceBytes(const SDL_Surface *surface);
+size_t  Game_Memory_TextureBytes(const SDL_Texture *texture);
+void    Game_Memory_Print(FILE *output);
+bool    Game_Memory_PrintLeaks(FILE *output);
+
+#endif
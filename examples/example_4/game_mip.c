@@ -0,0 +1,195 @@
+#include "game_mip.h"
+#include "game_memory.h"
+
+/* Writes `width` pixels, each the rounded mean of a 2x2 block of the two source rows below. */
+typedef void    (*Game_Mip_Row)(Uint32 *destination, const Uint32 *top, const Uint32 *bottom, size_t width);
+
+/* Two channels per 32-bit half-word pair: four 8-bit values plus 2 never carry out of 16 bits. */
+static void Game_Mip_Row_Scalar(Uint32 *destination, const Uint32 *top, const Uint32 *bottom, size_t width) {
+    Uint32  low;
+    Uint32  high;
+
+    for (size_t x = 0; x < width; x++) {
+        low = (top[2 * x] & 0x00FF00FFu) + (top[2 * x + 1] & 0x00FF00FFu)
+            + (bottom[2 * x] & 0x00FF00FFu) + (bottom[2 * x + 1] & 0x00FF00FFu) + 0x00020002u;
+        high = (top[2 * x] >> 8 & 0x00FF00FFu) + (top[2 * x + 1] >> 8 & 0x00FF00FFu)
+            + (bottom[2 * x] >> 8 & 0x00FF00FFu) + (bottom[2 * x + 1] >> 8 & 0x00FF00FFu) + 0x00020002u;
+        destination[x] = (low >> 2 & 0x00FF00FFu) | (high >> 2 & 0x00FF00FFu) << 8;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/*
+** Four source pixels from each row, split into even and odd before widening
+** to 16 bits, so the vertical and horizontal sums are plain adds: [p0 + p1, p2 + p3].
+*/
+SDL_TARGETING("sse2") static inline __m128i Game_Mip_Sum_SSE2(__m128i top, __m128i bottom) {
+    __m128i even;
+    __m128i odd;
+
+    top = _mm_shuffle_epi32(top, _MM_SHUFFLE(3, 1, 2, 0));
+    bottom = _mm_shuffle_epi32(bottom, _MM_SHUFFLE(3, 1, 2, 0));
+    even = _mm_add_epi16(_mm_unpacklo_epi8(top, _mm_setzero_si128()), _mm_unpacklo_epi8(bottom, _mm_setzero_si128()));
+    odd = _mm_add_epi16(_mm_unpackhi_epi8(top, _mm_setzero_si128()), _mm_unpackhi_epi8(bottom, _mm_setzero_si128()));
+    return (_mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(even, odd), _mm_set1_epi16(2)), 2));
+}
+
+SDL_TARGETING("sse2") static void Game_Mip_Row_SSE(Uint32 *destination, const Uint32 *top, const Uint32 *bottom, size_t width) {
+    __m128i first;
+    __m128i second;
+    size_t  x;
+
+    for (x = 0; x + 4 <= width; x += 4) {
+        first = Game_Mip_Sum_SSE2(_mm_loadu_si128((const __m128i *)(top + 2 * x)),
+            _mm_loadu_si128((const __m128i *)(bottom + 2 * x)));
+        second = Game_Mip_Sum_SSE2(_mm_loadu_si128((const __m128i *)(top + 2 * x + 4)),
+            _mm_loadu_si128((const __m128i *)(bottom + 2 * x + 4)));
+        _mm_storeu_si128((__m128i *)(destination + x), _mm_packus_epi16(first, second));
+    }
+    Game_Mip_Row_Scalar(destination + x, top + 2 * x, bottom + 2 * x, width - x);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+/* The same per 128-bit lane: eight source pixels from each row give [q0, q1 | q2, q3]. */
+SDL_TARGETING("avx2") static inline __m256i Game_Mip_Sum_AVX2(__m256i top, __m256i bottom) {
+    __m256i even;
+    __m256i odd;
+
+    top = _mm256_shuffle_epi32(top, _MM_SHUFFLE(3, 1, 2, 0));
+    bottom = _mm256_shuffle_epi32(bottom, _MM_SHUFFLE(3, 1, 2, 0));
+    even = _mm256_add_epi16(_mm256_unpacklo_epi8(top, _mm256_setzero_si256()), _mm256_unpacklo_epi8(bottom, _mm256_setzero_si256()));
+    odd = _mm256_add_epi16(_mm256_unpackhi_epi8(top, _mm256_setzero_si256()), _mm256_unpackhi_epi8(bottom, _mm256_setzero_si256()));
+    return (_mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(even, odd), _mm256_set1_epi16(2)), 2));
+}
+
+/* The lane-wise pack leaves [q0 q1 q4 q5 | q2 q3 q6 q7]; the permute puts the pairs back in order. */
+SDL_TARGETING("avx2") static void Game_Mip_Row_AVX2(Uint32 *destination, const Uint32 *top, const Uint32 *bottom, size_t width) {
+    __m256i first;
+    __m256i second;
+    size_t  x;
+
+    for (x = 0; x + 8 <= width; x += 8) {
+        first = Game_Mip_Sum_AVX2(_mm256_loadu_si256((const __m256i *)(top + 2 * x)),
+            _mm256_loadu_si256((const __m256i *)(bottom + 2 * x)));
+        second = Game_Mip_Sum_AVX2(_mm256_loadu_si256((const __m256i *)(top + 2 * x + 8)),
+            _mm256_loadu_si256((const __m256i *)(bottom + 2 * x + 8)));
+        _mm256_storeu_si256((__m256i *)(destination + x),
+            _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    Game_Mip_Row_Scalar(destination + x, top + 2 * x, bottom + 2 * x, width - x);
+}
+#endif
+
+static const Game_Mip_Row   game_mip_rows[GAME_KERNEL_COUNT] = {
+    Game_Mip_Row_Scalar,
+#ifdef SDL_SSE2_INTRINSICS
+    Game_Mip_Row_SSE,
+#else
+    Game_Mip_Row_Scalar,
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    Game_Mip_Row_AVX2,
+#else
+    Game_Mip_Row_Scalar,
+#endif
+};
+
+/* What each kernel of the table above needs. */
+const Game_Kernel_Isa   game_mip_kernels[GAME_KERNEL_COUNT] = {GAME_KERNEL_ISA_NONE, GAME_KERNEL_ISA_SSE2, GAME_KERNEL_ISA_AVX2};
+
+/*
+** A new ARGB8888 surface of half the size, rounded down: an odd last row or
+** column is left out. The blend mode carries over, so the level is drawn
+** as the surface it came from.
+*/
+SDL_Surface *Game_Mip_HalveWith(SDL_Surface *surface, Game_Kernel kernel) {
+    SDL_Surface *converted;
+    SDL_Surface *half;
+    SDL_BlendMode   blend;
+    Game_Mip_Row    row;
+    const Uint8 *top;
+
+    if (surface == NULL || surface->w < 2 || surface->h < 2) {
+        SDL_SetError("mip: nothing to halve");
+        return (NULL);
+    }
+    converted = surface->format == SDL_PIXELFORMAT_ARGB8888 ? surface : SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+    if (converted == NULL || (half = SDL_CreateSurface(surface->w / 2, surface->h / 2, SDL_PIXELFORMAT_ARGB8888)) == NULL) {
+        if (converted != surface)
+            SDL_DestroySurface(converted);
+        return (NULL);
+    }
+    if (SDL_GetSurfaceBlendMode(surface, &blend))
+        SDL_SetSurfaceBlendMode(half, blend);
+    row = game_mip_rows[SDL_min(kernel, Game_Kernel_GetBest(game_mip_kernels))];
+    for (int y = 0; y < half->h; y++) {
+        top = (const Uint8 *)converted->pixels + (size_t)(2 * y) * (size_t)converted->pitch;
+        row((Uint32 *)((Uint8 *)half->pixels + (size_t)y * (size_t)half->pitch), (const Uint32 *)top,
+            (const Uint32 *)(top + converted->pitch), (size_t)half->w);
+    }
+    if (converted != surface)
+        SDL_DestroySurface(converted);
+    return (half);
+}
+
+SDL_Surface *Game_Mip_Halve(SDL_Surface *surface) {
+    return (Game_Mip_HalveWith(surface, Game_Kernel_GetBest(game_mip_kernels)));
+}
+
+void    Game_Mip_Chain_Init(Game_Mip_Chain *this) {
+    SDL_zerop(this);
+}
+
+/*
+** Halves `surface` until GAME_MIP_MAX_LEVELS levels are made or a side would
+** drop below GAME_MIP_MIN_SIDE, uploading each level. The surface stays the
+** caller's. On failure the chain is left empty and the texture is always
+** drawn at full size.
+*/
+bool    Game_Mip_Chain_Build(Game_Mip_Chain *this, SDL_Renderer *renderer, SDL_Surface *surface) {
+    SDL_Surface *level;
+    SDL_Surface *half;
+
+    Game_Mip_Chain_Destroy(this);
+    level = surface;
+    while (this->count < GAME_MIP_MAX_LEVELS && SDL_min(level->w, level->h) / 2 >= GAME_MIP_MIN_SIDE) {
+        half = Game_Mip_Halve(level);
+        if (level != surface)
+            SDL_DestroySurface(level);
+        if ((level = half) == NULL || (this->levels[this->count] = SDL_CreateTextureFromSurface(renderer, level)) == NULL) {
+            SDL_DestroySurface(level);
+            Game_Mip_Chain_Destroy(this);
+            return (false);
+        }
+        Game_Memory_Add(GAME_MEMORY_MIPS, (Sint64)Game_Memory_TextureBytes(this->levels[this->count]));
+        this->bytes += Game_Memory_TextureBytes(this->levels[this->count++]);
+    }
+    if (level != surface)
+        SDL_DestroySurface(level);
+    return (true);
+}
+
+/*
+** The level to draw at `scale` screen pixels per texel of the full-size
+** texture: the smallest one that still has at least a texel per pixel, so
+** minification never skips texels and nothing is magnified from a level
+** that is too coarse. 0 is the texture itself, n is levels[n - 1].
+*/
+size_t  Game_Mip_Chain_Select(const Game_Mip_Chain *this, float scale) {
+    size_t  level;
+
+    level = 0;
+    while (level < this->count && scale <= 0.5f) {
+        scale *= 2.f;
+        level++;
+    }
+    return (level);
+}
+
+void    Game_Mip_Chain_Destroy(Game_Mip_Chain *this) {
+    Game_Memory_Add(GAME_MEMORY_MIPS, -(Sint64)this->bytes);
+    for (size_t level = 0; level < this->count; level++)
+        SDL_DestroyTexture(this->levels[level]);
+    Game_Mip_Chain_Init(this);
+}
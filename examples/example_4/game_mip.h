@@ -0,0 +1,39 @@
+#ifndef GAME_MIP_H
+# define GAME_MIP_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+# include "game_kernel.h"
+
+/*
+** Levels below the full-size texture. The camera zooms out to 0.5 and the
+** render scale goes down to 0.25, so nothing is drawn smaller than 1/8 of
+** its size: three halvings cover it.
+*/
+# define GAME_MIP_MAX_LEVELS 3
+/* Textures are not halved below this side. */
+# define GAME_MIP_MIN_SIDE 4
+
+/*
+** Successively halved copies of a texture: levels[0] is half its size,
+** levels[1] a quarter... Each level is a 2x2 box filter of the one above,
+** on the premultiplied ARGB8888 pixels the loaders produce, so transparent
+** edges do not bleed dark fringes. `bytes` is what the levels add to the
+** texture, also counted in the "mips" memory category.
+*/
+typedef struct Game_Mip_Chain {
+    SDL_Texture *levels[GAME_MIP_MAX_LEVELS];
+    size_t  count;
+    size_t  bytes;
+}   Game_Mip_Chain;
+
+extern const Game_Kernel_Isa    game_mip_kernels[GAME_KERNEL_COUNT];
+
+SDL_Surface *Game_Mip_HalveWith(SDL_Surface *surface, Game_Kernel kernel);
+SDL_Surface *Game_Mip_Halve(SDL_Surface *surface);
+void    Game_Mip_Chain_Init(Game_Mip_Chain *this);
+bool    Game_Mip_Chain_Build(Game_Mip_Chain *this, SDL_Renderer *renderer, SDL_Surface *surface);
+size_t  Game_Mip_Chain_Select(const Game_Mip_Chain *this, float scale);
+void    Game_Mip_Chain_Destroy(Game_Mip_Chain *this);
+
+#endif
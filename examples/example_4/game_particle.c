@@ -0,0 +1,198 @@
+#include "game_particle.h"
+#include "game_memory.h"
+
+const Game_Particle_Emitter game_particle_dust = {
+    20.f, 60.f, -SDL_PI_F / 2, SDL_PI_F / 1.5f, 0.3f, 0.7f, 0xC08B7355
+};
+
+const Game_Particle_Emitter game_particle_sparks = {
+    150.f, 400.f, 0.f, 2 * SDL_PI_F, 0.15f, 0.45f, 0xFFFFD040
+};
+
+static size_t   Game_Particle_Align(size_t bytes) {
+    return ((bytes + GAME_PARTICLE_ALIGNMENT - 1) & ~(size_t)(GAME_PARTICLE_ALIGNMENT - 1));
+}
+
+bool    Game_Particle_Pool_Init(Game_Particle_Pool *this, size_t capacity, float size, SDL_Texture *texture) {
+    size_t  floats;
+    size_t  colors;
+    size_t  vertices;
+    size_t  indices;
+    char    *cursor;
+
+    floats = Game_Particle_Align(sizeof(float) * capacity);
+    colors = Game_Particle_Align(sizeof(Uint32) * capacity);
+    vertices = Game_Particle_Align(sizeof(SDL_Vertex) * 4 * capacity);
+    indices = Game_Particle_Align(sizeof(int) * 6 * capacity);
+    this->length = 0;
+    this->rendered = 0;
+    this->size = size;
+    this->gravity = GAME_PARTICLE_GRAVITY;
+    this->random = 0x9E3779B9u;
+    this->texture = texture;
+    this->block_bytes = floats * 6 + colors + vertices + indices;
+    this->block = SDL_aligned_alloc(GAME_PARTICLE_ALIGNMENT, this->block_bytes);
+    this->capacity = this->block != NULL ? capacity : 0;
+    this->limit = this->capacity;
+    if (this->block == NULL) {
+        this->block_bytes = 0;
+        return (false);
+    }
+    Game_Memory_Add(GAME_MEMORY_PARTICLES, (Sint64)this->block_bytes);
+    cursor = this->block;
+    this->x = (float *)cursor;
+    this->y = (float *)(cursor += floats);
+    this->velocity_x = (float *)(cursor += floats);
+    this->velocity_y = (float *)(cursor += floats);
+    this->life = (float *)(cursor += floats);
+    this->life_scale = (float *)(cursor += floats);
+    this->color = (Uint32 *)(cursor += floats);
+    this->vertices = (SDL_Vertex *)(cursor += colors);
+    this->indices = (int *)(cursor += vertices);
+    for (size_t index = 0; index < capacity; index++) {
+        this->vertices[index * 4 + 0].tex_coord = (SDL_FPoint){0.f, 0.f};
+        this->vertices[index * 4 + 1].tex_coord = (SDL_FPoint){1.f, 0.f};
+        this->vertices[index * 4 + 2].tex_coord = (SDL_FPoint){1.f, 1.f};
+        this->vertices[index * 4 + 3].tex_coord = (SDL_FPoint){0.f, 1.f};
+        this->indices[index * 6 + 0] = (int)(index * 4 + 0);
+        this->indices[index * 6 + 1] = (int)(index * 4 + 1);
+        this->indices[index * 6 + 2] = (int)(index * 4 + 2);
+        this->indices[index * 6 + 3] = (int)(index * 4 + 0);
+        this->indices[index * 6 + 4] = (int)(index * 4 + 2);
+        this->indices[index * 6 + 5] = (int)(index * 4 + 3);
+    }
+    return (true);
+}
+
+void    Game_Particle_Pool_SetLimit(Game_Particle_Pool *this, size_t limit) {
+    this->limit = SDL_min(limit, this->capacity);
+}
+
+static float    Game_Particle_Random(Game_Particle_Pool *this, float min, float max) {
+    this->random ^= this->random << 13;
+    this->random ^= this->random >> 17;
+    this->random ^= this->random << 5;
+    return (min + (max - min) * (float)(this->random >> 8) * (1.f / 16777216.f));
+}
+
+/* Returns how many particles were spawned; the pool limit can cut a burst short. */
+size_t  Game_Particle_Pool_Emit(Game_Particle_Pool *this, float x, float y, size_t count, const Game_Particle_Emitter *emitter) {
+    size_t  index;
+    float   angle;
+    float   speed;
+
+    if (this->length >= this->limit)
+        return (0);
+    count = SDL_min(count, this->limit - this->length);
+    for (size_t spawned = 0; spawned < count; spawned++) {
+        index = this->length++;
+        angle = emitter->angle + Game_Particle_Random(this, -emitter->spread, emitter->spread) / 2;
+        speed = Game_Particle_Random(this, emitter->speed_min, emitter->speed_max);
+        this->x[index] = x;
+        this->y[index] = y;
+        this->velocity_x[index] = SDL_cosf(angle) * speed;
+        this->velocity_y[index] = SDL_sinf(angle) * speed;
+        this->life[index] = Game_Particle_Random(this, emitter->life_min, emitter->life_max);
+        this->life_scale[index] = 1.f / this->life[index];
+        this->color[index] = emitter->color;
+    }
+    return (count);
+}
+
+static void Game_Particle_Integrate(float *restrict x, float *restrict y, float *restrict velocity_x,
+    float *restrict velocity_y, float *restrict life, size_t length, float delta, float gravity) {
+    for (size_t index = 0; index < length; index++) {
+        velocity_y[index] += gravity * delta;
+        x[index] += velocity_x[index] * delta;
+        y[index] += velocity_y[index] * delta;
+        life[index] -= delta;
+    }
+}
+
+static void Game_Particle_Pool_Move(Game_Particle_Pool *this, size_t destination, size_t source) {
+    this->x[destination] = this->x[source];
+    this->y[destination] = this->y[source];
+    this->velocity_x[destination] = this->velocity_x[source];
+    this->velocity_y[destination] = this->velocity_y[source];
+    this->life[destination] = this->life[source];
+    this->life_scale[destination] = this->life_scale[source];
+    this->color[destination] = this->color[source];
+}
+
+/* A branch-free integration pass, then swap-compaction of the dead. */
+void    Game_Particle_Pool_Update(Game_Particle_Pool *this, float delta) {
+    size_t  index;
+
+    Game_Particle_Integrate(this->x, this->y, this->velocity_x, this->velocity_y, this->life,
+        this->length, delta, this->gravity);
+    index = 0;
+    while (index < this->length) {
+        if (this->life[index] > 0.f)
+            index++;
+        else
+            Game_Particle_Pool_Move(this, index, --this->length);
+    }
+}
+
+/* Copies what Render reads; a snapshot pool is only ever drawn, never updated. */
+void    Game_Particle_Pool_Snapshot(Game_Particle_Pool *this, const Game_Particle_Pool *source) {
+    this->length = SDL_min(source->length, this->capacity);
+    this->size = source->size;
+    this->texture = source->texture;
+    SDL_memcpy(this->x, source->x, sizeof(float) * this->length);
+    SDL_memcpy(this->y, source->y, sizeof(float) * this->length);
+    SDL_memcpy(this->life, source->life, sizeof(float) * this->length);
+    SDL_memcpy(this->life_scale, source->life_scale, sizeof(float) * this->length);
+    SDL_memcpy(this->color, source->color, sizeof(Uint32) * this->length);
+}
+
+/*
+** Every visible particle becomes a quad of one SDL_RenderGeometry call.
+** Quads are packed as they are written, so culled particles cost only the
+** bounds test. Without a view, particles are in renderer coordinates.
+*/
+bool    Game_Particle_Pool_Render(Game_Particle_Pool *this, SDL_Renderer *renderer, const Game_Camera_View *view) {
+    SDL_Vertex  *vertex;
+    SDL_FColor  color;
+    SDL_FPoint  offset;
+    float   half;
+    float   left;
+    float   top;
+
+    half = this->size / 2;
+    offset = view != NULL ? (SDL_FPoint){view->offset_x - half, view->offset_y - half} : (SDL_FPoint){-half, -half};
+    this->rendered = 0;
+    for (size_t index = 0; index < this->length; index++) {
+        if (view != NULL && Game_Camera_View_IsVisible(view, this->x[index] - half, this->y[index] - half, this->size, this->size) == false)
+            continue ;
+        vertex = &this->vertices[this->rendered++ * 4];
+        color.r = (float)((this->color[index] >> 16) & 0xFF) * (1.f / 255.f);
+        color.g = (float)((this->color[index] >> 8) & 0xFF) * (1.f / 255.f);
+        color.b = (float)(this->color[index] & 0xFF) * (1.f / 255.f);
+        color.a = (float)(this->color[index] >> 24) * (1.f / 255.f) * SDL_min(this->life[index] * this->life_scale[index], 1.f);
+        left = this->x[index] + offset.x;
+        top = this->y[index] + offset.y;
+        vertex[0].position = (SDL_FPoint){left, top};
+        vertex[1].position = (SDL_FPoint){left + this->size, top};
+        vertex[2].position = (SDL_FPoint){left + this->size, top + this->size};
+        vertex[3].position = (SDL_FPoint){left, top + this->size};
+        vertex[0].color = color;
+        vertex[1].color = color;
+        vertex[2].color = color;
+        vertex[3].color = color;
+    }
+    if (this->rendered == 0)
+        return (true);
+    return (SDL_RenderGeometry(renderer, this->texture, this->vertices, (int)(this->rendered * 4),
+        this->indices, (int)(this->rendered * 6)));
+}
+
+void    Game_Particle_Pool_Destroy(Game_Particle_Pool *this) {
+    Game_Memory_Add(GAME_MEMORY_PARTICLES, -(Sint64)this->block_bytes);
+    SDL_aligned_free(this->block);
+    this->block = NULL;
+    this->block_bytes = 0;
+    this->length = 0;
+    this->capacity = 0;
+    this->limit = 0;
+}
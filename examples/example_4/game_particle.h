@@ -0,0 +1,61 @@
+#ifndef GAME_PARTICLE_H
+# define GAME_PARTICLE_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+# include "game_camera.h"
+
+# define GAME_PARTICLE_CAPACITY 20000
+# define GAME_PARTICLE_ALIGNMENT 32
+# define GAME_PARTICLE_GRAVITY 240.f
+
+typedef struct Game_Particle_Emitter {
+    float   speed_min;
+    float   speed_max;
+    float   angle;
+    float   spread;
+    float   life_min;
+    float   life_max;
+    Uint32  color;
+}   Game_Particle_Emitter;
+
+/*
+** Fixed-capacity structure-of-arrays pool: one aligned allocation holds every
+** attribute array, live particles are packed in [0, length) and a dead one is
+** replaced by the last live particle. The vertex and index buffers for the
+** batched draw are sized for the whole capacity at init.
+*/
+typedef struct Game_Particle_Pool {
+    float   *x;
+    float   *y;
+    float   *velocity_x;
+    float   *velocity_y;
+    float   *life;
+    float   *life_scale;
+    Uint32  *color;
+    SDL_Vertex  *vertices;
+    int     *indices;
+    void    *block;
+    size_t  block_bytes;
+    size_t  length;
+    size_t  rendered;
+    size_t  capacity;
+    size_t  limit;
+    float   size;
+    float   gravity;
+    Uint32  random;
+    SDL_Texture *texture;
+}   Game_Particle_Pool;
+
+extern const Game_Particle_Emitter  game_particle_dust;
+extern const Game_Particle_Emitter  game_particle_sparks;
+
+bool    Game_Particle_Pool_Init(Game_Particle_Pool *this, size_t capacity, float size, SDL_Texture *texture);
+void    Game_Particle_Pool_SetLimit(Game_Particle_Pool *this, size_t limit);
+size_t  Game_Particle_Pool_Emit(Game_Particle_Pool *this, float x, float y, size_t count, const Game_Particle_Emitter *emitter);
+void    Game_Particle_Pool_Update(Game_Particle_Pool *this, float delta);
+void    Game_Particle_Pool_Snapshot(Game_Particle_Pool *this, const Game_Particle_Pool *source);
+bool    Game_Particle_Pool_Render(Game_Particle_Pool *this, SDL_Renderer *renderer, const Game_Camera_View *view);
+void    Game_Particle_Pool_Destroy(Game_Particle_Pool *this);
+
+#endif
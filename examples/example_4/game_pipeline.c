@@ -0,0 +1,185 @@
+#include "game_pipeline.h"
+
+static bool Game_Frame_State_Capture(Game_Frame_State *this, Game *game, Uint64 input_ns) {
+    if (Game_Sprite_Array_Reserve(&this->sprites, game->sprites.length) == false)
+        return (false);
+    if (game->sprites.length != 0) {
+        SDL_memcpy(this->sprites.content, game->sprites.content, sizeof(Game_Sprite) * game->sprites.length);
+        SDL_memcpy(this->sprites.sources, game->sprites.sources, sizeof(SDL_FRect) * game->sprites.length);
+    }
+    this->sprites.length = game->sprites.length;
+    Game_Particle_Pool_Snapshot(&this->particles, &game->particles);
+    this->camera = game->camera;
+    this->player = game->player.coordinates;
+    this->input_ns = input_ns;
+    return (true);
+}
+
+/* Runs on the simulation thread, which owns the live game state meanwhile. */
+static bool Game_Pipeline_Step(Game_Pipeline *this) {
+    Game    *game;
+    Uint64  start;
+    bool    captured;
+
+    game = this->game;
+    start = SDL_GetTicksNS();
+    Game_MovePlayer(game, this->input.buttons);
+    if (this->input.buttons & GAME_INPUT_SAVE)
+        Game_QuickSave(game);
+    if (this->input.buttons & GAME_INPUT_LOAD)
+        Game_QuickLoad(game);
+    if (this->input.zoom != 0)
+        Game_Camera_SetZoom(&game->camera, game->camera.zoom * SDL_powf(GAME_CAMERA_ZOOM_STEP, (float)this->input.zoom));
+    Game_Simulate(game);
+    captured = Game_Frame_State_Capture(&this->slots[this->back], game, this->input.sampled_ns);
+    this->back = SDL_SetAtomicInt(&this->ready, this->back);
+    this->simulation_ns = SDL_GetTicksNS() - start;
+    return (captured);
+}
+
+static int  Game_Pipeline_Main(void *data) {
+    Game_Pipeline   *this;
+
+    this = data;
+    while (true) {
+        SDL_WaitSemaphore(this->produce);
+        if (this->quit)
+            break ;
+        if (Game_Pipeline_Step(this) == false)
+            this->quit = true;
+        SDL_SignalSemaphore(this->produced);
+    }
+    return (0);
+}
+
+bool    Game_Pipeline_Init(Game_Pipeline *this, Game *game) {
+    bool    ready;
+
+    this->game = game;
+    this->front = 0;
+    this->back = 1;
+    SDL_SetAtomicInt(&this->ready, 2);
+    this->thread = NULL;
+    this->quit = false;
+    this->simulation_ns = 0;
+    this->input = (Game_Input){0, 0, 0};
+    Game_Command_Handler_Init(&this->handler, &game->player);
+    this->handler.window = &game->window;
+    this->handler.hud = &game->hud;
+    this->produce = SDL_CreateSemaphore(0);
+    this->produced = SDL_CreateSemaphore(0);
+    ready = this->produce != NULL && this->produced != NULL;
+    for (size_t slot = 0; slot < GAME_PIPELINE_SLOTS; slot++) {
+        Game_Sprite_Array_Init(&this->slots[slot].sprites);
+        if (Game_Particle_Pool_Init(&this->slots[slot].particles, game->particles.capacity,
+            game->particles.size, game->particles.texture) == false)
+            ready = false;
+    }
+    if (ready == false || Game_Frame_State_Capture(&this->slots[this->front], game, SDL_GetTicksNS()) == false
+        || (this->thread = SDL_CreateThread(Game_Pipeline_Main, "game_simulation", this)) == NULL) {
+        Game_Pipeline_Destroy(this);
+        return (false);
+    }
+    return (true);
+}
+
+void    Game_Pipeline_Destroy(Game_Pipeline *this) {
+    if (this->thread != NULL) {
+        this->quit = true;
+        SDL_SignalSemaphore(this->produce);
+        SDL_WaitThread(this->thread, NULL);
+        this->thread = NULL;
+    }
+    SDL_DestroySemaphore(this->produce);
+    SDL_DestroySemaphore(this->produced);
+    this->produce = NULL;
+    this->produced = NULL;
+    for (size_t slot = 0; slot < GAME_PIPELINE_SLOTS; slot++) {
+        Game_Sprite_Array_Destroy(&this->slots[slot].sprites);
+        Game_Particle_Pool_Destroy(&this->slots[slot].particles);
+    }
+}
+
+/*
+** Window and overlay keys act at once: the simulation thread is parked here
+** and only this thread draws. Moves, zoom and quick-save wait for the
+** simulation step.
+*/
+static void Game_Pipeline_PollInput(Game_Pipeline *this, bool *running) {
+    SDL_Event   event;
+    const bool  *keys;
+    Game_Input  input;
+
+    input = (Game_Input){0, 0, 0};
+    while (SDL_PollEvent(&event) == true) {
+        if (event.type == SDL_EVENT_QUIT || (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_ESCAPE))
+            *running = false;
+        else if (Game_Idle_HandleEvent(&this->game->idle, &event))
+            continue ;
+        else if (event.type == SDL_EVENT_KEY_DOWN) {
+            Game_Command_Handler_HandleWindowKey(&this->handler, event.key.key);
+            Game_Command_Handler_HandleOverlayKey(&this->handler, event.key.key);
+            input.zoom += (event.key.key == SDLK_EQUALS) - (event.key.key == SDLK_MINUS);
+            input.buttons |= (event.key.key == SDLK_F5 ? GAME_INPUT_SAVE : 0) | (event.key.key == SDLK_F9 ? GAME_INPUT_LOAD : 0);
+        }
+    }
+    keys = SDL_GetKeyboardState(NULL);
+    input.buttons |= (keys[SDL_SCANCODE_UP] ? GAME_INPUT_UP : 0) | (keys[SDL_SCANCODE_DOWN] ? GAME_INPUT_DOWN : 0)
+        | (keys[SDL_SCANCODE_LEFT] ? GAME_INPUT_LEFT : 0) | (keys[SDL_SCANCODE_RIGHT] ? GAME_INPUT_RIGHT : 0);
+    input.sampled_ns = SDL_GetTicksNS();
+    this->input = input;
+}
+
+/*
+** Frame N: sample input, release the simulation thread to build state N+1
+** from it, draw state N meanwhile, then meet at the sync point and swap.
+** A frame costs about max(simulation, render) instead of their sum; the
+** picture on screen is one frame older than the input, as the latency
+** statistics show. Adaptive changes are applied at the sync point, while the
+** simulation thread is parked, and the audio device opened there for the
+** first sound it asked for; so is idling: the simulation thread stays parked
+** while the last front state is kept on screen. Returns false if the
+** pipeline cannot start.
+*/
+bool    Game_Pipeline_Loop(Game *game) {
+    Game_Pipeline   pipeline;
+    Game_Frame_State    *state;
+    bool    running;
+
+    if (Game_Pipeline_Init(&pipeline, game) == false) {
+        SDL_Log("pipeline: cannot start (%s), running serially", SDL_GetError());
+        return (false);
+    }
+    running = true;
+    Game_Timer_Start(&game->timer);
+    while (running) {
+        game->frame_start_ns = SDL_GetTicksNS();
+        Game_Pipeline_PollInput(&pipeline, &running);
+        if (running && Game_Idle_IsIdle(&game->idle)) {
+            Game_WaitWhileIdle(game, &pipeline.handler, &pipeline.slots[pipeline.front], &running);
+            continue ;
+        }
+        SDL_SignalSemaphore(pipeline.produce);
+        state = &pipeline.slots[pipeline.front];
+        Game_Render(game, state);
+        if (game->stats != NULL)
+            Game_Frame_Stats_RecordLatency(game->stats, SDL_GetTicksNS() - state->input_ns);
+        SDL_WaitSemaphore(pipeline.produced);
+        pipeline.front = SDL_SetAtomicInt(&pipeline.ready, pipeline.front);
+        Game_StartAudio(game);
+        if (pipeline.quit) {
+            Game_Error_Append(&game->error, GAME_ALLOCATION_ERROR);
+            running = false;
+        }
+        if (Game_Adaptive_Record(&game->adaptive, game->frame_cost_ns))
+            Game_ApplyAdaptiveLevel(game);
+        Game_Timer_Sync(&game->timer);
+        if (game->stats != NULL)
+            Game_Frame_Stats_Record(game->stats, SDL_GetTicksNS() - game->frame_start_ns,
+                game->window.draw_calls, game->window.fill_pixels, game->window.fill_texels);
+        if (game->frame_limit != 0 && ++game->frame >= game->frame_limit)
+            running = false;
+    }
+    Game_Pipeline_Destroy(&pipeline);
+    return (true);
+}
@@ -0,0 +1,44 @@
+#ifndef GAME_PIPELINE_H
+# define GAME_PIPELINE_H
+
+# include "game.h"
+
+# define GAME_PIPELINE_SLOTS 3
+
+# define GAME_INPUT_SAVE 0x10u
+# define GAME_INPUT_LOAD 0x20u
+
+/* Input sampled on the main thread for the next simulation step. */
+typedef struct Game_Input {
+    Uint32  buttons;
+    int     zoom;
+    Uint64  sampled_ns;
+}   Game_Input;
+
+/*
+** Three frame states. The simulation thread owns `back` and the main thread
+** owns `front`; `ready` holds the third, and both sides swap their slot with
+** it by atomic exchange, never by copying. The two semaphores only park the
+** threads: `produce` starts one simulation step, `produced` is the per-frame
+** sync point after which the main thread takes the new state.
+*/
+typedef struct Game_Pipeline {
+    Game_Frame_State    slots[GAME_PIPELINE_SLOTS];
+    int     front;
+    int     back;
+    SDL_AtomicInt   ready;
+    SDL_Semaphore   *produce;
+    SDL_Semaphore   *produced;
+    SDL_Thread  *thread;
+    Game    *game;
+    Game_Command_Handler    handler;
+    Game_Input  input;
+    Uint64  simulation_ns;
+    bool    quit;
+}   Game_Pipeline;
+
+bool    Game_Pipeline_Init(Game_Pipeline *this, Game *game);
+void    Game_Pipeline_Destroy(Game_Pipeline *this);
+bool    Game_Pipeline_Loop(Game *game);
+
+#endif
@@ -0,0 +1,260 @@
+#include "game_render_list.h"
+#include "game_memory.h"
+
+#define GAME_RENDER_BUCKET_BYTES (sizeof(Game_Render_Command) + sizeof(Game_Render_Entry) * 2)
+#define GAME_RENDER_QUAD_BYTES (sizeof(SDL_Vertex) * 4 + sizeof(int) * 6)
+
+Uint64  Game_Render_Key(Game_Render_Layer layer, Uint16 texture, float depth, size_t sequence) {
+    Sint64  biased;
+
+    biased = SDL_clamp((Sint64)depth + GAME_RENDER_DEPTH_BIAS, 0, GAME_RENDER_DEPTH_MAX);
+    if (layer == GAME_LAYER_EFFECTS)
+        return (((Uint64)layer << GAME_RENDER_LAYER_SHIFT) | ((Uint64)texture << GAME_RENDER_TEXTURE_SHIFT)
+            | ((Uint64)biased << GAME_RENDER_DEPTH_SHIFT) | (Uint64)(sequence & 0xFFFF));
+    return (((Uint64)layer << GAME_RENDER_LAYER_SHIFT) | ((Uint64)biased << GAME_RENDER_ORDERED_DEPTH_SHIFT)
+        | ((Uint64)texture << GAME_RENDER_ORDERED_TEXTURE_SHIFT) | (Uint64)(sequence & 0xFFFF));
+}
+
+void    Game_Render_List_Init(Game_Render_List *this) {
+    for (size_t index = 0; index < GAME_JOBS_MAX_WORKERS; index++)
+        this->buckets[index] = (Game_Render_Bucket){NULL, NULL, NULL, 0, 0};
+    this->bucket_count = 1;
+    this->sorted = NULL;
+    this->length = 0;
+    this->capacity = 0;
+    this->cursor = 0;
+    this->vertices = NULL;
+    this->indices = NULL;
+    this->quad_capacity = 0;
+    this->draw_calls = 0;
+    this->area = 0;
+    this->texels = 0;
+    this->error = false;
+}
+
+void    Game_Render_List_Begin(Game_Render_List *this, size_t bucket_count) {
+    this->bucket_count = SDL_clamp(bucket_count, 1, GAME_JOBS_MAX_WORKERS);
+    for (size_t index = 0; index < this->bucket_count; index++)
+        this->buckets[index].length = 0;
+    this->length = 0;
+    this->cursor = 0;
+    this->draw_calls = 0;
+    this->area = 0;
+    this->texels = 0;
+    this->error = false;
+}
+
+static bool Game_Render_Bucket_Grow(Game_Render_Bucket *this) {
+    Game_Render_Command *commands;
+    Game_Render_Entry   *entries;
+    Game_Render_Entry   *scratch;
+    size_t  capacity;
+
+    capacity = this->capacity ? this->capacity * 2 : 1024;
+    if ((commands = realloc(this->commands, sizeof(Game_Render_Command) * capacity)) == NULL)
+        return (false);
+    this->commands = commands;
+    if ((entries = realloc(this->entries, sizeof(Game_Render_Entry) * capacity)) == NULL)
+        return (false);
+    this->entries = entries;
+    if ((scratch = realloc(this->scratch, sizeof(Game_Render_Entry) * capacity)) == NULL)
+        return (false);
+    this->scratch = scratch;
+    Game_Memory_Add(GAME_MEMORY_RENDER, (Sint64)((capacity - this->capacity) * GAME_RENDER_BUCKET_BYTES));
+    this->capacity = capacity;
+    return (true);
+}
+
+/* Safe to call concurrently as long as each thread owns its bucket. */
+void    Game_Render_List_Push(Game_Render_List *this, size_t bucket, Uint64 key, SDL_Texture *texture, const SDL_FRect *source, const SDL_FRect *destination) {
+    Game_Render_Bucket  *target;
+
+    target = &this->buckets[bucket];
+    if (target->length == target->capacity && Game_Render_Bucket_Grow(target) == false) {
+        this->error = true;
+        return ;
+    }
+    target->commands[target->length++] = (Game_Render_Command){key, texture, *source, *destination};
+}
+
+/*
+** LSD radix sort, one byte per pass. All eight histograms come from a single
+** read of the keys, and a pass whose byte is the same for every key (the
+** layer of a one-layer bucket, the unused bits of the depth...) is skipped.
+*/
+static void Game_Render_Bucket_Sort(Game_Render_Bucket *this) {
+    size_t  counts[8][256];
+    size_t  offset;
+    size_t  count;
+    Game_Render_Entry   *swap;
+
+    if (this->length == 0)
+        return ;
+    SDL_memset(counts, 0, sizeof(counts));
+    for (size_t index = 0; index < this->length; index++) {
+        this->entries[index] = (Game_Render_Entry){this->commands[index].key, &this->commands[index]};
+        for (size_t pass = 0; pass < 8; pass++)
+            counts[pass][(this->commands[index].key >> (pass * 8)) & 0xFF]++;
+    }
+    for (size_t pass = 0; pass < 8; pass++) {
+        if (counts[pass][(this->entries[0].key >> (pass * 8)) & 0xFF] == this->length)
+            continue ;
+        offset = 0;
+        for (size_t digit = 0; digit < 256; digit++) {
+            count = counts[pass][digit];
+            counts[pass][digit] = offset;
+            offset += count;
+        }
+        for (size_t index = 0; index < this->length; index++)
+            this->scratch[counts[pass][(this->entries[index].key >> (pass * 8)) & 0xFF]++] = this->entries[index];
+        swap = this->entries;
+        this->entries = this->scratch;
+        this->scratch = swap;
+    }
+}
+
+static void Game_Render_List_SortTask(void *context, size_t task, size_t worker) {
+    (void)worker;
+    Game_Render_Bucket_Sort(&((Game_Render_List *)context)->buckets[task]);
+}
+
+/* Buckets are few (one per worker): a linear scan of their heads is enough. */
+static void Game_Render_List_Merge(Game_Render_List *this) {
+    size_t  heads[GAME_JOBS_MAX_WORKERS];
+    size_t  best;
+
+    SDL_memset(heads, 0, sizeof(heads));
+    for (size_t index = 0; index < this->length; index++) {
+        best = this->bucket_count;
+        for (size_t bucket = 0; bucket < this->bucket_count; bucket++)
+            if (heads[bucket] < this->buckets[bucket].length && (best == this->bucket_count
+                || this->buckets[bucket].entries[heads[bucket]].key < this->buckets[best].entries[heads[best]].key))
+                best = bucket;
+        this->sorted[index] = this->buckets[best].entries[heads[best]++];
+    }
+}
+
+void    Game_Render_List_Sort(Game_Render_List *this, Game_Jobs *jobs) {
+    Game_Render_Entry   *sorted;
+    size_t  length;
+
+    length = 0;
+    for (size_t bucket = 0; bucket < this->bucket_count; bucket++)
+        length += this->buckets[bucket].length;
+    if (length > this->capacity) {
+        if ((sorted = realloc(this->sorted, sizeof(Game_Render_Entry) * length)) == NULL) {
+            this->error = true;
+            return ;
+        }
+        this->sorted = sorted;
+        Game_Memory_Add(GAME_MEMORY_RENDER, (Sint64)((length - this->capacity) * sizeof(Game_Render_Entry)));
+        this->capacity = length;
+    }
+    Game_Jobs_Run(jobs, Game_Render_List_SortTask, this, this->bucket_count);
+    this->length = length;
+    this->cursor = 0;
+    Game_Render_List_Merge(this);
+}
+
+static bool Game_Render_List_Reserve(Game_Render_List *this, size_t quads) {
+    SDL_Vertex  *vertices;
+    int     *indices;
+
+    if (quads <= this->quad_capacity)
+        return (true);
+    if ((vertices = realloc(this->vertices, sizeof(SDL_Vertex) * 4 * quads)) == NULL)
+        return (false);
+    this->vertices = vertices;
+    if ((indices = realloc(this->indices, sizeof(int) * 6 * quads)) == NULL)
+        return (false);
+    this->indices = indices;
+    for (size_t quad = this->quad_capacity; quad < quads; quad++) {
+        indices[quad * 6 + 0] = (int)(quad * 4 + 0);
+        indices[quad * 6 + 1] = (int)(quad * 4 + 1);
+        indices[quad * 6 + 2] = (int)(quad * 4 + 2);
+        indices[quad * 6 + 3] = (int)(quad * 4 + 0);
+        indices[quad * 6 + 4] = (int)(quad * 4 + 2);
+        indices[quad * 6 + 5] = (int)(quad * 4 + 3);
+    }
+    Game_Memory_Add(GAME_MEMORY_RENDER, (Sint64)((quads - this->quad_capacity) * GAME_RENDER_QUAD_BYTES));
+    this->quad_capacity = quads;
+    return (true);
+}
+
+/* A run of one is a plain texture copy; longer runs become one geometry call. */
+static bool Game_Render_List_Draw(Game_Render_List *this, SDL_Renderer *renderer, size_t begin, size_t end) {
+    const Game_Render_Command   *command;
+    SDL_Vertex  *vertex;
+    SDL_FColor  white;
+    float   width;
+    float   height;
+
+    command = this->sorted[begin].command;
+    if (end - begin == 1)
+        return (SDL_RenderTexture(renderer, command->texture, &command->source, &command->destination));
+    if (Game_Render_List_Reserve(this, end - begin) == false || SDL_GetTextureSize(command->texture, &width, &height) == false)
+        return (false);
+    white = (SDL_FColor){1.f, 1.f, 1.f, 1.f};
+    for (size_t index = begin; index < end; index++) {
+        command = this->sorted[index].command;
+        vertex = &this->vertices[(index - begin) * 4];
+        vertex[0] = (SDL_Vertex){{command->destination.x, command->destination.y}, white,
+            {command->source.x / width, command->source.y / height}};
+        vertex[1] = (SDL_Vertex){{command->destination.x + command->destination.w, command->destination.y}, white,
+            {(command->source.x + command->source.w) / width, command->source.y / height}};
+        vertex[2] = (SDL_Vertex){{command->destination.x + command->destination.w, command->destination.y + command->destination.h}, white,
+            {(command->source.x + command->source.w) / width, (command->source.y + command->source.h) / height}};
+        vertex[3] = (SDL_Vertex){{command->destination.x, command->destination.y + command->destination.h}, white,
+            {command->source.x / width, (command->source.y + command->source.h) / height}};
+    }
+    return (SDL_RenderGeometry(renderer, command->texture, this->vertices, (int)((end - begin) * 4),
+        this->indices, (int)((end - begin) * 6)));
+}
+
+/*
+** Submits the sorted commands up to and including `last_layer`, so callers
+** can interleave other draws (particles...) between layers. Returns the
+** number of renderer calls issued.
+*/
+size_t  Game_Render_List_Submit(Game_Render_List *this, SDL_Renderer *renderer, Game_Render_Layer last_layer) {
+    size_t  end;
+    size_t  calls;
+    Uint64  limit;
+
+    calls = 0;
+    limit = ((Uint64)last_layer + 1) << GAME_RENDER_LAYER_SHIFT;
+    while (this->cursor < this->length && this->sorted[this->cursor].key < limit) {
+        end = this->cursor + 1;
+        while (end < this->length && this->sorted[end].key < limit
+            && this->sorted[end].command->texture == this->sorted[this->cursor].command->texture)
+            end++;
+        if (Game_Render_List_Draw(this, renderer, this->cursor, end) == false)
+            this->error = true;
+        for (size_t index = this->cursor; index < end; index++) {
+            this->area += (double)this->sorted[index].command->destination.w * this->sorted[index].command->destination.h;
+            this->texels += (double)this->sorted[index].command->source.w * this->sorted[index].command->source.h;
+        }
+        calls++;
+        this->cursor = end;
+    }
+    this->draw_calls += calls;
+    return (calls);
+}
+
+void    Game_Render_List_Destroy(Game_Render_List *this) {
+    size_t  bytes;
+
+    bytes = this->capacity * sizeof(Game_Render_Entry) + this->quad_capacity * GAME_RENDER_QUAD_BYTES;
+    for (size_t index = 0; index < GAME_JOBS_MAX_WORKERS; index++)
+        bytes += this->buckets[index].capacity * GAME_RENDER_BUCKET_BYTES;
+    Game_Memory_Add(GAME_MEMORY_RENDER, -(Sint64)bytes);
+    for (size_t index = 0; index < GAME_JOBS_MAX_WORKERS; index++) {
+        free(this->buckets[index].commands);
+        free(this->buckets[index].entries);
+        free(this->buckets[index].scratch);
+    }
+    free(this->sorted);
+    free(this->vertices);
+    free(this->indices);
+    Game_Render_List_Init(this);
+}
@@ -0,0 +1,81 @@
+#ifndef GAME_RENDER_LIST_H
+# define GAME_RENDER_LIST_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+# include "game_jobs.h"
+
+/*
+** Sort key, most significant first, in layers whose draws can overlap:
+**   63..56 layer    55..32 depth    31..16 texture id    15..0 sequence
+** and in layers where draw order does not change the picture (additive
+** effects), texture-major so each texture is one run:
+**   63..56 layer    55..40 texture id    39..16 depth    15..0 sequence
+** Depth is the biased bottom edge of the destination, so lower sprites are
+** drawn over higher ones whatever their texture; consecutive draws of one
+** texture still coalesce. The sequence keeps equal keys in a fixed order
+** whatever thread built them.
+*/
+# define GAME_RENDER_LAYER_SHIFT 56
+# define GAME_RENDER_ORDERED_DEPTH_SHIFT 32
+# define GAME_RENDER_ORDERED_TEXTURE_SHIFT 16
+# define GAME_RENDER_TEXTURE_SHIFT 40
+# define GAME_RENDER_DEPTH_SHIFT 16
+# define GAME_RENDER_DEPTH_BIAS 0x800000
+# define GAME_RENDER_DEPTH_MAX 0xFFFFFF
+
+typedef enum Game_Render_Layer {
+    GAME_LAYER_FLOOR,
+    GAME_LAYER_SPRITES,
+    /* Additive: the only layer sorted by texture first. */
+    GAME_LAYER_EFFECTS,
+    GAME_LAYER_PLAYER,
+    GAME_LAYER_OVERLAY,
+}   Game_Render_Layer;
+
+typedef struct Game_Render_Command {
+    Uint64  key;
+    SDL_Texture *texture;
+    SDL_FRect   source;
+    SDL_FRect   destination;
+}   Game_Render_Command;
+
+typedef struct Game_Render_Entry {
+    Uint64  key;
+    const Game_Render_Command   *command;
+}   Game_Render_Entry;
+
+/* Filled by one worker only, then sorted on its own before the merge. */
+typedef struct Game_Render_Bucket {
+    Game_Render_Command *commands;
+    Game_Render_Entry   *entries;
+    Game_Render_Entry   *scratch;
+    size_t  length;
+    size_t  capacity;
+}   Game_Render_Bucket;
+
+typedef struct Game_Render_List {
+    Game_Render_Bucket  buckets[GAME_JOBS_MAX_WORKERS];
+    size_t  bucket_count;
+    Game_Render_Entry   *sorted;
+    size_t  length;
+    size_t  capacity;
+    size_t  cursor;
+    SDL_Vertex  *vertices;
+    int     *indices;
+    size_t  quad_capacity;
+    size_t  draw_calls;
+    double  area;
+    double  texels;
+    bool    error;
+}   Game_Render_List;
+
+Uint64  Game_Render_Key(Game_Render_Layer layer, Uint16 texture, float depth, size_t sequence);
+void    Game_Render_List_Init(Game_Render_List *this);
+void    Game_Render_List_Begin(Game_Render_List *this, size_t bucket_count);
+void    Game_Render_List_Push(Game_Render_List *this, size_t bucket, Uint64 key, SDL_Texture *texture, const SDL_FRect *source, const SDL_FRect *destination);
+void    Game_Render_List_Sort(Game_Render_List *this, Game_Jobs *jobs);
+size_t  Game_Render_List_Submit(Game_Render_List *this, SDL_Renderer *renderer, Game_Render_Layer last_layer);
+void    Game_Render_List_Destroy(Game_Render_List *this);
+
+#endif
@@ -0,0 +1,421 @@
+#include "game_script.h"
+
+#define GAME_SCRIPT_MAX_LINE 256
+#define GAME_SCRIPT_MAX_TOKENS 8
+
+#define GAME_SCRIPT_OPCODE_MNEMONIC(name, mnemonic, operands) mnemonic,
+#define GAME_SCRIPT_OPCODE_OPERANDS(name, mnemonic, operands) operands,
+
+static const char   *game_script_mnemonics[GAME_SCRIPT_OPCODE_COUNT] = {
+    GAME_SCRIPT_OPCODE_LIST(GAME_SCRIPT_OPCODE_MNEMONIC)
+};
+
+static const char   *game_script_operands[GAME_SCRIPT_OPCODE_COUNT] = {
+    GAME_SCRIPT_OPCODE_LIST(GAME_SCRIPT_OPCODE_OPERANDS)
+};
+
+static const char   *game_script_fields[GAME_SCRIPT_FIELD_COUNT] = {"x", "y", "vx", "vy", "speed"};
+
+static const char   *game_script_inputs[GAME_SCRIPT_INPUT_COUNT] = {"up", "down", "left", "right"};
+
+typedef struct Game_Script_Label {
+    char    name[GAME_SCRIPT_MAX_NAME];
+    size_t  index;
+}   Game_Script_Label;
+
+/*
+** Two passes over the source: the first only places the labels, so jumps
+** can go forwards; the second encodes. `line` is the one being read, for
+** the error messages.
+*/
+typedef struct Game_Script_Assembler {
+    Game_Script *script;
+    Game_Script_Label   labels[GAME_SCRIPT_MAX_LABELS];
+    size_t  label_count;
+    bool    encode;
+    int     line;
+}   Game_Script_Assembler;
+
+void    Game_Script_Init(Game_Script *this) {
+    SDL_zerop(this);
+}
+
+/* Splits `line` in place on blanks and commas, up to a `#` or `;` comment. */
+static size_t   Game_Script_Tokenize(char *line, char **tokens) {
+    size_t  count;
+
+    count = 0;
+    while (*line != '\0' && *line != '#' && *line != ';') {
+        if (SDL_strchr(" \t\r,", *line) != NULL) {
+            *line++ = '\0';
+            continue ;
+        }
+        if (count == GAME_SCRIPT_MAX_TOKENS)
+            return (count + 1);
+        tokens[count++] = line;
+        while (*line != '\0' && *line != '#' && *line != ';' && SDL_strchr(" \t\r,", *line) == NULL)
+            line++;
+    }
+    *line = '\0';
+    return (count);
+}
+
+static bool Game_Script_AddLabel(Game_Script_Assembler *this, char *name) {
+    name[SDL_strlen(name) - 1] = '\0';
+    if (*name == '\0' || SDL_strlen(name) >= GAME_SCRIPT_MAX_NAME) {
+        SDL_SetError("script line %d: bad label name '%s'", this->line, name);
+        return (false);
+    }
+    if (this->encode)
+        return (true);
+    for (size_t index = 0; index < this->label_count; index++)
+        if (SDL_strcmp(this->labels[index].name, name) == 0) {
+            SDL_SetError("script line %d: label '%s' defined twice", this->line, name);
+            return (false);
+        }
+    if (this->label_count == GAME_SCRIPT_MAX_LABELS) {
+        SDL_SetError("script line %d: more than %d labels", this->line, GAME_SCRIPT_MAX_LABELS);
+        return (false);
+    }
+    SDL_strlcpy(this->labels[this->label_count].name, name, GAME_SCRIPT_MAX_NAME);
+    this->labels[this->label_count++].index = this->script->length;
+    return (true);
+}
+
+static bool Game_Script_AddConstant(Game_Script_Assembler *this, const char *token, Uint32 *operand) {
+    Game_Script *script;
+    char    *end;
+    float   value;
+
+    script = this->script;
+    value = (float)SDL_strtod(token, &end);
+    if (end == token || *end != '\0') {
+        SDL_SetError("script line %d: '%s' is not a number", this->line, token);
+        return (false);
+    }
+    for (size_t index = 0; index < script->constant_count; index++)
+        if (SDL_memcmp(&script->constants[index], &value, sizeof(float)) == 0) {
+            *operand = (Uint32)index;
+            return (true);
+        }
+    if (script->constant_count == GAME_SCRIPT_MAX_CONSTANTS) {
+        SDL_SetError("script line %d: more than %d constants", this->line, GAME_SCRIPT_MAX_CONSTANTS);
+        return (false);
+    }
+    script->constants[script->constant_count] = value;
+    *operand = (Uint32)script->constant_count++;
+    return (true);
+}
+
+/* The index of `token` in `names`. */
+static bool Game_Script_FindName(const char *token, const char **names, size_t count, Uint32 *operand) {
+    for (size_t index = 0; index < count; index++)
+        if (SDL_strcmp(token, names[index]) == 0) {
+            *operand = (Uint32)index;
+            return (true);
+        }
+    return (false);
+}
+
+static bool Game_Script_EncodeOperand(Game_Script_Assembler *this, char kind, const char *token, Uint32 *operand) {
+    char    *end;
+    unsigned long   value;
+
+    switch (kind) {
+        case 'r':
+            value = token[0] == 'r' ? SDL_strtoul(token + 1, &end, 10) : GAME_SCRIPT_REGISTERS;
+            if (token[0] == 'r' && end != token + 1 && *end == '\0' && value < GAME_SCRIPT_REGISTERS) {
+                *operand = (Uint32)value;
+                return (true);
+            }
+            SDL_SetError("script line %d: '%s' is not a register (r0 to r%d)", this->line, token, GAME_SCRIPT_REGISTERS - 1);
+            return (false);
+        case 'k':
+            return (Game_Script_AddConstant(this, token, operand));
+        case 'f':
+            if (Game_Script_FindName(token, game_script_fields, GAME_SCRIPT_FIELD_COUNT, operand)) {
+                this->script->fields |= GAME_SCRIPT_FIELD_BIT(*operand);
+                return (true);
+            }
+            SDL_SetError("script line %d: unknown field '%s'", this->line, token);
+            return (false);
+        case 'i':
+            /* A name, or a number: a mask of input bits. */
+            if (Game_Script_FindName(token, game_script_inputs, GAME_SCRIPT_INPUT_COUNT, operand)) {
+                *operand = 1u << *operand;
+                return (true);
+            }
+            value = SDL_strtoul(token, &end, 0);
+            if (end != token && *end == '\0' && value != 0 && value <= 0xFF) {
+                *operand = (Uint32)value;
+                return (true);
+            }
+            SDL_SetError("script line %d: unknown input '%s'", this->line, token);
+            return (false);
+        default:
+            for (size_t index = 0; index < this->label_count; index++)
+                if (SDL_strcmp(this->labels[index].name, token) == 0) {
+                    *operand = (Uint32)this->labels[index].index;
+                    return (true);
+                }
+            SDL_SetError("script line %d: unknown label '%s'", this->line, token);
+            return (false);
+    }
+}
+
+static bool Game_Script_AssembleLine(Game_Script_Assembler *this, char *line) {
+    char    *tokens[GAME_SCRIPT_MAX_TOKENS];
+    const char  *operands;
+    size_t  count;
+    size_t  first;
+    Uint32  opcode;
+    Uint32  instruction;
+    Uint32  operand;
+
+    if ((count = Game_Script_Tokenize(line, tokens)) > GAME_SCRIPT_MAX_TOKENS) {
+        SDL_SetError("script line %d: too many operands", this->line);
+        return (false);
+    }
+    first = 0;
+    if (count != 0 && tokens[0][SDL_strlen(tokens[0]) - 1] == ':') {
+        if (Game_Script_AddLabel(this, tokens[0]) == false)
+            return (false);
+        first = 1;
+    }
+    if (first == count)
+        return (true);
+    if (Game_Script_FindName(tokens[first], game_script_mnemonics, GAME_SCRIPT_OPCODE_COUNT, &opcode) == false) {
+        SDL_SetError("script line %d: unknown instruction '%s'", this->line, tokens[first]);
+        return (false);
+    }
+    operands = game_script_operands[opcode];
+    if (SDL_strlen(operands) != count - first - 1) {
+        SDL_SetError("script line %d: %s takes %d operands", this->line, tokens[first], (int)SDL_strlen(operands));
+        return (false);
+    }
+    /* One slot is kept for the closing halt. */
+    if (this->script->length == GAME_SCRIPT_MAX_CODE - 1) {
+        SDL_SetError("script line %d: more than %d instructions", this->line, GAME_SCRIPT_MAX_CODE - 1);
+        return (false);
+    }
+    instruction = opcode;
+    for (size_t index = 0; this->encode && operands[index] != '\0'; index++) {
+        if (Game_Script_EncodeOperand(this, operands[index], tokens[first + 1 + index], &operand) == false)
+            return (false);
+        instruction |= operand << (8 * (index + 1));
+    }
+    this->script->code[this->script->length++] = instruction;
+    return (true);
+}
+
+/*
+** One instruction per line, operands separated by blanks or commas, an
+** optional `label:` in front and `#` or `;` comments:
+**
+**     ld r0, x
+**     jnin up, skip
+**     ldk r1, 0.5
+**     sub r0, r0, r1
+** skip:
+**     st x, r0
+**
+** A halt is appended, so running off the end stops. On error the script is
+** left empty and SDL_GetError() names the line.
+*/
+bool    Game_Script_Assemble(Game_Script *this, const char *source) {
+    Game_Script_Assembler   assembler;
+    char    line[GAME_SCRIPT_MAX_LINE];
+    const char  *cursor;
+    const char  *end;
+    size_t  length;
+
+    SDL_zero(assembler);
+    assembler.script = this;
+    for (int pass = 0; pass < 2; pass++) {
+        Game_Script_Init(this);
+        assembler.encode = pass == 1;
+        assembler.line = 0;
+        for (cursor = source; *cursor != '\0'; cursor += length + (cursor[length] == '\n')) {
+            assembler.line++;
+            end = SDL_strchr(cursor, '\n');
+            length = end != NULL ? (size_t)(end - cursor) : SDL_strlen(cursor);
+            if (length >= sizeof(line)) {
+                SDL_SetError("script line %d: longer than %d characters", assembler.line, GAME_SCRIPT_MAX_LINE - 1);
+                Game_Script_Init(this);
+                return (false);
+            }
+            SDL_memcpy(line, cursor, length);
+            line[length] = '\0';
+            if (Game_Script_AssembleLine(&assembler, line) == false) {
+                Game_Script_Init(this);
+                return (false);
+            }
+        }
+    }
+    this->code[this->length++] = GAME_SCRIPT_OP_HALT;
+    return (true);
+}
+
+bool    Game_Script_Load(Game_Script *this, const char *path) {
+    char    *source;
+    bool    assembled;
+
+    Game_Script_Init(this);
+    if ((source = SDL_LoadFile(path, NULL)) == NULL)
+        return (false);
+    assembled = Game_Script_Assemble(this, source);
+    SDL_free(source);
+    return (assembled);
+}
+
+#define GAME_SCRIPT_A ((instruction >> 8) & 0xFF)
+#define GAME_SCRIPT_B ((instruction >> 16) & 0xFF)
+#define GAME_SCRIPT_C (instruction >> 24)
+/* Operands are not checked at run time: only the assembler writes code, and it range-checks every one. */
+#define GAME_SCRIPT_REGISTER(operand) registers[operand]
+#define GAME_SCRIPT_FIELD(operand) (*(float *)(entity + offsets[operand]))
+
+/*
+** With computed goto every handler ends in its own indirect jump to the
+** next one, which the branch predictor learns per handler instead of
+** through the single jump a switch funnels everything into.
+*/
+#ifdef GAME_SCRIPT_COMPUTED_GOTO
+# define GAME_SCRIPT_LABEL(name, mnemonic, operands) &&op_##name,
+# define GAME_SCRIPT_CASE(name) op_##name:
+# define GAME_SCRIPT_NEXT() \
+    do { \
+        instruction = *pc++; \
+        executed++; \
+        goto *labels[instruction & 0xFF]; \
+    } while (0)
+#else
+# define GAME_SCRIPT_CASE(name) case GAME_SCRIPT_OP_##name:
+# define GAME_SCRIPT_NEXT() continue
+#endif
+
+/* A block rather than do-while, whose own loop would swallow the switch version's `continue`. */
+#define GAME_SCRIPT_JUMP(target) \
+    { \
+        if (--jumps == 0) \
+            goto aborted; \
+        pc = this->code + (target); \
+        GAME_SCRIPT_NEXT(); \
+    }
+
+/*
+** Runs the script once for each of `count` entities laid out as `binding`
+** describes, registers starting at zero each time. Nothing is allocated:
+** the registers live on the stack and the field offsets are copied there
+** once per batch. Returns the number of instructions executed; 0 with an
+** error set when the binding lacks a field the script uses.
+*/
+size_t  Game_Script_Run(Game_Script *this, const Game_Script_Binding *binding, void *entities, size_t count, Uint32 input) {
+#ifdef GAME_SCRIPT_COMPUTED_GOTO
+    static void *const  labels[GAME_SCRIPT_OPCODE_COUNT] = {
+        GAME_SCRIPT_OPCODE_LIST(GAME_SCRIPT_LABEL)
+    };
+#endif
+    float   registers[GAME_SCRIPT_REGISTERS];
+    size_t  offsets[GAME_SCRIPT_FIELD_COUNT];
+    const Uint32    *pc;
+    Uint32  instruction;
+    Uint8   *entity;
+    size_t  executed;
+    size_t  jumps;
+
+    if (this->length == 0 || (this->fields & ~binding->fields) != 0) {
+        if (this->length != 0)
+            SDL_SetError("the script uses a field these entities lack");
+        return (0);
+    }
+    SDL_memcpy(offsets, binding->offsets, sizeof(offsets));
+    executed = 0;
+    for (size_t index = 0; index < count; index++) {
+        entity = (Uint8 *)entities + index * binding->stride;
+        SDL_zeroa(registers);
+        pc = this->code;
+        jumps = GAME_SCRIPT_JUMP_BUDGET + 1;
+#ifdef GAME_SCRIPT_COMPUTED_GOTO
+        GAME_SCRIPT_NEXT();
+#else
+        for (;;) {
+            instruction = *pc++;
+            executed++;
+            switch ((Game_Script_Opcode)(instruction & 0xFF)) {
+#endif
+            GAME_SCRIPT_CASE(HALT)
+                goto halted;
+            GAME_SCRIPT_CASE(LDK)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = this->constants[GAME_SCRIPT_B];
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(MOV)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = GAME_SCRIPT_REGISTER(GAME_SCRIPT_B);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(LD)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = GAME_SCRIPT_FIELD(GAME_SCRIPT_B);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(ST)
+                GAME_SCRIPT_FIELD(GAME_SCRIPT_A) = GAME_SCRIPT_REGISTER(GAME_SCRIPT_B);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(ADD)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = GAME_SCRIPT_REGISTER(GAME_SCRIPT_B) + GAME_SCRIPT_REGISTER(GAME_SCRIPT_C);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(SUB)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = GAME_SCRIPT_REGISTER(GAME_SCRIPT_B) - GAME_SCRIPT_REGISTER(GAME_SCRIPT_C);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(MUL)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = GAME_SCRIPT_REGISTER(GAME_SCRIPT_B) * GAME_SCRIPT_REGISTER(GAME_SCRIPT_C);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(DIV)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = GAME_SCRIPT_REGISTER(GAME_SCRIPT_B) / GAME_SCRIPT_REGISTER(GAME_SCRIPT_C);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(MADD)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) += GAME_SCRIPT_REGISTER(GAME_SCRIPT_B) * GAME_SCRIPT_REGISTER(GAME_SCRIPT_C);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(MIN)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = SDL_min(GAME_SCRIPT_REGISTER(GAME_SCRIPT_B), GAME_SCRIPT_REGISTER(GAME_SCRIPT_C));
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(MAX)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = SDL_max(GAME_SCRIPT_REGISTER(GAME_SCRIPT_B), GAME_SCRIPT_REGISTER(GAME_SCRIPT_C));
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(NEG)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = -GAME_SCRIPT_REGISTER(GAME_SCRIPT_B);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(ABS)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = SDL_fabsf(GAME_SCRIPT_REGISTER(GAME_SCRIPT_B));
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(SQRT)
+                GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) = SDL_sqrtf(GAME_SCRIPT_REGISTER(GAME_SCRIPT_B));
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(JMP)
+                GAME_SCRIPT_JUMP(GAME_SCRIPT_A);
+            GAME_SCRIPT_CASE(JLT)
+                if (GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) < GAME_SCRIPT_REGISTER(GAME_SCRIPT_B))
+                    GAME_SCRIPT_JUMP(GAME_SCRIPT_C);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(JGE)
+                if (GAME_SCRIPT_REGISTER(GAME_SCRIPT_A) >= GAME_SCRIPT_REGISTER(GAME_SCRIPT_B))
+                    GAME_SCRIPT_JUMP(GAME_SCRIPT_C);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(JIN)
+                if (input & GAME_SCRIPT_A)
+                    GAME_SCRIPT_JUMP(GAME_SCRIPT_B);
+                GAME_SCRIPT_NEXT();
+            GAME_SCRIPT_CASE(JNIN)
+                if ((input & GAME_SCRIPT_A) == 0)
+                    GAME_SCRIPT_JUMP(GAME_SCRIPT_B);
+                GAME_SCRIPT_NEXT();
+#ifndef GAME_SCRIPT_COMPUTED_GOTO
+                default:
+                    goto halted;
+            }
+        }
+#endif
+aborted:
+        this->aborted++;
+halted:
+        ;
+    }
+    return (executed);
+}
@@ -0,0 +1,97 @@
+#ifndef GAME_SCRIPT_H
+# define GAME_SCRIPT_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_SCRIPT_REGISTERS 16
+# define GAME_SCRIPT_MAX_CODE 256
+# define GAME_SCRIPT_MAX_CONSTANTS 256
+# define GAME_SCRIPT_MAX_LABELS 64
+# define GAME_SCRIPT_MAX_NAME 32
+/* up, down, left and right: bits 0 to 3 of the input, as the game's GAME_INPUT_ flags. */
+# define GAME_SCRIPT_INPUT_COUNT 4
+/* Taken jumps one entity may make before its run is cut short, so a loop in a script cannot hang the frame. */
+# define GAME_SCRIPT_JUMP_BUDGET 1024
+
+# if defined(__GNUC__) || defined(__clang__)
+#  define GAME_SCRIPT_COMPUTED_GOTO
+# endif
+
+/*
+** X(NAME, mnemonic, operands): every instruction. Operands are read from
+** left to right into bytes 1 to 3 of the 32-bit instruction, byte 0 being
+** the opcode: r a register, k a float constant (its index in the constant
+** pool), f an entity field, l a label (an instruction index), i input
+** buttons (up, down, left, right or a mask). Conditional jumps jump when
+** the condition holds.
+*/
+# define GAME_SCRIPT_OPCODE_LIST(X) \
+    X(HALT, "halt", "") \
+    X(LDK, "ldk", "rk") \
+    X(MOV, "mov", "rr") \
+    X(LD, "ld", "rf") \
+    X(ST, "st", "fr") \
+    X(ADD, "add", "rrr") \
+    X(SUB, "sub", "rrr") \
+    X(MUL, "mul", "rrr") \
+    X(DIV, "div", "rrr") \
+    X(MADD, "madd", "rrr") \
+    X(MIN, "min", "rrr") \
+    X(MAX, "max", "rrr") \
+    X(NEG, "neg", "rr") \
+    X(ABS, "abs", "rr") \
+    X(SQRT, "sqrt", "rr") \
+    X(JMP, "jmp", "l") \
+    X(JLT, "jlt", "rrl") \
+    X(JGE, "jge", "rrl") \
+    X(JIN, "jin", "il") \
+    X(JNIN, "jnin", "il")
+
+# define GAME_SCRIPT_OPCODE_ENUM(name, mnemonic, operands) GAME_SCRIPT_OP_##name,
+
+typedef enum Game_Script_Opcode {
+    GAME_SCRIPT_OPCODE_LIST(GAME_SCRIPT_OPCODE_ENUM)
+    GAME_SCRIPT_OPCODE_COUNT
+}   Game_Script_Opcode;
+
+/* What `ld` and `st` reach, named in scripts as x, y, vx, vy and speed. */
+typedef enum Game_Script_Field {
+    GAME_SCRIPT_X,
+    GAME_SCRIPT_Y,
+    GAME_SCRIPT_VX,
+    GAME_SCRIPT_VY,
+    GAME_SCRIPT_SPEED,
+    GAME_SCRIPT_FIELD_COUNT,
+}   Game_Script_Field;
+
+# define GAME_SCRIPT_FIELD_BIT(field) (1u << (field))
+
+/* Where the float fields sit in one entity of an array; `fields` has a bit for each one the type has. */
+typedef struct Game_Script_Binding {
+    size_t  stride;
+    Uint32  fields;
+    size_t  offsets[GAME_SCRIPT_FIELD_COUNT];
+}   Game_Script_Binding;
+
+/*
+** An assembled behaviour. Everything lives inline, so assembling allocates
+** nothing past the source text and running allocates nothing at all.
+** `fields` has a bit for each field the code touches, checked once per
+** batch against the binding. An empty script (length 0) is not loaded.
+*/
+typedef struct Game_Script {
+    Uint32  code[GAME_SCRIPT_MAX_CODE];
+    float   constants[GAME_SCRIPT_MAX_CONSTANTS];
+    size_t  length;
+    size_t  constant_count;
+    Uint32  fields;
+    size_t  aborted;
+}   Game_Script;
+
+void    Game_Script_Init(Game_Script *this);
+bool    Game_Script_Assemble(Game_Script *this, const char *source);
+bool    Game_Script_Load(Game_Script *this, const char *path);
+size_t  Game_Script_Run(Game_Script *this, const Game_Script_Binding *binding, void *entities, size_t count, Uint32 input);
+
+#endif
@@ -0,0 +1,226 @@
+#include "game.h"
+
+#define GAME_SNAPSHOT_PARTICLE_BYTES (sizeof(float) * 6 + sizeof(Uint32))
+
+void    Game_Snapshot_Init(Game_Snapshot *this) {
+    this->data = NULL;
+    this->length = 0;
+    this->capacity = 0;
+}
+
+bool    Game_Snapshot_Reserve(Game_Snapshot *this, size_t capacity) {
+    Uint8   *data;
+
+    if (capacity <= this->capacity)
+        return (true);
+    if ((data = realloc(this->data, capacity)) == NULL)
+        return (false);
+    this->data = data;
+    Game_Memory_Add(GAME_MEMORY_SNAPSHOTS, (Sint64)(capacity - this->capacity));
+    this->capacity = capacity;
+    return (true);
+}
+
+/* Exact size Capture will write for the game as it is now. */
+size_t  Game_Snapshot_Measure(const Game *game) {
+    return (sizeof(Game_Snapshot_Header) + sizeof(float) * 5 + sizeof(float) * 3
+        + sizeof(Uint32) + sizeof(Game_Snapshot_Sprite) * game->sprites.length
+        + sizeof(Uint32) * 2 + GAME_SNAPSHOT_PARTICLE_BYTES * game->particles.length);
+}
+
+/* Word at a time FNV-1a variant: cheap enough to check every restore. */
+Uint64  Game_Snapshot_Hash(const void *data, size_t bytes) {
+    const Uint8 *cursor;
+    Uint64  hash;
+    Uint64  word;
+
+    cursor = data;
+    hash = 0xCBF29CE484222325ull;
+    for (; bytes >= sizeof(Uint64); bytes -= sizeof(Uint64), cursor += sizeof(Uint64)) {
+        SDL_memcpy(&word, cursor, sizeof(Uint64));
+        hash = (hash ^ word) * 0x100000001B3ull;
+        hash ^= hash >> 29;
+    }
+    while (bytes-- > 0)
+        hash = (hash ^ *cursor++) * 0x100000001B3ull;
+    return (hash ^ (hash >> 32));
+}
+
+static void Game_Snapshot_Put(Uint8 **cursor, const void *data, size_t bytes) {
+    SDL_memcpy(*cursor, data, bytes);
+    *cursor += bytes;
+}
+
+static void Game_Snapshot_Get(const Uint8 **cursor, void *data, size_t bytes) {
+    SDL_memcpy(data, *cursor, bytes);
+    *cursor += bytes;
+}
+
+/*
+** One pass straight into the buffer. The buffer only grows when the scene
+** did, so steady-state captures (quick-save, rollback) allocate nothing.
+*/
+bool    Game_Snapshot_Capture(Game_Snapshot *this, const Game *game) {
+    Game_Snapshot_Header    header;
+    Game_Snapshot_Sprite    record;
+    const Game_Sprite   *sprite;
+    const Game_Particle_Pool    *particles;
+    Uint8   *cursor;
+    Uint32  count;
+    float   values[5];
+
+    if (Game_Snapshot_Reserve(this, Game_Snapshot_Measure(game)) == false)
+        return (false);
+    cursor = this->data + sizeof(Game_Snapshot_Header);
+    values[0] = game->player.coordinates.x;
+    values[1] = game->player.coordinates.y;
+    values[2] = game->player.speed;
+    values[3] = game->player_previous.x;
+    values[4] = game->player_previous.y;
+    Game_Snapshot_Put(&cursor, values, sizeof(float) * 5);
+    values[0] = game->camera.x;
+    values[1] = game->camera.y;
+    values[2] = game->camera.zoom;
+    Game_Snapshot_Put(&cursor, values, sizeof(float) * 3);
+    count = (Uint32)game->sprites.length;
+    Game_Snapshot_Put(&cursor, &count, sizeof(Uint32));
+    for (size_t index = 0; index < game->sprites.length; index++) {
+        sprite = &game->sprites.content[index];
+        record = (Game_Snapshot_Sprite){sprite->coordinates.x, sprite->coordinates.y, sprite->velocity.x, sprite->velocity.y,
+            game->sprites.sources[index], (Uint16)sprite->texture->code, game->sprites.animations[index].clip,
+            game->sprites.animations[index].time_us};
+        Game_Snapshot_Put(&cursor, &record, sizeof(record));
+    }
+    particles = &game->particles;
+    count = (Uint32)particles->length;
+    Game_Snapshot_Put(&cursor, &count, sizeof(Uint32));
+    Game_Snapshot_Put(&cursor, &particles->random, sizeof(Uint32));
+    Game_Snapshot_Put(&cursor, particles->x, sizeof(float) * count);
+    Game_Snapshot_Put(&cursor, particles->y, sizeof(float) * count);
+    Game_Snapshot_Put(&cursor, particles->velocity_x, sizeof(float) * count);
+    Game_Snapshot_Put(&cursor, particles->velocity_y, sizeof(float) * count);
+    Game_Snapshot_Put(&cursor, particles->life, sizeof(float) * count);
+    Game_Snapshot_Put(&cursor, particles->life_scale, sizeof(float) * count);
+    Game_Snapshot_Put(&cursor, particles->color, sizeof(Uint32) * count);
+    this->length = (size_t)(cursor - this->data);
+    header = (Game_Snapshot_Header){GAME_SNAPSHOT_MAGIC, GAME_SNAPSHOT_VERSION, GAME_SNAPSHOT_BYTE_ORDER,
+        (Uint32)this->length, 0, Game_Snapshot_Hash(this->data + sizeof(header), this->length - sizeof(header)),
+        (Uint64)game->frame};
+    SDL_memcpy(this->data, &header, sizeof(header));
+    return (true);
+}
+
+/* A loaded texture of that asset: the scene's own first, then the player's and the floor's. */
+static Game_Texture *Game_Snapshot_FindTexture(Game *game, Uint16 code) {
+    Game_Texture    *texture;
+
+    if (code >= SPRITE_NUMBER)
+        return (NULL);
+    for (size_t index = 0; index < game->textures.capacity; index++)
+        if (game->textures.content[index].code == code && Game_Texture_IsLoaded(&game->textures.content[index]))
+            return (&game->textures.content[index]);
+    texture = code == PLAYER ? &game->player.texture : code == FLOOR ? &game->floor.texture : NULL;
+    return (texture != NULL && Game_Texture_IsLoaded(texture) ? texture : NULL);
+}
+
+/*
+** Everything that can reject the snapshot is checked before the game is
+** touched, starting with the fixed player, camera and count fields every
+** snapshot has after its header.
+*/
+static bool Game_Snapshot_Validate(const Game_Snapshot *this, Game *game, Game_Snapshot_Header *header) {
+    const Uint8 *cursor;
+    Game_Snapshot_Sprite    record;
+    Uint32  sprites;
+    Uint32  particles;
+
+    if (this->length < sizeof(Game_Snapshot_Header) + sizeof(float) * 8 + sizeof(Uint32))
+        return (false);
+    SDL_memcpy(header, this->data, sizeof(Game_Snapshot_Header));
+    if (header->magic != GAME_SNAPSHOT_MAGIC || header->version != GAME_SNAPSHOT_VERSION
+        || header->byte_order != GAME_SNAPSHOT_BYTE_ORDER || header->size != this->length
+        || header->hash != Game_Snapshot_Hash(this->data + sizeof(Game_Snapshot_Header), this->length - sizeof(Game_Snapshot_Header)))
+        return (false);
+    cursor = this->data + sizeof(Game_Snapshot_Header) + sizeof(float) * 8;
+    Game_Snapshot_Get(&cursor, &sprites, sizeof(Uint32));
+    if ((size_t)(cursor - this->data) + sizeof(Game_Snapshot_Sprite) * (size_t)sprites + sizeof(Uint32) * 2 > this->length)
+        return (false);
+    for (Uint32 index = 0; index < sprites; index++) {
+        Game_Snapshot_Get(&cursor, &record, sizeof(record));
+        if (Game_Snapshot_FindTexture(game, record.texture) == NULL
+            || (record.clip != GAME_ANIMATION_NONE && record.clip >= game->animations.clip_count))
+            return (false);
+    }
+    Game_Snapshot_Get(&cursor, &particles, sizeof(Uint32));
+    return (particles <= game->particles.capacity
+        && (size_t)(cursor - this->data) + sizeof(Uint32) + GAME_SNAPSHOT_PARTICLE_BYTES * (size_t)particles == this->length);
+}
+
+bool    Game_Snapshot_Restore(const Game_Snapshot *this, Game *game) {
+    Game_Snapshot_Header    header;
+    Game_Snapshot_Sprite    record;
+    Game_Particle_Pool  *particles;
+    const Uint8 *cursor;
+    Uint32  count;
+    float   values[5];
+
+    if (Game_Snapshot_Validate(this, game, &header) == false)
+        return (false);
+    cursor = this->data + sizeof(Game_Snapshot_Header);
+    Game_Snapshot_Get(&cursor, values, sizeof(float) * 5);
+    game->player.coordinates = (Coordinates){values[0], values[1]};
+    game->player.speed = values[2];
+    game->player_previous = (Coordinates){values[3], values[4]};
+    Game_Snapshot_Get(&cursor, values, sizeof(float) * 3);
+    Game_Camera_LookAt(&game->camera, values[0], values[1]);
+    Game_Camera_SetZoom(&game->camera, values[2]);
+    Game_Snapshot_Get(&cursor, &count, sizeof(Uint32));
+    if (Game_Sprite_Array_Reserve(&game->sprites, count) == false)
+        return (false);
+    for (Uint32 index = 0; index < count; index++) {
+        Game_Snapshot_Get(&cursor, &record, sizeof(record));
+        game->sprites.content[index] = (Game_Sprite){Game_Snapshot_FindTexture(game, record.texture),
+            {record.x, record.y}, {record.velocity_x, record.velocity_y}};
+        game->sprites.sources[index] = record.source;
+        game->sprites.animations[index] = (Game_Animation_State){record.clip, record.time_us};
+    }
+    game->sprites.length = count;
+    particles = &game->particles;
+    Game_Snapshot_Get(&cursor, &count, sizeof(Uint32));
+    Game_Snapshot_Get(&cursor, &particles->random, sizeof(Uint32));
+    Game_Snapshot_Get(&cursor, particles->x, sizeof(float) * count);
+    Game_Snapshot_Get(&cursor, particles->y, sizeof(float) * count);
+    Game_Snapshot_Get(&cursor, particles->velocity_x, sizeof(float) * count);
+    Game_Snapshot_Get(&cursor, particles->velocity_y, sizeof(float) * count);
+    Game_Snapshot_Get(&cursor, particles->life, sizeof(float) * count);
+    Game_Snapshot_Get(&cursor, particles->life_scale, sizeof(float) * count);
+    Game_Snapshot_Get(&cursor, particles->color, sizeof(Uint32) * count);
+    particles->length = count;
+    return (true);
+}
+
+bool    Game_Snapshot_SaveFile(const Game_Snapshot *this, const char *path) {
+    return (this->length != 0 && SDL_SaveFile(path, this->data, this->length));
+}
+
+bool    Game_Snapshot_LoadFile(Game_Snapshot *this, const char *path) {
+    void    *data;
+    size_t  length;
+
+    if ((data = SDL_LoadFile(path, &length)) == NULL)
+        return (false);
+    if (Game_Snapshot_Reserve(this, length) == false) {
+        SDL_free(data);
+        return (false);
+    }
+    SDL_memcpy(this->data, data, length);
+    this->length = length;
+    SDL_free(data);
+    return (true);
+}
+
+void    Game_Snapshot_Destroy(Game_Snapshot *this) {
+    Game_Memory_Add(GAME_MEMORY_SNAPSHOTS, -(Sint64)this->capacity);
+    free(this->data);
+    Game_Snapshot_Init(this);
+}
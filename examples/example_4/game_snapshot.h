@@ -0,0 +1,64 @@
+#ifndef GAME_SNAPSHOT_H
+# define GAME_SNAPSHOT_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_SNAPSHOT_MAGIC 0x504E5347u
+# define GAME_SNAPSHOT_VERSION 2
+# define GAME_SNAPSHOT_BYTE_ORDER 0x0102
+# define GAME_QUICKSAVE_PATH "quicksave.gsnp"
+
+struct Game;
+
+/*
+** Version 2 layout, native byte order (the header records it and restore
+** refuses a foreign one):
+**   header    magic, version, byte order, total size, payload hash, frame
+**   player    x, y, speed, previous x, previous y
+**   camera    x, y, zoom
+**   sprites   count, then one Game_Snapshot_Sprite per sprite
+**   particles count, generator state, then x, y, velocity x, velocity y,
+**             life, life scale and color arrays, `count` entries each
+** Textures are stored as their asset's Sprite_Code, never as pointers or
+** load-order ids, so a snapshot restores into any run that loaded those
+** assets and is refused by one that did not.
+*/
+typedef struct Game_Snapshot_Header {
+    Uint32  magic;
+    Uint16  version;
+    Uint16  byte_order;
+    Uint32  size;
+    Uint32  reserved;
+    Uint64  hash;
+    Uint64  frame;
+}   Game_Snapshot_Header;
+
+typedef struct Game_Snapshot_Sprite {
+    float   x;
+    float   y;
+    float   velocity_x;
+    float   velocity_y;
+    SDL_FRect   source;
+    Uint16  texture;
+    Uint16  clip;
+    Uint32  time_us;
+}   Game_Snapshot_Sprite;
+
+typedef struct Game_Snapshot {
+    Uint8   *data;
+    size_t  length;
+    size_t  capacity;
+}   Game_Snapshot;
+
+void    Game_Snapshot_Init(Game_Snapshot *this);
+bool    Game_Snapshot_Reserve(Game_Snapshot *this, size_t capacity);
+size_t  Game_Snapshot_Measure(const struct Game *game);
+bool    Game_Snapshot_Capture(Game_Snapshot *this, const struct Game *game);
+bool    Game_Snapshot_Restore(const Game_Snapshot *this, struct Game *game);
+bool    Game_Snapshot_SaveFile(const Game_Snapshot *this, const char *path);
+bool    Game_Snapshot_LoadFile(Game_Snapshot *this, const char *path);
+void    Game_Snapshot_Destroy(Game_Snapshot *this);
+Uint64  Game_Snapshot_Hash(const void *data, size_t bytes);
+
+#endif
@@ -0,0 +1,112 @@
+#include "game.h"
+
+static const char   *game_startup_phase_names[GAME_STARTUP_PHASE_COUNT] = {
+    "video", "window", "first frame", "assets", "ready"
+};
+
+void    Game_Startup_Init(Game_Startup *this) {
+    this->start_ns = SDL_GetTicksNS();
+    for (size_t phase = 0; phase < GAME_STARTUP_PHASE_COUNT; phase++)
+        this->phases_ns[phase] = 0;
+    this->asset_count = 0;
+    SDL_SetAtomicInt(&this->next_asset, 0);
+    this->decoder_count = 0;
+}
+
+/* Only the first mark of a phase counts. */
+void    Game_Startup_Mark(Game_Startup *this, Game_Startup_Phase phase) {
+    if (this->phases_ns[phase] == 0)
+        this->phases_ns[phase] = SDL_max(SDL_GetTicksNS() - this->start_ns, 1);
+}
+
+bool    Game_Startup_Queue(Game_Startup *this, struct Game_Texture *target, const char *path) {
+    if (this->asset_count == GAME_STARTUP_MAX_ASSETS)
+        return (false);
+    this->assets[this->asset_count++] = (Game_Startup_Asset){target, path, NULL};
+    return (true);
+}
+
+/* Image decoding only touches the file and the new surface, so any thread can do it. */
+static int  Game_Startup_Drain(void *data) {
+    Game_Startup    *this;
+    int     index;
+
+    this = data;
+    while ((index = SDL_AddAtomicInt(&this->next_asset, 1)) < (int)this->asset_count) {
+        this->assets[index].surface = Game_Bmp_Load(this->assets[index].path);
+        Game_Memory_Add(GAME_MEMORY_SURFACES, Game_Memory_SurfaceBytes(this->assets[index].surface));
+    }
+    return (0);
+}
+
+/* Starts the decoders and returns at once; whatever they cannot start, Upload decodes itself. */
+void    Game_Startup_Decode(Game_Startup *this) {
+    size_t  decoders;
+
+    decoders = SDL_min(this->asset_count, GAME_STARTUP_DECODERS);
+    while (this->decoder_count < decoders) {
+        this->decoders[this->decoder_count] = SDL_CreateThread(Game_Startup_Drain, "game_decode", this);
+        if (this->decoders[this->decoder_count] == NULL)
+            break ;
+        this->decoder_count++;
+    }
+}
+
+static void Game_Startup_Join(Game_Startup *this) {
+    Game_Startup_Drain(this);
+    for (size_t index = 0; index < this->decoder_count; index++)
+        SDL_WaitThread(this->decoders[index], NULL);
+    this->decoder_count = 0;
+}
+
+/*
+** Render thread only. Helps with what is left to decode, then creates every
+** texture. On failure the textures already created are destroyed again.
+*/
+bool    Game_Startup_Upload(Game_Startup *this, struct Game_Window *window) {
+    Game_Startup_Asset  *asset;
+    size_t  uploaded;
+    bool    complete;
+
+    Game_Startup_Join(this);
+    for (uploaded = 0; uploaded < this->asset_count; uploaded++) {
+        asset = &this->assets[uploaded];
+        asset->target->path = asset->path;
+        if (asset->surface == NULL) {
+            SDL_SetError("cannot decode %s", asset->path);
+            break ;
+        }
+        if (Game_Texture_LoadFromSurface(asset->target, window, asset->surface) == false)
+            break ;
+    }
+    complete = (uploaded == this->asset_count);
+    if (complete == false)
+        for (size_t index = 0; index < uploaded; index++)
+            Game_Texture_Destroy(this->assets[index].target);
+    Game_Startup_Destroy(this);
+    Game_Startup_Mark(this, GAME_STARTUP_ASSETS);
+    return (complete);
+}
+
+void    Game_Startup_Print(const Game_Startup *this, FILE *output) {
+    fprintf(output, "startup ms   ");
+    for (size_t phase = 0; phase < GAME_STARTUP_PHASE_COUNT; phase++)
+        if (this->phases_ns[phase] != 0)
+            fprintf(output, " %s %.1f", game_startup_phase_names[phase], (double)this->phases_ns[phase] / 1e6);
+    fprintf(output, "  (first frame target %.0f%s)\n", (double)GAME_STARTUP_TARGET_NS / 1e6,
+        this->phases_ns[GAME_STARTUP_FIRST_FRAME] > GAME_STARTUP_TARGET_NS ? ", missed" : "");
+}
+
+/* Joins the decoders and frees every surface not uploaded yet. */
+void    Game_Startup_Destroy(Game_Startup *this) {
+    SDL_SetAtomicInt(&this->next_asset, (int)this->asset_count);
+    for (size_t index = 0; index < this->decoder_count; index++)
+        SDL_WaitThread(this->decoders[index], NULL);
+    this->decoder_count = 0;
+    for (size_t index = 0; index < this->asset_count; index++) {
+        Game_Memory_Add(GAME_MEMORY_SURFACES, -(Sint64)Game_Memory_SurfaceBytes(this->assets[index].surface));
+        SDL_DestroySurface(this->assets[index].surface);
+        this->assets[index].surface = NULL;
+    }
+    this->asset_count = 0;
+}
@@ -0,0 +1,54 @@
+#ifndef GAME_STARTUP_H
+# define GAME_STARTUP_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_STARTUP_MAX_ASSETS 8
+# define GAME_STARTUP_DECODERS 4
+# define GAME_STARTUP_TARGET_NS 100000000ull
+
+struct Game_Texture;
+struct Game_Window;
+
+typedef enum Game_Startup_Phase {
+    GAME_STARTUP_VIDEO,
+    GAME_STARTUP_WINDOW,
+    GAME_STARTUP_FIRST_FRAME,
+    GAME_STARTUP_ASSETS,
+    GAME_STARTUP_READY,
+    GAME_STARTUP_PHASE_COUNT,
+}   Game_Startup_Phase;
+
+typedef struct Game_Startup_Asset {
+    struct Game_Texture *target;
+    const char  *path;
+    SDL_Surface *surface;
+}   Game_Startup_Asset;
+
+/*
+** Startup in the order the player sees it: the scene's images are decoded on
+** their own threads while SDL video, the window and the renderer come up, a
+** blank first frame is presented, and only then are the decoded surfaces
+** turned into textures on the render thread. `phases_ns` holds, per phase,
+** the time from Game_Startup_Init to the end of that phase (0 until reached).
+*/
+typedef struct Game_Startup {
+    Uint64  start_ns;
+    Uint64  phases_ns[GAME_STARTUP_PHASE_COUNT];
+    Game_Startup_Asset  assets[GAME_STARTUP_MAX_ASSETS];
+    size_t  asset_count;
+    SDL_AtomicInt   next_asset;
+    SDL_Thread  *decoders[GAME_STARTUP_DECODERS];
+    size_t  decoder_count;
+}   Game_Startup;
+
+void    Game_Startup_Init(Game_Startup *this);
+void    Game_Startup_Mark(Game_Startup *this, Game_Startup_Phase phase);
+bool    Game_Startup_Queue(Game_Startup *this, struct Game_Texture *target, const char *path);
+void    Game_Startup_Decode(Game_Startup *this);
+bool    Game_Startup_Upload(Game_Startup *this, struct Game_Window *window);
+void    Game_Startup_Print(const Game_Startup *this, FILE *output);
+void    Game_Startup_Destroy(Game_Startup *this);
+
+#endif
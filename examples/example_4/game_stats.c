@@ -0,0 +1,134 @@
+#include "game_stats.h"
+#include "game_memory.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+# include <sys/resource.h>
+#endif
+
+bool    Game_Frame_Stats_Init(Game_Frame_Stats *this, size_t capacity) {
+    this->length = 0;
+    this->capacity = capacity;
+    this->draw_calls = 0;
+    this->draw_calls_peak = 0;
+    this->fill_pixels = 0;
+    this->fill_texels = 0;
+    this->latency_ns = 0;
+    this->latency_peak_ns = 0;
+    this->latency_count = 0;
+    if ((this->frame_ns = malloc(sizeof(Uint64) * capacity)) == NULL) {
+        this->capacity = 0;
+        return (false);
+    }
+    Game_Memory_Add(GAME_MEMORY_LOGS, (Sint64)(sizeof(Uint64) * capacity));
+    return (true);
+}
+
+/* `fill_texels` is what the textured draws read from their textures, at the mip level each one picked. */
+void    Game_Frame_Stats_Record(Game_Frame_Stats *this, Uint64 frame_ns, size_t draw_calls, Uint64 fill_pixels, Uint64 fill_texels) {
+    if (this->length >= this->capacity)
+        return ;
+    this->frame_ns[this->length++] = frame_ns;
+    this->draw_calls += draw_calls;
+    this->fill_pixels += fill_pixels;
+    this->fill_texels += fill_texels;
+    if (draw_calls > this->draw_calls_peak)
+        this->draw_calls_peak = draw_calls;
+}
+
+/* Time from sampling a frame's input to presenting the frame built from it. */
+void    Game_Frame_Stats_RecordLatency(Game_Frame_Stats *this, Uint64 latency_ns) {
+    this->latency_ns += latency_ns;
+    this->latency_count++;
+    if (latency_ns > this->latency_peak_ns)
+        this->latency_peak_ns = latency_ns;
+}
+
+static int  Game_Frame_Stats_Compare(const void *left, const void *right) {
+    Uint64  a;
+    Uint64  b;
+
+    a = *(const Uint64 *)left;
+    b = *(const Uint64 *)right;
+    return ((a > b) - (a < b));
+}
+
+/* Nearest-rank percentile over a sorted copy; the recorded order is kept. */
+Uint64  Game_Frame_Stats_Percentile(Game_Frame_Stats *this, double percentile) {
+    Uint64  *sorted;
+    Uint64  value;
+    size_t  rank;
+
+    if (this->length == 0 || (sorted = malloc(sizeof(Uint64) * this->length)) == NULL)
+        return (0);
+    SDL_memcpy(sorted, this->frame_ns, sizeof(Uint64) * this->length);
+    SDL_qsort(sorted, this->length, sizeof(Uint64), Game_Frame_Stats_Compare);
+    rank = (size_t)(percentile / 100.0 * (double)this->length + 0.5);
+    if (rank > 0)
+        rank--;
+    if (rank >= this->length)
+        rank = this->length - 1;
+    value = sorted[rank];
+    free(sorted);
+    return (value);
+}
+
+double  Game_Frame_Stats_AverageNS(Game_Frame_Stats *this) {
+    Uint64  total;
+
+    if (this->length == 0)
+        return (0);
+    total = 0;
+    for (size_t index = 0; index < this->length; index++)
+        total += this->frame_ns[index];
+    return ((double)total / (double)this->length);
+}
+
+void    Game_Frame_Stats_Print(Game_Frame_Stats *this, FILE *output) {
+    double  average;
+
+    if (this->length == 0)
+        return ;
+    average = Game_Frame_Stats_AverageNS(this);
+    fprintf(output, "frames        %zu\n", this->length);
+    fprintf(output, "average fps   %.1f\n", average > 0 ? 1e9 / average : 0.0);
+    fprintf(output, "frame ms      avg %.3f  p50 %.3f  p90 %.3f  p95 %.3f  p99 %.3f  max %.3f\n",
+        average / 1e6,
+        (double)Game_Frame_Stats_Percentile(this, 50) / 1e6,
+        (double)Game_Frame_Stats_Percentile(this, 90) / 1e6,
+        (double)Game_Frame_Stats_Percentile(this, 95) / 1e6,
+        (double)Game_Frame_Stats_Percentile(this, 99) / 1e6,
+        (double)Game_Frame_Stats_Percentile(this, 100) / 1e6);
+    fprintf(output, "draw calls    avg %.1f  peak %zu per frame\n",
+        (double)this->draw_calls / (double)this->length, this->draw_calls_peak);
+    fprintf(output, "fill          %.2f Mpixels per frame, %.2f Mtexels read\n", (double)this->fill_pixels / (double)this->length / 1e6,
+        (double)this->fill_texels / (double)this->length / 1e6);
+    if (this->latency_count != 0)
+        fprintf(output, "latency ms    avg %.3f  max %.3f  (input to present)\n",
+            (double)this->latency_ns / (double)this->latency_count / 1e6, (double)this->latency_peak_ns / 1e6);
+    fprintf(output, "peak memory   %.1f MiB\n", (double)Game_Stats_GetPeakMemory() / (1024.0 * 1024.0));
+}
+
+void    Game_Frame_Stats_Destroy(Game_Frame_Stats *this) {
+    Game_Memory_Add(GAME_MEMORY_LOGS, -(Sint64)(sizeof(Uint64) * this->capacity));
+    free(this->frame_ns);
+    this->frame_ns = NULL;
+    this->length = 0;
+    this->capacity = 0;
+}
+
+/* Peak resident set size of the process, 0 where the platform has no cheap query. */
+size_t  Game_Stats_GetPeakMemory(void) {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage   usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return (0);
+# if defined(__APPLE__)
+    return ((size_t)usage.ru_maxrss);
+# else
+    return ((size_t)usage.ru_maxrss * 1024);
+# endif
+#else
+    return (0);
+#endif
+}
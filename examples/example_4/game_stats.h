@@ -0,0 +1,30 @@
+#ifndef GAME_STATS_H
+# define GAME_STATS_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+typedef struct Game_Frame_Stats {
+    Uint64  *frame_ns;
+    size_t  length;
+    size_t  capacity;
+    size_t  draw_calls;
+    size_t  draw_calls_peak;
+    Uint64  fill_pixels;
+    Uint64  fill_texels;
+    Uint64  latency_ns;
+    Uint64  latency_peak_ns;
+    size_t  latency_count;
+}   Game_Frame_Stats;
+
+bool    Game_Frame_Stats_Init(Game_Frame_Stats *this, size_t capacity);
+void    Game_Frame_Stats_Record(Game_Frame_Stats *this, Uint64 frame_ns, size_t draw_calls, Uint64 fill_pixels, Uint64 fill_texels);
+void    Game_Frame_Stats_RecordLatency(Game_Frame_Stats *this, Uint64 latency_ns);
+Uint64  Game_Frame_Stats_Percentile(Game_Frame_Stats *this, double percentile);
+double  Game_Frame_Stats_AverageNS(Game_Frame_Stats *this);
+void    Game_Frame_Stats_Print(Game_Frame_Stats *this, FILE *output);
+void    Game_Frame_Stats_Destroy(Game_Frame_Stats *this);
+
+size_t  Game_Stats_GetPeakMemory(void);
+
+#endif
@@ -0,0 +1,110 @@
+#include "game_stress.h"
+
+/*
+** Stress scene: `count` sprites alternating between the player and boo
+** textures, bouncing around the window. Start positions and velocities come
+** from a fixed-seed generator so every run replays the same frames.
+*/
+
+static Uint32   Game_Stress_Random(Uint32 *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return (*state >> 8);
+}
+
+/* Game_Init queued these for a stress configuration. */
+bool    Game_Stress_LoadTextures(Game *game) {
+    return (Game_Texure_LoadFromFile(game));
+}
+
+/*
+** The shipped sprites are single images; animated runs cut each of them into
+** a 2x2 sheet so the animation pass has real clips to walk.
+*/
+static bool Game_Stress_AddClips(Game *game, int clips[2]) {
+    Game_Texture    *player;
+    Game_Texture    *boo;
+
+    player = &game->textures.content[PLAYER];
+    boo = &game->textures.content[BOO];
+    clips[0] = Game_Animation_Library_AddGrid(&game->animations, player->size.width / 2.f, player->size.height / 2.f,
+        2, 4, GAME_STRESS_FRAME_US, GAME_ANIMATION_LOOP);
+    clips[1] = Game_Animation_Library_AddGrid(&game->animations, boo->size.width / 2.f, boo->size.height / 2.f,
+        2, 4, GAME_STRESS_FRAME_US, GAME_ANIMATION_PING_PONG);
+    return (clips[0] >= 0 && clips[1] >= 0);
+}
+
+bool    Game_Stress_Spawn(Game *game, size_t count, bool animated) {
+    Game_Sprite sprite;
+    Uint32  state;
+    float   speed;
+    int     clips[2];
+
+    clips[0] = -1;
+    clips[1] = -1;
+    if (Game_Sprite_Array_Reserve(&game->sprites, game->sprites.length + count) == false
+        || (animated && Game_Stress_AddClips(game, clips) == false))
+        return (Game_Error_Failure(&game->error, GAME_ALLOCATION_ERROR));
+    state = GAME_STRESS_SEED;
+    for (size_t index = 0; index < count; index++) {
+        sprite.texture = &game->textures.content[index % 2 ? BOO : PLAYER];
+        sprite.coordinates.x = (float)(Game_Stress_Random(&state) % (WINDOW_WIDTH - sprite.texture->size.width));
+        sprite.coordinates.y = (float)(Game_Stress_Random(&state) % (WINDOW_HEIGHT - sprite.texture->size.height));
+        speed = (float)(1 + Game_Stress_Random(&state) % GAME_STRESS_MAX_SPEED);
+        if (index % 3 == 0)
+            sprite.velocity = (Coordinates){speed, 0};
+        else if (index % 3 == 1)
+            sprite.velocity = (Coordinates){0, speed};
+        else
+            sprite.velocity = (Coordinates){speed, -speed};
+        Game_Sprite_Array_PushAnimated(&game->sprites, sprite,
+            Game_Animation_State_Create(clips[index % 2], (Uint32)(index * 17000) % (8 * GAME_STRESS_FRAME_US)));
+    }
+    return (true);
+}
+
+int     Game_Stress_Run(Game *game, Game_Config *config) {
+    Game_Frame_Stats    stats;
+    int     status;
+
+    if (Game_Frame_Stats_Init(&stats, config->frame_limit) == false)
+        Game_Error_Append(&game->error, GAME_ALLOCATION_ERROR);
+    if (game->error.length != 0 || Game_Stress_LoadTextures(game) == false
+        || Game_Stress_Spawn(game, config->stress_sprites, config->animated) == false) {
+        Game_Frame_Stats_Destroy(&stats);
+        status = Game_Error_Log(&game->error);
+        Game_Quit(game);
+        return (status);
+    }
+    game->player.coordinates.x = (WINDOW_WIDTH - (float)game->player.texture.size.width) / 2;
+    game->player.coordinates.y = (WINDOW_HEIGHT - (float)game->player.texture.size.height) / 2;
+    game->player_previous = game->player.coordinates;
+    if (config->restore_path != NULL)
+        Game_RestoreFile(game, config->restore_path);
+    Game_Startup_Mark(&game->startup, GAME_STARTUP_READY);
+    if (game->adaptive.enabled == false)
+        Game_Timer_SetFPS(&game->timer, 0);
+    game->particle_fountain = config->stress_particles;
+    game->stats = &stats;
+    Game_Loop(game);
+    game->stats = NULL;
+    printf("stress scene  %zu %ssprites, %zu particles, %dx%d%s%s%s, render scale %.3f, zoom %.2f\n", config->stress_sprites,
+        config->animated ? "animated " : "", config->stress_particles, WINDOW_WIDTH, WINDOW_HEIGHT,
+        config->offscreen ? " offscreen" : "", config->pipelined ? " pipelined" : "", config->chase ? " chasing" : "",
+        game->window.render_scale, game->camera.zoom);
+    Game_Frame_Stats_Print(&stats, stdout);
+    if (config->mipmaps)
+        printf("mips          %.1f KiB on top of %.1f KiB of textures (+%.1f%%)\n",
+            (double)Game_Memory_GetPeak(GAME_MEMORY_MIPS) / 1024.0, (double)Game_Memory_GetPeak(GAME_MEMORY_TEXTURES) / 1024.0,
+            100.0 * (double)Game_Memory_GetPeak(GAME_MEMORY_MIPS) / (double)SDL_max(Game_Memory_GetPeak(GAME_MEMORY_TEXTURES), 1));
+    Game_Startup_Print(&game->startup, stdout);
+    if (config->chase)
+        printf("chase         %zu pixel contacts with the player\n", game->contacts);
+    if (game->sprite_script.length != 0)
+        printf("script        %zu sprite runs cut short by the jump budget\n", game->sprite_script.aborted);
+    if (game->adaptive.enabled)
+        printf("adaptive      level %zu of %zu, %zu changes\n", game->adaptive.level,
+            Game_Adaptive_GetLevelCount() - 1, game->adaptive.changes);
+    Game_Frame_Stats_Destroy(&stats);
+    Game_Quit(game);
+    return (0);
+}
@@ -0,0 +1,14 @@
+#ifndef GAME_STRESS_H
+# define GAME_STRESS_H
+
+# include "game.h"
+
+# define GAME_STRESS_SEED 0x2545F491u
+# define GAME_STRESS_MAX_SPEED 8
+# define GAME_STRESS_FRAME_US 120000
+
+bool    Game_Stress_LoadTextures(Game *game);
+bool    Game_Stress_Spawn(Game *game, size_t count, bool animated);
+int     Game_Stress_Run(Game *game, Game_Config *config);
+
+#endif
@@ -0,0 +1,199 @@
+#include "game_timer_wheel.h"
+#include "game_memory.h"
+
+#define GAME_TIMER_WHEEL_NONE 0xFFFFFFFFu
+#define GAME_TIMER_WHEEL_MASK (GAME_TIMER_WHEEL_SLOTS - 1)
+/* The list of the batch being fired, after the level slots. */
+#define GAME_TIMER_WHEEL_FIRING (GAME_TIMER_WHEEL_LEVELS * GAME_TIMER_WHEEL_SLOTS)
+/* The slot of a node in the free list. */
+#define GAME_TIMER_WHEEL_FREE 0xFFFFFFFFu
+
+bool    Game_Timer_Wheel_Init(Game_Timer_Wheel *this, size_t capacity) {
+    SDL_zerop(this);
+    for (size_t slot = 0; slot < SDL_arraysize(this->heads); slot++)
+        this->heads[slot] = GAME_TIMER_WHEEL_NONE;
+    this->free = GAME_TIMER_WHEEL_NONE;
+    if (capacity == 0 || capacity >= GAME_TIMER_WHEEL_NONE || capacity > SDL_SIZE_MAX / sizeof(Game_Timer_Node))
+        return (false);
+    if ((this->nodes = SDL_aligned_alloc(GAME_TIMER_WHEEL_ALIGNMENT, sizeof(Game_Timer_Node) * capacity)) == NULL)
+        return (false);
+    this->capacity = capacity;
+    this->bytes = sizeof(Game_Timer_Node) * capacity;
+    Game_Memory_Add(GAME_MEMORY_TIMERS, (Sint64)this->bytes);
+    for (size_t index = 0; index < capacity; index++)
+        this->nodes[index] = (Game_Timer_Node){0, NULL, NULL, 0,
+            index + 1 < capacity ? (Uint32)(index + 1) : GAME_TIMER_WHEEL_NONE, GAME_TIMER_WHEEL_NONE, 1, GAME_TIMER_WHEEL_FREE};
+    this->free = 0;
+    return (true);
+}
+
+static void Game_Timer_Wheel_Link(Game_Timer_Wheel *this, Uint32 index, Uint32 slot) {
+    Game_Timer_Node *node;
+
+    node = &this->nodes[index];
+    node->slot = slot;
+    node->prev = GAME_TIMER_WHEEL_NONE;
+    node->next = this->heads[slot];
+    if (node->next != GAME_TIMER_WHEEL_NONE)
+        this->nodes[node->next].prev = index;
+    this->heads[slot] = index;
+}
+
+/*
+** Only a list's head has to know which list it is in; a new head inherits
+** the slot, which lets a whole slot move to the firing list by its head.
+*/
+static void Game_Timer_Wheel_Unlink(Game_Timer_Wheel *this, Uint32 index) {
+    Game_Timer_Node *node;
+
+    node = &this->nodes[index];
+    if (node->prev != GAME_TIMER_WHEEL_NONE)
+        this->nodes[node->prev].next = node->next;
+    else {
+        this->heads[node->slot] = node->next;
+        if (node->next != GAME_TIMER_WHEEL_NONE)
+            this->nodes[node->next].slot = node->slot;
+    }
+    if (node->next != GAME_TIMER_WHEEL_NONE)
+        this->nodes[node->next].prev = node->prev;
+}
+
+static void Game_Timer_Wheel_Release(Game_Timer_Wheel *this, Uint32 index) {
+    Game_Timer_Node *node;
+
+    node = &this->nodes[index];
+    node->slot = GAME_TIMER_WHEEL_FREE;
+    node->callback = NULL;
+    if (++node->generation == 0)
+        node->generation = 1;
+    node->next = this->free;
+    this->free = index;
+    this->pending--;
+}
+
+/*
+** The slot of the coarsest level whose range still holds the delay. A slot
+** at level L is emptied downwards at the first tick of its 256^L block,
+** which comes after now and no later than the expiry, so nothing is ever
+** placed in a slot that has already gone by.
+*/
+static Uint32   Game_Timer_Wheel_GetSlot(const Game_Timer_Wheel *this, Uint64 expires) {
+    Uint64  delta;
+    Uint32  level;
+
+    delta = expires - this->now;
+    if (delta > GAME_TIMER_WHEEL_HORIZON)
+        expires = this->now + GAME_TIMER_WHEEL_HORIZON;
+    for (level = 0; level < GAME_TIMER_WHEEL_LEVELS - 1; level++)
+        if (delta < (Uint64)1 << (GAME_TIMER_WHEEL_BITS * (level + 1)))
+            break ;
+    return (level * GAME_TIMER_WHEEL_SLOTS + (Uint32)((expires >> (GAME_TIMER_WHEEL_BITS * level)) & GAME_TIMER_WHEEL_MASK));
+}
+
+/*
+** `callback(context, data)` runs `delay` ticks from now, at least one. Returns
+** GAME_TIMER_NONE, and counts the timer as rejected, when the pool is empty.
+*/
+Game_Timer_Handle   Game_Timer_Wheel_Schedule(Game_Timer_Wheel *this, Uint64 delay, Game_Timer_Callback callback, void *context, Uint64 data) {
+    Game_Timer_Node *node;
+    Uint32  index;
+
+    if (callback == NULL || this->free == GAME_TIMER_WHEEL_NONE) {
+        this->rejected++;
+        return (GAME_TIMER_NONE);
+    }
+    index = this->free;
+    node = &this->nodes[index];
+    this->free = node->next;
+    node->expires = this->now + SDL_max(delay, 1);
+    node->callback = callback;
+    node->context = context;
+    node->data = data;
+    Game_Timer_Wheel_Link(this, index, Game_Timer_Wheel_GetSlot(this, node->expires));
+    this->pending++;
+    return ((Game_Timer_Handle)node->generation << 32 | index);
+}
+
+bool    Game_Timer_Wheel_IsPending(const Game_Timer_Wheel *this, Game_Timer_Handle handle) {
+    Uint32  index;
+
+    index = (Uint32)handle;
+    return (handle != GAME_TIMER_NONE && index < this->capacity && this->nodes[index].generation == (Uint32)(handle >> 32)
+        && this->nodes[index].slot != GAME_TIMER_WHEEL_FREE);
+}
+
+/* Returns false for a timer that already fired or was cancelled. */
+bool    Game_Timer_Wheel_Cancel(Game_Timer_Wheel *this, Game_Timer_Handle handle) {
+    if (Game_Timer_Wheel_IsPending(this, handle) == false)
+        return (false);
+    Game_Timer_Wheel_Unlink(this, (Uint32)handle);
+    Game_Timer_Wheel_Release(this, (Uint32)handle);
+    return (true);
+}
+
+/* Empties this tick's slot of `level` into the levels below. */
+static void Game_Timer_Wheel_Cascade(Game_Timer_Wheel *this, Uint32 level) {
+    Uint32  slot;
+    Uint32  index;
+    Uint32  next;
+
+    slot = level * GAME_TIMER_WHEEL_SLOTS + (Uint32)((this->now >> (GAME_TIMER_WHEEL_BITS * level)) & GAME_TIMER_WHEEL_MASK);
+    index = this->heads[slot];
+    this->heads[slot] = GAME_TIMER_WHEEL_NONE;
+    while (index != GAME_TIMER_WHEEL_NONE) {
+        next = this->nodes[index].next;
+        Game_Timer_Wheel_Link(this, index, Game_Timer_Wheel_GetSlot(this, this->nodes[index].expires));
+        this->cascaded++;
+        index = next;
+    }
+}
+
+/*
+** Runs `ticks` ticks. On each, the higher levels that came round are
+** emptied downwards, then the due level-0 slot is detached whole and fired.
+** A fired node is back in the pool before its callback runs, so a
+** callback can reschedule itself. Callbacks must not call Advance. Returns
+** the number of timers fired.
+*/
+size_t  Game_Timer_Wheel_Advance(Game_Timer_Wheel *this, Uint64 ticks) {
+    Game_Timer_Node *node;
+    Game_Timer_Callback callback;
+    void    *context;
+    Uint64  data;
+    Uint32  index;
+    Uint32  levels;
+    size_t  fired;
+
+    fired = 0;
+    while (ticks-- != 0) {
+        this->now++;
+        for (levels = 1; levels < GAME_TIMER_WHEEL_LEVELS; levels++)
+            if ((this->now & (((Uint64)1 << (GAME_TIMER_WHEEL_BITS * levels)) - 1)) != 0)
+                break ;
+        while (--levels != 0)
+            Game_Timer_Wheel_Cascade(this, levels);
+        if ((index = this->heads[this->now & GAME_TIMER_WHEEL_MASK]) == GAME_TIMER_WHEEL_NONE)
+            continue ;
+        this->heads[this->now & GAME_TIMER_WHEEL_MASK] = GAME_TIMER_WHEEL_NONE;
+        this->heads[GAME_TIMER_WHEEL_FIRING] = index;
+        this->nodes[index].slot = GAME_TIMER_WHEEL_FIRING;
+        while ((index = this->heads[GAME_TIMER_WHEEL_FIRING]) != GAME_TIMER_WHEEL_NONE) {
+            node = &this->nodes[index];
+            callback = node->callback;
+            context = node->context;
+            data = node->data;
+            Game_Timer_Wheel_Unlink(this, index);
+            Game_Timer_Wheel_Release(this, index);
+            callback(context, data);
+            fired++;
+        }
+    }
+    this->fired += fired;
+    return (fired);
+}
+
+void    Game_Timer_Wheel_Destroy(Game_Timer_Wheel *this) {
+    Game_Memory_Add(GAME_MEMORY_TIMERS, -(Sint64)this->bytes);
+    SDL_aligned_free(this->nodes);
+    Game_Timer_Wheel_Init(this, 0);
+}
@@ -0,0 +1,61 @@
+#ifndef GAME_TIMER_WHEEL_H
+# define GAME_TIMER_WHEEL_H
+
+# include "libstd.h"
+# include "SDL_lib.h"
+
+# define GAME_TIMER_WHEEL_BITS 8
+# define GAME_TIMER_WHEEL_SLOTS (1 << GAME_TIMER_WHEEL_BITS)
+# define GAME_TIMER_WHEEL_LEVELS 4
+/* Longer delays are parked at the top level and placed again each time it comes round. */
+# define GAME_TIMER_WHEEL_HORIZON (((Uint64)1 << (GAME_TIMER_WHEEL_BITS * GAME_TIMER_WHEEL_LEVELS)) - 1)
+# define GAME_TIMER_WHEEL_ALIGNMENT 64
+# define GAME_TIMER_NONE 0
+
+/* Never 0; stale once the timer fired or was cancelled, so a late Cancel is harmless. */
+typedef Uint64  Game_Timer_Handle;
+typedef void    (*Game_Timer_Callback)(void *context, Uint64 data);
+
+typedef struct Game_Timer_Node {
+    Uint64  expires;
+    Game_Timer_Callback callback;
+    void    *context;
+    Uint64  data;
+    Uint32  next;
+    Uint32  prev;
+    Uint32  generation;
+    Uint32  slot;
+}   Game_Timer_Node;
+
+/*
+** Hierarchical timing wheel on simulation ticks: GAME_TIMER_WHEEL_LEVELS
+** wheels of GAME_TIMER_WHEEL_SLOTS slots, each level 256 times coarser than
+** the one below. A timer goes into the slot of the coarsest level it is
+** still within range of; whenever a lower level comes full circle, the
+** matching slot one level up is emptied into the levels below it. Schedule
+** and Cancel are O(1): nodes come from a fixed pool and sit in intrusive
+** doubly linked lists by index. Each tick detaches the one slot that is due
+** and fires it as a batch; callbacks may schedule and cancel freely,
+** including the timers of that same batch.
+*/
+typedef struct Game_Timer_Wheel {
+    Game_Timer_Node *nodes;
+    size_t  capacity;
+    size_t  bytes;
+    Uint32  free;
+    Uint32  heads[GAME_TIMER_WHEEL_LEVELS * GAME_TIMER_WHEEL_SLOTS + 1];
+    Uint64  now;
+    size_t  pending;
+    size_t  fired;
+    size_t  cascaded;
+    size_t  rejected;
+}   Game_Timer_Wheel;
+
+bool    Game_Timer_Wheel_Init(Game_Timer_Wheel *this, size_t capacity);
+Game_Timer_Handle   Game_Timer_Wheel_Schedule(Game_Timer_Wheel *this, Uint64 delay, Game_Timer_Callback callback, void *context, Uint64 data);
+bool    Game_Timer_Wheel_Cancel(Game_Timer_Wheel *this, Game_Timer_Handle handle);
+bool    Game_Timer_Wheel_IsPending(const Game_Timer_Wheel *this, Game_Timer_Handle handle);
+size_t  Game_Timer_Wheel_Advance(Game_Timer_Wheel *this, Uint64 ticks);
+void    Game_Timer_Wheel_Destroy(Game_Timer_Wheel *this);
+
+#endif
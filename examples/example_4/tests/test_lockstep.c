@@ -0,0 +1,84 @@
+#include "game_lockstep.h"
+
+#define TEST_LOCKSTEP_TICKS 600
+#define TEST_LOCKSTEP_SEED 0x1F2E3D4Cu
+/* A session that has not confirmed every tick by then is stuck. */
+#define TEST_LOCKSTEP_MAX_STEPS (TEST_LOCKSTEP_TICKS * 8)
+
+/* Held inputs that change every few ticks, so some predictions miss. */
+static Uint32   Test_Lockstep_Input(size_t player, Uint32 tick) {
+    Uint32  hash;
+
+    hash = (tick / 7 + (Uint32)player * 0x9E3779B9u) * 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    return ((hash >> 7) & (GAME_INPUT_UP | GAME_INPUT_DOWN | GAME_INPUT_LEFT | GAME_INPUT_RIGHT));
+}
+
+/* The hash both peers must reach: the same ticks stepped once, in order, with every input known. */
+static Uint64   Test_Lockstep_Reference(void) {
+    Game_Lockstep_State state;
+    Uint32  inputs[GAME_LOCKSTEP_PLAYERS];
+
+    Game_Lockstep_State_Init(&state, TEST_LOCKSTEP_SEED);
+    while (state.tick < TEST_LOCKSTEP_TICKS) {
+        for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++)
+            inputs[player] = Test_Lockstep_Input(player, state.tick);
+        Game_Lockstep_Step(&state, inputs);
+    }
+    return (Game_Lockstep_State_Hash(&state));
+}
+
+/*
+** Two in-process peers over loopback links with `latency` ticks of delay
+** and up to `jitter` more, one frame per clock step, until every tick is
+** confirmed on both sides. One more tick applies any pending rollback and
+** saves the final state. The session passes if neither peer saw a desync
+** and both final hashes equal the reference.
+*/
+static bool Test_Lockstep_Session(Uint32 latency, Uint32 jitter, Uint32 seed, Uint64 reference) {
+    static Game_Lockstep_Peer   peers[GAME_LOCKSTEP_PLAYERS];
+    static Game_Loopback    links[GAME_LOCKSTEP_PLAYERS];
+    Game_Lockstep_Message   message;
+    Uint64  hashes[GAME_LOCKSTEP_PLAYERS];
+    Uint32  now;
+    bool    passed;
+
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+        Game_Lockstep_Peer_Init(&peers[player], player, TEST_LOCKSTEP_SEED);
+        Game_Loopback_Init(&links[player], latency, jitter, seed + (Uint32)player);
+    }
+    for (now = 0; now < TEST_LOCKSTEP_MAX_STEPS && (Game_Lockstep_Peer_GetConfirmedTick(&peers[0]) < TEST_LOCKSTEP_TICKS
+        || Game_Lockstep_Peer_GetConfirmedTick(&peers[1]) < TEST_LOCKSTEP_TICKS); now++)
+        for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+            while (Game_Loopback_Receive(&links[player], now, &message))
+                Game_Lockstep_Peer_Receive(&peers[player], 1 - player, &message);
+            if (peers[player].state.tick < TEST_LOCKSTEP_TICKS
+                && Game_Lockstep_Peer_Advance(&peers[player], Test_Lockstep_Input(player, peers[player].state.tick), &message))
+                Game_Loopback_Send(&links[1 - player], &message, now);
+        }
+    passed = now < TEST_LOCKSTEP_MAX_STEPS;
+    for (size_t player = 0; player < GAME_LOCKSTEP_PLAYERS; player++) {
+        Game_Lockstep_Peer_Advance(&peers[player], 0, &message);
+        passed = passed && peers[player].desyncs == 0
+            && Game_Lockstep_Peer_GetHash(&peers[player], TEST_LOCKSTEP_TICKS, &hashes[player]);
+    }
+    passed = passed && hashes[0] == hashes[1] && hashes[0] == reference;
+    fprintf(stderr, "lockstep: latency %u + %u, seed %08x: %s (%zu and %zu rollbacks, %u steps)\n", latency, jitter, seed,
+        passed ? "ok" : "FAILED", peers[0].rollbacks, peers[1].rollbacks, now);
+    return (passed);
+}
+
+int     main(void) {
+    static const Uint32 links[][2] = {{0, 0}, {1, 0}, {2, 1}, {6, 3}, {12, 6}};
+    Uint64  reference;
+    size_t  failures;
+
+    reference = Test_Lockstep_Reference();
+    failures = 0;
+    for (size_t link = 0; link < SDL_arraysize(links); link++)
+        for (Uint32 seed = 1; seed <= 4; seed++)
+            failures += Test_Lockstep_Session(links[link][0], links[link][1], seed * 0x9E3779B9u, reference) == false;
+    if (failures != 0)
+        fprintf(stderr, "lockstep: %zu sessions failed\n", failures);
+    return (failures != 0);
+}
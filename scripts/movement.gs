@@ -0,0 +1,29 @@
+# The built-in player commands (GAME_COMMAND_LIST) as a behaviour script:
+# one step of `speed` along the isometric axes for each arrow held, in the
+# same order, so the result matches the native moves to the bit.
+#
+#   game --player-script scripts/movement.gs
+
+        ld      r0, x
+        ld      r1, y
+        ld      r2, speed
+        ldk     r4, 0.5
+        mul     r3, r2, r4          # half a step on y
+        jnin    up, try_down
+        sub     r0, r0, r2
+        sub     r1, r1, r3
+try_down:
+        jnin    down, try_left
+        add     r0, r0, r2
+        add     r1, r1, r3
+try_left:
+        jnin    left, try_right
+        sub     r0, r0, r2
+        add     r1, r1, r3
+try_right:
+        jnin    right, store
+        add     r0, r0, r2
+        sub     r1, r1, r3
+store:
+        st      x, r0
+        st      y, r1
@@ -0,0 +1,26 @@
+# Turns every sprite's velocity a little each step, keeping its speed: the
+# stress scene's straight bounces become loops.
+#
+#   game --stress 10000 --sprite-script scripts/swirl.gs
+
+        ld      r0, vx
+        ld      r1, vy
+        mul     r2, r0, r0
+        madd    r2, r1, r1
+        sqrt    r2, r2              # speed before the turn
+        ldk     r3, 0
+        jge     r3, r2, done        # standing still: nothing to turn
+        ldk     r3, 0.05            # about 3 degrees a step
+        mul     r4, r1, r3
+        sub     r4, r0, r4          # vx - vy * k
+        mul     r5, r0, r3
+        add     r5, r1, r5          # vy + vx * k
+        mul     r6, r4, r4
+        madd    r6, r5, r5
+        sqrt    r6, r6
+        div     r6, r2, r6          # back to the old speed
+        mul     r4, r4, r6
+        mul     r5, r5, r6
+        st      vx, r4
+        st      vy, r5
+done: